@@ -0,0 +1,634 @@
+/**
+ * @file EcsBench.cpp
+ * @brief Headless benchmarks of the entity manager and the simulation systems.
+ * @details Usage: ecs_bench [--filter text] [--reps n] [--threads n] [--memory]
+ *                           [--baseline file] [--save-baseline file] [--tolerance percent]
+ *
+ * Builds synthetic worlds (N solid tiles, M dynamic bodies, K spawners) and times the
+ * simulation systems one step at a time, in the engine's order. Nothing opens a window,
+ * so it runs on build machines without a display. Each benchmark is repeated --reps times
+ * and the median is reported.
+ *
+ * A baseline is a text file of "name nanoseconds" lines. --save-baseline writes one;
+ * --baseline compares against one and exits with 1 if any benchmark got slower by more
+ * than --tolerance percent (default 10). Baselines are only comparable on the same machine
+ * and build type.
+ *
+ * --memory also prints the memory held by each component storage of the largest world.
+ *
+ * The layout/ rows run the same movement pass and the same component toggling through
+ * EntityManager and through ArchetypeEntityManager, whose chunks keep each entity's
+ * components side by side, to show what co-located columns buy and what migration costs.
+ */
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "components/AccelerationComponent.h"
+#include "components/CollisionComponent.h"
+#include "components/InputComponent.h"
+#include "components/LocationComponent.h"
+#include "components/MovementComponent.h"
+#include "components/SpawnComponent.h"
+#include "components/TagComponents.h"
+#include "components/TimeComponent.h"
+#include "core/Prefab.h"
+#include "core/ThreadPool.h"
+#include "core/TileCollisionGrid.h"
+#include "core/TimerWheel.h"
+#include "managers/ArchetypeEntityManager.h"
+#include "managers/CollisionManager.h"
+#include "managers/EntityCommandBuffer.h"
+#include "managers/EntityManager.h"
+#include "systems/CollisionSystem.h"
+#include "systems/CollisionSystemUpdate.h"
+#include "systems/GravitySystem.h"
+#include "systems/MovementSystem.h"
+#include "systems/SleepSystem.h"
+#include "systems/SpawnSystem.h"
+#include "systems/TimeSystem.h"
+
+namespace {
+
+using namespace ECSEngine;
+
+// Everything the simulation systems touch; nothing that needs a window
+#define BENCH_COMPONENTS                                                                     \
+    LocationComponent, MovementComponent, AccelerationComponent, CollisionComponent,         \
+        SpawnComponent, InputComponent, TimeComponent, StarTag, Sleeping
+
+using BenchEntityManager = EntityManager<BENCH_COMPONENTS>;
+using BenchArchetypeManager = ArchetypeEntityManager<BENCH_COMPONENTS>;
+using BenchPrefab = Prefab<BENCH_COMPONENTS>;
+
+constexpr float TILE_SIZE = 64.0f;
+constexpr float STEP = 1.0f / 60.0f;
+constexpr int WARMUP_STEPS = 30; // Let bodies land before timing
+constexpr int TIMED_STEPS = 120;
+
+using Clock = std::chrono::steady_clock;
+
+double ElapsedNs(Clock::time_point start)
+{
+    return std::chrono::duration<double, std::nano>(Clock::now() - start).count();
+}
+
+/**
+ * @struct WorldSpec
+ * @brief Size of a synthetic world.
+ */
+struct WorldSpec {
+    int tiles; // Solid cells: a floor, then random platforms
+    int bodies; // Dynamic boxes dropped from random heights
+    int spawners; // Spawn pickups every few steps, like the star spawners
+};
+
+struct World {
+    BenchEntityManager entities;
+    CollisionManager collision;
+    PrefabRegistry<BENCH_COMPONENTS> prefabs;
+    EntityCommandQueue<BENCH_COMPONENTS> commands;
+    std::mt19937 random; // Spawn velocities; seeded with the world so runs repeat
+    TimerWheel timers;
+    TimerWheel spawnTimers;
+};
+
+std::unique_ptr<World> BuildWorld(const WorldSpec& spec, uint32_t seed)
+{
+    auto world = std::make_unique<World>();
+    world->random.seed(seed);
+    std::mt19937 rng(seed);
+
+    // Square-ish level, wide enough that the floor alone holds a quarter of the tiles
+    const int width = std::max(32, static_cast<int>(std::sqrt(spec.tiles * 4.0)));
+    const int height = std::max(16, width / 2);
+    TileCollisionGrid grid(Point2D(0.0f, 0.0f), TILE_SIZE, TILE_SIZE, width, height);
+    const uint8_t solid = grid.AddShape(Rect(0.0f, 0.0f, TILE_SIZE, TILE_SIZE));
+
+    int placed = 0;
+    for (int col = 0; col < width && placed < spec.tiles; ++col, ++placed) {
+        grid.SetCell(col, height - 1, solid);
+    }
+
+    std::uniform_int_distribution<int> platformCol(0, width - 8);
+    std::uniform_int_distribution<int> platformRow(2, height - 3);
+    while (placed < spec.tiles) {
+        const int col = platformCol(rng);
+        const int row = platformRow(rng);
+        for (int i = 0; i < 6 && placed < spec.tiles; ++i, ++placed) {
+            grid.SetCell(col + i, row, solid);
+        }
+    }
+
+    world->collision.SetCellSize(TILE_SIZE);
+    world->collision.AddTileLayer(std::move(grid));
+
+    // Bodies are 32x32 boxes above the floor, location at their bottom-left
+    const float levelWidth = width * TILE_SIZE;
+    const float floorY = (height - 1) * TILE_SIZE;
+    std::uniform_real_distribution<float> x(TILE_SIZE, levelWidth - 2 * TILE_SIZE);
+    std::uniform_real_distribution<float> y(TILE_SIZE, floorY - TILE_SIZE);
+    std::uniform_real_distribution<float> speed(-120.0f, 120.0f);
+
+    BenchEntityManager& entities = world->entities;
+    entities.ReserveEntities(spec.bodies + spec.spawners);
+    entities.ReserveComponents<LocationComponent, MovementComponent, CollisionComponent>(
+        spec.bodies);
+
+    const Rect box(0.0f, -32.0f, 32.0f, 32.0f);
+    const NameID bodyName = entities.InternName("body");
+    for (int i = 0; i < spec.bodies; ++i) {
+        const EntityID body = entities.CreateEntity(bodyName);
+        entities.AddComponent(body, LocationComponent(x(rng), y(rng)));
+        entities.AddComponent(body, MovementComponent(speed(rng), 0.0f));
+        entities.AddComponent(body, CollisionComponent(box, false));
+    }
+
+    // Pickups that sleep once they settle, as in the game
+    CollisionComponent pickupCollider(box, false);
+    pickupCollider.layer = COLLISION_LAYER_PICKUP;
+    pickupCollider.continuous = true;
+    pickupCollider.canSleep = true;
+    const PrefabID pickup = world->prefabs.Register(
+        BenchPrefab(entities.InternName("pickup")).Set(pickupCollider).Set(StarTag {}));
+
+    const NameID spawnerName = entities.InternName("spawner");
+    for (int i = 0; i < spec.spawners; ++i) {
+        const EntityID spawner = entities.CreateEntity(spawnerName);
+        entities.AddComponent(spawner, LocationComponent(x(rng), TILE_SIZE));
+        SpawnComponent spawn(spawner, pickup, 0.25f);
+        spawn.maxSpawns = 40;
+        entities.AddComponent(spawner, spawn);
+    }
+
+    return world;
+}
+
+/**
+ * @struct StepTimer
+ * @brief One simulation step in the engine's system order, timing every system.
+ */
+struct StepTimer {
+    std::vector<std::pair<const char*, double>> totals; // Nanoseconds over all timed steps
+
+    template <typename Fn> void Time(size_t slot, const char* name, Fn&& fn)
+    {
+        const Clock::time_point start = Clock::now();
+        fn();
+        const double ns = ElapsedNs(start);
+        if (totals.size() <= slot) {
+            totals.resize(slot + 1, { name, 0.0 });
+        }
+        totals[slot].second += ns;
+    }
+
+    void Step(World& world, ThreadPool* pool)
+    {
+        BenchEntityManager& em = world.entities;
+        CollisionManager& cm = world.collision;
+        EntityCommandBuffer<BENCH_COMPONENTS>& commands = world.commands.Local();
+
+        Time(0, "CollisionSystemUpdate", [&] { CollisionSystemUpdate(em, cm, pool); });
+        Time(1, "GravitySystem", [&] { GravitySystem(em, STEP, pool); });
+        Time(2, "MovementSystem", [&] { MovementSystem(em, STEP, pool); });
+        Time(3, "CollisionSystem", [&] { CollisionSystem(em, cm); });
+        Time(4, "SleepSystem", [&] { SleepSystem(em, cm, commands); });
+        Time(5, "TimeSystem", [&] { TimeSystem(em, world.timers, STEP); });
+        Time(6, "SpawnSystem", [&] {
+            SpawnSystem(em, world.prefabs, commands, world.random, world.spawnTimers, STEP);
+        });
+        Time(7, "PlaybackCommands", [&] { world.commands.Playback(em); });
+    }
+};
+
+/**
+ * @struct Result
+ * @brief Median time of one benchmark, per operation.
+ */
+struct Result {
+    std::string name;
+    double nsPerOp;
+    double opsPerRep; // Items handled per operation, for the throughput column
+};
+
+struct Options {
+    std::string filter;
+    int reps = 5;
+    size_t threads = 0; // 0 = systems run serially
+    std::string baselinePath;
+    std::string saveBaselinePath;
+    double tolerancePercent = 10.0;
+    bool memory = false;
+};
+
+double Median(std::vector<double> samples)
+{
+    std::sort(samples.begin(), samples.end());
+    return samples[samples.size() / 2];
+}
+
+class Runner {
+public:
+    explicit Runner(const Options& options)
+        : mOptions(options)
+    {
+    }
+
+    bool Wanted(const std::string& name) const
+    {
+        return mOptions.filter.empty() || name.find(mOptions.filter) != std::string::npos;
+    }
+
+    // Runs rep() --reps times; each call returns the nanoseconds per operation it measured
+    void Add(const std::string& name, double items, const std::function<double()>& rep)
+    {
+        if (!Wanted(name)) {
+            return;
+        }
+
+        std::vector<double> samples;
+        for (int i = 0; i < mOptions.reps; ++i) {
+            samples.push_back(rep());
+        }
+        mResults.push_back(Result { name, Median(samples), items });
+        std::cerr << "." << std::flush;
+    }
+
+    // Several results from the same reps: rep() returns one ns/op per name
+    void AddGroup(const std::vector<std::string>& names, double items,
+        const std::function<std::vector<double>()>& rep)
+    {
+        if (std::none_of(names.begin(), names.end(), [&](const auto& n) { return Wanted(n); })) {
+            return;
+        }
+
+        std::vector<std::vector<double>> samples(names.size());
+        for (int i = 0; i < mOptions.reps; ++i) {
+            const std::vector<double> values = rep();
+            for (size_t j = 0; j < names.size(); ++j) {
+                samples[j].push_back(values[j]);
+            }
+        }
+
+        for (size_t j = 0; j < names.size(); ++j) {
+            if (Wanted(names[j])) {
+                mResults.push_back(Result { names[j], Median(samples[j]), items });
+            }
+        }
+        std::cerr << "." << std::flush;
+    }
+
+    const std::vector<Result>& GetResults() const { return mResults; }
+
+private:
+    const Options& mOptions;
+    std::vector<Result> mResults;
+};
+
+void EntityBenchmarks(Runner& runner)
+{
+    for (int count : { 1000, 10000, 100000 }) {
+        const std::string suffix = "/" + std::to_string(count);
+
+        runner.Add("entities/create" + suffix, 1.0, [count] {
+            BenchEntityManager entities;
+            const NameID name = entities.InternName("body");
+            const Clock::time_point start = Clock::now();
+            for (int i = 0; i < count; ++i) {
+                const EntityID entity = entities.CreateEntity(name);
+                entities.AddComponent(entity, LocationComponent(float(i), 0.0f));
+                entities.AddComponent(entity, MovementComponent());
+                entities.AddComponent(entity, CollisionComponent(Rect(0, -32, 32, 32), false));
+            }
+            return ElapsedNs(start) / count;
+        });
+
+        runner.Add("entities/instantiate" + suffix, 1.0, [count] {
+            BenchEntityManager entities;
+            const BenchPrefab prefab = BenchPrefab(entities.InternName("body"))
+                                           .Set(LocationComponent())
+                                           .Set(MovementComponent())
+                                           .Set(CollisionComponent(Rect(0, -32, 32, 32), false));
+            const Clock::time_point start = Clock::now();
+            const std::vector<EntityID> created = entities.Instantiate(prefab, count);
+            return ElapsedNs(start) / static_cast<double>(created.size());
+        });
+
+        // Removal in random order, so swap-removes hit all over the storage
+        runner.Add("entities/remove" + suffix, 1.0, [count] {
+            BenchEntityManager entities;
+            const NameID name = entities.InternName("body");
+            std::vector<EntityID> ids;
+            for (int i = 0; i < count; ++i) {
+                ids.push_back(entities.CreateEntity(name));
+                entities.AddComponent(ids.back(), LocationComponent(float(i), 0.0f));
+                entities.AddComponent(ids.back(), MovementComponent());
+                entities.AddComponent(ids.back(), CollisionComponent(Rect(0, -32, 32, 32), false));
+            }
+            std::shuffle(ids.begin(), ids.end(), std::mt19937(7));
+
+            const Clock::time_point start = Clock::now();
+            for (EntityID id : ids) {
+                entities.RemoveEntity(id);
+            }
+            return ElapsedNs(start) / count;
+        });
+    }
+}
+
+// Movers spread over several archetypes and storages, then churned so neither manager keeps
+// them in creation order. Returns every fourth one, for the toggle benchmark
+template <typename Manager> std::vector<EntityID> BuildMovers(Manager& entities, int count)
+{
+    std::mt19937 rng(99);
+    std::uniform_real_distribution<float> speed(-120.0f, 120.0f);
+    const NameID name = entities.InternName("mover");
+
+    auto create = [&](int i) {
+        const EntityID entity = entities.CreateEntity(name);
+        entities.AddComponent(entity, LocationComponent(float(i), 0.0f));
+        entities.AddComponent(entity, MovementComponent(speed(rng), speed(rng)));
+        if (i % 2 == 0) {
+            entities.AddComponent(entity, CollisionComponent(Rect(0, -32, 32, 32), false));
+        }
+        if (i % 3 == 0) {
+            entities.AddComponent(entity, AccelerationComponent(0.0f, 980.0f));
+        }
+        return entity;
+    };
+
+    std::vector<EntityID> ids;
+    for (int i = 0; i < count; ++i) {
+        ids.push_back(create(i));
+    }
+    std::shuffle(ids.begin(), ids.end(), rng);
+    for (size_t i = 0; i < ids.size() / 4; ++i) {
+        entities.RemoveEntity(ids[i]);
+        ids[i] = create(static_cast<int>(i));
+    }
+
+    std::vector<EntityID> toggled;
+    for (size_t i = 0; i < ids.size(); i += 4) {
+        toggled.push_back(ids[i]);
+    }
+    return toggled;
+}
+
+void LayoutBenchmarks(Runner& runner)
+{
+    constexpr int PASSES = 20;
+
+    for (int count : { 10000, 100000 }) {
+        const std::string prefix = "layout/" + std::to_string(count) + "/";
+
+        // Per entity moved: one view joining two storages...
+        runner.Add(prefix + "move/EntityManager", 1.0, [count] {
+            BenchEntityManager entities;
+            BuildMovers(entities, count);
+            const Clock::time_point start = Clock::now();
+            for (int pass = 0; pass < PASSES; ++pass) {
+                for (auto [id, location, movement] :
+                    entities.View<LocationComponent, MovementComponent>()) {
+                    location.position.x += movement.velocity.x * STEP;
+                    location.position.y += movement.velocity.y * STEP;
+                }
+            }
+            return ElapsedNs(start) / (double(count) * PASSES);
+        });
+
+        // ...against packed columns walked chunk by chunk
+        runner.Add(prefix + "move/Archetype", 1.0, [count] {
+            BenchArchetypeManager entities;
+            BuildMovers(entities, count);
+            const Clock::time_point start = Clock::now();
+            for (int pass = 0; pass < PASSES; ++pass) {
+                entities.ForEachChunk<LocationComponent, MovementComponent>(
+                    [](size_t rows, const EntityID*, LocationComponent* locations,
+                        MovementComponent* movements) {
+                        for (size_t row = 0; row < rows; ++row) {
+                            locations[row].position.x += movements[row].velocity.x * STEP;
+                            locations[row].position.y += movements[row].velocity.y * STEP;
+                        }
+                    });
+            }
+            return ElapsedNs(start) / (double(count) * PASSES);
+        });
+
+        // Per toggle: a quarter of the movers fall asleep and wake up again. The archetype
+        // manager moves every component of the entity twice
+        auto toggle = [count](auto& entities) {
+            const std::vector<EntityID> toggled = BuildMovers(entities, count);
+            const Clock::time_point start = Clock::now();
+            for (EntityID entity : toggled) {
+                entities.AddComponent(entity, Sleeping {});
+            }
+            for (EntityID entity : toggled) {
+                entities.template RemoveComponent<Sleeping>(entity);
+            }
+            return ElapsedNs(start) / (2.0 * static_cast<double>(toggled.size()));
+        };
+        runner.Add(prefix + "toggle/EntityManager", 1.0, [toggle] {
+            BenchEntityManager entities;
+            return toggle(entities);
+        });
+        runner.Add(prefix + "toggle/Archetype", 1.0, [toggle] {
+            BenchArchetypeManager entities;
+            return toggle(entities);
+        });
+    }
+}
+
+void SystemBenchmarks(Runner& runner, ThreadPool* pool)
+{
+    static const char* const SYSTEMS[] = { "CollisionSystemUpdate", "GravitySystem",
+        "MovementSystem", "CollisionSystem", "SleepSystem", "TimeSystem", "SpawnSystem",
+        "PlaybackCommands" };
+
+    // Bodies scale up; the collision rows show how the broadphase copes
+    for (int bodies : { 1000, 4000, 16000 }) {
+        const WorldSpec spec { 4096, bodies, 16 };
+        const std::string prefix = "step/" + std::to_string(bodies) + "/";
+
+        std::vector<std::string> names;
+        for (const char* system : SYSTEMS) {
+            names.push_back(prefix + system);
+        }
+        names.push_back(prefix + "total");
+
+        // Items are bodies, so the throughput column reads as bodies per second
+        runner.AddGroup(names, bodies, [&spec, pool] {
+            std::unique_ptr<World> world = BuildWorld(spec, 1234);
+
+            StepTimer warmup;
+            for (int i = 0; i < WARMUP_STEPS; ++i) {
+                warmup.Step(*world, pool);
+            }
+
+            StepTimer timer;
+            for (int i = 0; i < TIMED_STEPS; ++i) {
+                timer.Step(*world, pool);
+            }
+
+            std::vector<double> perStep;
+            double total = 0.0;
+            for (const auto& [name, ns] : timer.totals) {
+                perStep.push_back(ns / TIMED_STEPS);
+                total += ns / TIMED_STEPS;
+            }
+            perStep.push_back(total);
+            return perStep;
+        });
+    }
+}
+
+std::unordered_map<std::string, double> LoadBaseline(const std::string& path)
+{
+    std::unordered_map<std::string, double> baseline;
+    std::ifstream file(path);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open baseline: " << path << std::endl;
+        return baseline;
+    }
+
+    std::string name;
+    double ns;
+    while (file >> name >> ns) {
+        baseline[name] = ns;
+    }
+    return baseline;
+}
+
+bool SaveBaseline(const std::string& path, const std::vector<Result>& results)
+{
+    std::ofstream file(path, std::ios::trunc);
+    for (const Result& result : results) {
+        file << result.name << " " << result.nsPerOp << "\n";
+    }
+    if (!file) {
+        std::cerr << "Error: Could not write baseline: " << path << std::endl;
+        return false;
+    }
+    return true;
+}
+
+// Prints the table; returns the number of regressions against the baseline
+int Report(const std::vector<Result>& results,
+    const std::unordered_map<std::string, double>& baseline, double tolerancePercent)
+{
+    int regressions = 0;
+    std::printf("\n%-36s %14s %14s %12s\n", "benchmark", "ns/op", "items/s", "vs baseline");
+
+    for (const Result& result : results) {
+        const double itemsPerSecond = result.opsPerRep * 1e9 / result.nsPerOp;
+        std::printf("%-36s %14.1f %13.2fM", result.name.c_str(), result.nsPerOp,
+            itemsPerSecond * 1e-6);
+
+        auto it = baseline.find(result.name);
+        if (it != baseline.end() && it->second > 0.0) {
+            const double change = (result.nsPerOp / it->second - 1.0) * 100.0;
+            const bool regressed = change > tolerancePercent;
+            regressions += regressed ? 1 : 0;
+            std::printf(" %+11.1f%%%s", change, regressed ? "  REGRESSED" : "");
+        }
+        std::printf("\n");
+    }
+
+    return regressions;
+}
+
+// Builds the largest step world, lets it settle and prints what each storage holds
+void ReportMemory(ThreadPool* pool)
+{
+    std::unique_ptr<World> world = BuildWorld(WorldSpec { 4096, 16000, 16 }, 1234);
+    StepTimer warmup;
+    for (int i = 0; i < WARMUP_STEPS; ++i) {
+        warmup.Step(*world, pool);
+    }
+
+    std::printf("\n%-36s %14s %14s\n", "memory (16000 bodies)", "components", "KB");
+    size_t total = 0;
+    for (const auto& usage : world->entities.GetMemoryUsage()) {
+        std::printf("%-36.*s %14zu %14.1f\n", static_cast<int>(usage.type.size()),
+            usage.type.data(), usage.count, usage.bytes / 1024.0);
+        total += usage.bytes;
+    }
+    const size_t entityBytes = world->entities.GetEntityMemoryUsage();
+    std::printf("%-36s %14s %14.1f\n", "entity tables", "", entityBytes / 1024.0);
+    std::printf("%-36s %14s %14.1f\n", "total", "", (total + entityBytes) / 1024.0);
+}
+
+} // namespace
+
+int main(int argc, char* argv[])
+{
+    Options options;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--filter" && hasValue) {
+            options.filter = argv[++i];
+        } else if (arg == "--reps" && hasValue) {
+            options.reps = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--threads" && hasValue) {
+            options.threads = static_cast<size_t>(std::max(0, std::atoi(argv[++i])));
+        } else if (arg == "--baseline" && hasValue) {
+            options.baselinePath = argv[++i];
+        } else if (arg == "--save-baseline" && hasValue) {
+            options.saveBaselinePath = argv[++i];
+        } else if (arg == "--tolerance" && hasValue) {
+            options.tolerancePercent = std::atof(argv[++i]);
+        } else if (arg == "--memory") {
+            options.memory = true;
+        } else {
+            std::cout << "Usage: " << argv[0]
+                      << " [--filter text] [--reps n] [--threads n] [--memory]"
+                         " [--baseline file] [--save-baseline file] [--tolerance percent]\n";
+            return 1;
+        }
+    }
+
+    // A pool only when asked for: serial numbers are steadier between runs
+    std::unique_ptr<ThreadPool> pool;
+    if (options.threads > 0) {
+        pool = std::make_unique<ThreadPool>(options.threads);
+    }
+
+    Runner runner(options);
+    EntityBenchmarks(runner);
+    LayoutBenchmarks(runner);
+    SystemBenchmarks(runner, pool.get());
+
+    const std::vector<Result>& results = runner.GetResults();
+    std::unordered_map<std::string, double> baseline;
+    if (!options.baselinePath.empty()) {
+        baseline = LoadBaseline(options.baselinePath);
+    }
+
+    const int regressions = Report(results, baseline, options.tolerancePercent);
+    if (options.memory) {
+        ReportMemory(pool.get());
+    }
+
+    if (!options.saveBaselinePath.empty() && !SaveBaseline(options.saveBaselinePath, results)) {
+        return 1;
+    }
+
+    if (regressions > 0) {
+        std::printf("\n%d benchmark(s) regressed by more than %.1f%%\n", regressions,
+            options.tolerancePercent);
+        return 1;
+    }
+    return 0;
+}
@@ -5,13 +5,12 @@
 
 #pragma once
 
+#include "../core/ComponentTraits.h"
 #include "../core/MathUtil.h"
 #include <cstddef>
 
 namespace ECSEngine {
 
-using EntityID = size_t;
-
 /**
  * @struct CameraComponent
  * @brief Keeps track of the position and scale of the camera in world coordinates.
@@ -21,4 +20,8 @@ struct CameraComponent {
     float worldUnitsPerPixel;
 };
 
+// Only the main camera has one
+template <> struct ComponentStoragePolicy<CameraComponent>
+    : std::integral_constant<StoragePolicy, StoragePolicy::Singleton> { };
+
 } // namespace ECSEngine
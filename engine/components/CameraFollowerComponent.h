@@ -8,13 +8,12 @@
  */
 #pragma once
 
+#include "../core/EntityID.h"
 #include "../core/MathUtil.h"
 #include <cstddef>
 
 namespace ECSEngine {
 
-using EntityID = size_t;
-
 /**
  * @struct CameraFollower
  * @brief Marks an entity to be tracked by the camera.
@@ -28,7 +27,7 @@ struct CameraFollower {
     bool followY; // Follow vertical movement
 
     CameraFollower()
-        : entityToTrack(0)
+        : entityToTrack(INVALID_ENTITY)
         , followX(true)
         , followY(true)
     {
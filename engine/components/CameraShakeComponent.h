@@ -8,13 +8,12 @@
  */
 #pragma once
 
+#include "../core/ComponentTraits.h"
 #include "../core/MathUtil.h"
 #include <cstddef>
 
 namespace ECSEngine {
 
-using EntityID = size_t;
-
 /**
  * @struct CameraShake
  * @brief Stores shake parameters for screen shake effects.
@@ -63,4 +62,8 @@ struct CameraShake {
     }
 };
 
+// Shakes the one camera
+template <> struct ComponentStoragePolicy<CameraShake>
+    : std::integral_constant<StoragePolicy, StoragePolicy::Singleton> { };
+
 } // namespace ECSEngine
\ No newline at end of file
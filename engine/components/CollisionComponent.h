@@ -5,16 +5,28 @@
 
 #pragma once
 
+#include <cstdint>
+
+#include "../core/ComponentTraits.h"
 #include "../core/MathUtil.h"
 
 namespace ECSEngine {
 
+// Collision layers are bit flags; a body may sit on several
+inline constexpr uint32_t COLLISION_LAYER_DEFAULT = 1u << 0;
+inline constexpr uint32_t COLLISION_LAYER_PICKUP = 1u << 1; // Collected on touch, never blocks
+inline constexpr uint32_t COLLISION_MASK_ALL = ~0u;
+
 /**
  * @struct CollisionComponent
  * @brief Tracks collision state and bounding boxes for collision detection.
  * @details Keeps track of which sides were in collision during the previous frame,
  * current and previous bounding boxes, and whether the entity is static or dynamic.
  * The boundingBoxOffset is relative to the entity's location and should not be modified.
+ *
+ * Two bodies are pushed apart only if each one's layer is in the other's mask. Every
+ * overlap is reported as a Contact either way (see CollisionManager::GetContacts()), so a
+ * body that masks out a layer still "touches" it, like the player and pickups.
  */
 struct CollisionComponent {
     // Collision sides from previous frame
@@ -44,6 +56,25 @@ struct CollisionComponent {
     // Track if absolute bounding box has been initialized from location + offset
     bool boundingBoxInitialized;
 
+    uint32_t layer = COLLISION_LAYER_DEFAULT; // Layers this body is on
+    uint32_t mask = COLLISION_MASK_ALL; // Layers this body is blocked by
+
+    // Fraction of the velocity kept when bouncing off something (0 = stop dead)
+    float restitution = 0.7f;
+
+    // Sweep from the previous box when moving fast, so thin walls can't be skipped
+    // (see SweepAgainstStatic() in CollisionSystem.h). Costs a few extra queries per step.
+    bool continuous = false;
+
+    // previousBoundingBox is last step's world box (false until the body has been placed)
+    bool previousBoundingBoxValid = false;
+
+    // Dynamic body may be put to sleep once it comes to rest (see SleepSystem.h)
+    bool canSleep = false;
+
+    // Consecutive steps the body has been moving slower than SLEEP_SPEED
+    int restingSteps = 0;
+
     CollisionComponent()
         : collidedTop(false)
         , collidedBottom(false)
@@ -81,4 +112,8 @@ struct CollisionComponent {
     }
 };
 
+// Spawned pickups add bodies mid-frame; chunks keep the existing ones in place
+template <> struct ComponentStoragePolicy<CollisionComponent>
+    : std::integral_constant<StoragePolicy, StoragePolicy::Chunked> { };
+
 }
@@ -5,6 +5,7 @@
 
 #pragma once
 
+#include "../core/ComponentTraits.h"
 #include "../core/MathUtil.h"
 
 namespace ECSEngine {
@@ -13,22 +14,43 @@ namespace ECSEngine {
  * @struct LocationComponent
  * @brief Stores the base location of an entity in world coordinates.
  * All other locations or bounding boxes are stored relative to this point.
+ *
+ * @details previousPosition holds the position at the start of the last fixed simulation
+ * step, so rendering can interpolate between the two when the engine runs a fixed timestep.
+ * Only awake bodies with a MovementComponent have it refreshed each step; code that moves
+ * anything else should set both.
  */
 struct LocationComponent {
     Point2D position;
+    Point2D previousPosition;
 
     LocationComponent()
         : position { 0.0f, 0.0f }
+        , previousPosition { 0.0f, 0.0f }
     {
     }
     LocationComponent(float x, float y)
         : position { x, y }
+        , previousPosition { x, y }
     {
     }
     LocationComponent(const Point2D& pos)
         : position(pos)
+        , previousPosition(pos)
     {
     }
+
+    /**
+     * @brief Position blended between the previous and current step.
+     * @param alpha 0 = previousPosition, 1 = position
+     */
+    Point2D Interpolated(float alpha) const
+    {
+        return previousPosition + (position - previousPosition) * alpha;
+    }
 };
 
+// Streamed every frame by the physics systems, so keep it packed
+template <> struct UseSparseSet<LocationComponent> : std::true_type { };
+
 }
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "../core/ComponentTraits.h"
 #include "../core/MathUtil.h"
 
 namespace ECSEngine {
@@ -31,4 +32,7 @@ struct MovementComponent {
     }
 };
 
+// Streamed every frame by the physics systems, so keep it packed
+template <> struct UseSparseSet<MovementComponent> : std::true_type { };
+
 } // namespace ECSEngine
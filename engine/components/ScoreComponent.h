@@ -5,14 +5,16 @@
 
 #pragma once
 
+#include "../core/ComponentTraits.h"
+#include "../core/EntityID.h"
+#include "../core/Snapshot.h"
 #include "../managers/SpriteManager.h"
+#include <array>
 #include <cstddef>
 #include <vector>
 
 namespace ECSEngine {
 
-using EntityID = size_t;
-
 /**
  * @struct ScoreComponent
  * @brief Stores the current score, entities used to display it, and digit sprites.
@@ -39,4 +41,24 @@ struct ScoreComponent {
     }
 };
 
+// ScoreSystem shows the score of one entity, the player
+template <> struct ComponentStoragePolicy<ScoreComponent>
+    : std::integral_constant<StoragePolicy, StoragePolicy::Singleton> { };
+
+// displayEntities owns memory, so snapshots write the fields one by one
+template <> struct SnapshotTraits<ScoreComponent> {
+    static void Write(SnapshotWriter& writer, const ScoreComponent& score)
+    {
+        writer.WriteValue(score.score);
+        writer.WriteValues(score.displayEntities);
+        writer.WriteValue(score.digitSprites);
+    }
+
+    static bool Read(SnapshotReader& reader, ScoreComponent& score)
+    {
+        return reader.ReadValue(score.score) && reader.ReadValues(score.displayEntities)
+            && reader.ReadValue(score.digitSprites);
+    }
+};
+
 }
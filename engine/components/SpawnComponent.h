@@ -5,50 +5,50 @@
 
 #pragma once
 
-#include <unordered_map>
-#include "../core/MathUtil.h"
-#include "../managers/SpriteManager.h"
+#include <cstdint>
 
-namespace ECSEngine {
+#include "../core/EntityID.h"
+#include "../core/Prefab.h"
 
-using EntityID = size_t;
+namespace ECSEngine {
 
 /**
  * @struct SpawnComponent
  * @brief Handles spawning data for entities.
  *
- * @details Sprite rectangle is relative to the entity location in the world and is only
- * defined if an entity also has a LocationComponent.
+ * @details Spawned entities are instances of a prefab placed at the spawner, so the
+ * spawner entity must also have a LocationComponent.
  */
 struct SpawnComponent {
 
     EntityID entityID;           // Entity this component is attached to
-    std::string entityType;      // Description of what should be spawned
-    SpriteID spriteID;           // Sprite/texture of object to spawn
+    PrefabID prefab;             // What to spawn (PrefabRegistry::Register())
 
-    float timeToNextSpawn;
+    float timeToNextSpawn;       // Delay before the first spawn once scheduled
     float spawnInterval;         // Time between spawns
     int spawnCount;
     int maxSpawns;               // Maximum spawns (-1 for unlimited)
+    uint64_t nextSpawnTick;      // TimerWheel tick of the next spawn, 0 while unscheduled
 
 
     SpawnComponent()
-        : entityID(0)
-        , entityType("")
-        , spriteID(0)
+        : entityID(INVALID_ENTITY)
+        , prefab(INVALID_PREFAB)
         , timeToNextSpawn(0.0f)
         , spawnInterval(1.0f)
         , spawnCount(0)
         , maxSpawns(-1)
+        , nextSpawnTick(0)
     {
     }
-    SpawnComponent(size_t entity, const std::string& type, SpriteID spriteID, float interval)
+    SpawnComponent(EntityID entity, PrefabID prefab, float interval)
         : entityID(entity)
-        , entityType(type)
-        , spriteID(spriteID)
+        , prefab(prefab)
         , timeToNextSpawn(0.0f)
         , spawnInterval(interval)
         , spawnCount(0)
+        , maxSpawns(-1)
+        , nextSpawnTick(0)
     {
     }
 };
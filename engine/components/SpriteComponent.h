@@ -9,6 +9,7 @@
 
 #pragma once
 
+#include "../core/ComponentTraits.h"
 #include "../core/MathUtil.h"
 #include "../managers/SpriteManager.h"
 
@@ -26,22 +27,33 @@ struct SpriteComponent {
     Rect spriteRect; // Bounds relative to entity location
     bool worldSpace; // False = screen space
     bool isAlive;
+    bool isStatic; // Never moves: drawn from the cached static batches (world space only)
+    int layer; // Draw order of static sprites, lower layers first (e.g. sky below world)
 
     SpriteComponent()
         : spriteID(0)
         , spriteRect()
         , worldSpace(true)
         , isAlive(true)
+        , isStatic(false)
+        , layer(0)
     {
     }
 
-    SpriteComponent(SpriteID id, const Rect& rect, bool isWorldSpace = true, bool living = true)
+    SpriteComponent(SpriteID id, const Rect& rect, bool isWorldSpace = true, bool living = true,
+        bool staticSprite = false)
         : spriteID(id)
         , spriteRect(rect)
         , worldSpace(isWorldSpace)
         , isAlive(living)
+        , isStatic(staticSprite)
+        , layer(0)
     {
     }
 };
 
+// Tiles stream in and out and stars spawn, so grow without moving the existing sprites
+template <> struct ComponentStoragePolicy<SpriteComponent>
+    : std::integral_constant<StoragePolicy, StoragePolicy::Chunked> { };
+
 } // namespace ECSEngine
\ No newline at end of file
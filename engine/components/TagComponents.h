@@ -0,0 +1,30 @@
+/**
+ * @file TagComponents.h
+ * @brief Empty marker components used to select entities by role.
+ * @details Tags carry no data; query them with View<>() or HasComponent<>() instead of
+ * comparing entity names.
+ */
+
+#pragma once
+
+namespace ECSEngine {
+
+/**
+ * @struct StarTag
+ * @brief Marks a collectible star.
+ */
+struct StarTag { };
+
+/**
+ * @struct MainCameraTag
+ * @brief Marks the camera entity that drives the window view.
+ */
+struct MainCameraTag { };
+
+/**
+ * @struct Sleeping
+ * @brief Marks a resting dynamic body that the physics systems skip (see SleepSystem.h).
+ */
+struct Sleeping { };
+
+} // namespace ECSEngine
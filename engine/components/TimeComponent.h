@@ -10,25 +10,33 @@
 #ifndef TIMECOMPONENT_H
 #define TIMECOMPONENT_H
 
+#include <cstdint>
+
+#include "../core/TimerWheel.h"
+
 namespace ECSEngine {
 
 /**
  * @struct TimeComponent
  * @brief Time-based countdown timer for entities.
- * @details Uses deltaTime for accurate, frame-rate independent timing.
- * Managed by TimeSystem which decrements timeRemaining each frame.
+ * @details Running timers sit in a TimerWheel until they expire, so TimeSystem does nothing
+ * for them in between; ask TimeLeft() for the live countdown. Timers added running are
+ * scheduled by TimeSystem on its next step. To start one again, call Start() and mark it
+ * changed (EntityManager::MarkChanged()); to stop one, clear isRunning.
  */
 struct TimeComponent {
     float totalDuration;     // Total duration in seconds
-    float timeRemaining;     // Time remaining in seconds
+    float timeRemaining;     // Countdown when the timer was started, in seconds
     bool isRunning;          // Whether timer is actively counting down
     bool restart;            // If true, timer resets to totalDuration when it reaches 0
+    uint64_t expiryTick;     // TimerWheel tick it runs out at, 0 until TimeSystem schedules it
 
     TimeComponent()
         : totalDuration(0.0f)
         , timeRemaining(0.0f)
         , isRunning(false)
         , restart(false)
+        , expiryTick(0)
     {
     }
 
@@ -37,7 +45,25 @@ struct TimeComponent {
         , timeRemaining(duration)
         , isRunning(duration > 0.0f)
         , restart(autoRestart)
+        , expiryTick(0)
+    {
+    }
+
+    // Runs the full duration again from the next step
+    void Start()
+    {
+        timeRemaining = totalDuration;
+        isRunning = true;
+        expiryTick = 0;
+    }
+
+    // Seconds until the timer runs out, or the full countdown until it is scheduled
+    float TimeLeft(const TimerWheel& timers) const
     {
+        if (!isRunning || expiryTick == 0) {
+            return timeRemaining;
+        }
+        return timers.SecondsUntil(expiryTick);
     }
 };
 
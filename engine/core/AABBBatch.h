@@ -0,0 +1,257 @@
+/**
+ * @file AABBBatch.h
+ * @brief Structure-of-arrays bounding boxes with a SIMD overlap test.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "MathUtil.h"
+
+// Widest instruction set the target was compiled for (e.g. -mavx, or NEON on ARM64)
+#if defined(__AVX__)
+#include <immintrin.h>
+#define ECS_AABB_AVX 1
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define ECS_AABB_SSE2 1
+#elif defined(__ARM_NEON) || defined(_M_ARM64)
+#include <arm_neon.h>
+#define ECS_AABB_NEON 1
+#endif
+
+namespace ECSEngine {
+
+/**
+ * @struct AABBHits
+ * @brief Boxes that overlapped a query, in batch order, with their penetration depths.
+ */
+struct AABBHits {
+    std::vector<uint32_t> index; // Index of the box in the batch
+    std::vector<float> horizontal; // Penetration depth on X axis
+    std::vector<float> vertical; // Penetration depth on Y axis
+
+    size_t Size() const { return index.size(); }
+};
+
+/**
+ * @class AABBBatch
+ * @brief Bounding boxes stored as separate minX/minY/maxX/maxY arrays.
+ * @details Overlaps() tests one query box against 4 (SSE2, NEON) or 8 (AVX) boxes per
+ * instruction and only drops to scalar code for the hits and the last few boxes.
+ * OverlapsScalar() is the reference it must agree with: the same strict test as
+ * Rect::RectIntersect() (touching edges don't overlap) and the same depths as
+ * CalculateOverlap().
+ */
+class AABBBatch {
+public:
+    void Clear()
+    {
+        mMinX.clear();
+        mMinY.clear();
+        mMaxX.clear();
+        mMaxY.clear();
+    }
+
+    void Reserve(size_t capacity)
+    {
+        mMinX.reserve(capacity);
+        mMinY.reserve(capacity);
+        mMaxX.reserve(capacity);
+        mMaxY.reserve(capacity);
+    }
+
+    /**
+     * @brief Appends a box.
+     * @return Its index in the batch
+     */
+    size_t Add(const Rect& box)
+    {
+        mMinX.push_back(box.topLeft.x);
+        mMinY.push_back(box.topLeft.y);
+        mMaxX.push_back(box.topLeft.x + box.width);
+        mMaxY.push_back(box.topLeft.y + box.height);
+        return mMinX.size() - 1;
+    }
+
+    size_t Size() const { return mMinX.size(); }
+
+    /**
+     * @brief Finds every box overlapping query, using the widest available SIMD path.
+     * @param query Box to test against the whole batch
+     * @param hits Replaced with the overlapping boxes
+     * @return Number of hits
+     */
+    size_t Overlaps(const Rect& query, AABBHits& hits) const
+    {
+        const Bounds q = BoundsOf(query);
+        BeginHits(hits);
+        size_t count = 0;
+        size_t i = 0;
+
+#if defined(ECS_AABB_AVX)
+        const __m256 qMinX = _mm256_set1_ps(q.minX);
+        const __m256 qMinY = _mm256_set1_ps(q.minY);
+        const __m256 qMaxX = _mm256_set1_ps(q.maxX);
+        const __m256 qMaxY = _mm256_set1_ps(q.maxY);
+
+        for (; i + 8 <= Size(); i += 8) {
+            const __m256 minX = _mm256_loadu_ps(mMinX.data() + i);
+            const __m256 minY = _mm256_loadu_ps(mMinY.data() + i);
+            const __m256 maxX = _mm256_loadu_ps(mMaxX.data() + i);
+            const __m256 maxY = _mm256_loadu_ps(mMaxY.data() + i);
+
+            const __m256 overlapX = _mm256_and_ps(
+                _mm256_cmp_ps(qMinX, maxX, _CMP_LT_OQ), _mm256_cmp_ps(minX, qMaxX, _CMP_LT_OQ));
+            const __m256 overlapY = _mm256_and_ps(
+                _mm256_cmp_ps(qMinY, maxY, _CMP_LT_OQ), _mm256_cmp_ps(minY, qMaxY, _CMP_LT_OQ));
+            const unsigned mask
+                = static_cast<unsigned>(_mm256_movemask_ps(_mm256_and_ps(overlapX, overlapY)));
+            if (mask == 0) {
+                continue;
+            }
+
+            alignas(32) float depthX[8];
+            alignas(32) float depthY[8];
+            _mm256_store_ps(depthX,
+                _mm256_sub_ps(_mm256_min_ps(qMaxX, maxX), _mm256_max_ps(qMinX, minX)));
+            _mm256_store_ps(depthY,
+                _mm256_sub_ps(_mm256_min_ps(qMaxY, maxY), _mm256_max_ps(qMinY, minY)));
+            count = EmitLanes(mask, i, depthX, depthY, hits, count);
+        }
+#elif defined(ECS_AABB_SSE2)
+        const __m128 qMinX = _mm_set1_ps(q.minX);
+        const __m128 qMinY = _mm_set1_ps(q.minY);
+        const __m128 qMaxX = _mm_set1_ps(q.maxX);
+        const __m128 qMaxY = _mm_set1_ps(q.maxY);
+
+        for (; i + 4 <= Size(); i += 4) {
+            const __m128 minX = _mm_loadu_ps(mMinX.data() + i);
+            const __m128 minY = _mm_loadu_ps(mMinY.data() + i);
+            const __m128 maxX = _mm_loadu_ps(mMaxX.data() + i);
+            const __m128 maxY = _mm_loadu_ps(mMaxY.data() + i);
+
+            const __m128 overlapX = _mm_and_ps(_mm_cmplt_ps(qMinX, maxX), _mm_cmplt_ps(minX, qMaxX));
+            const __m128 overlapY = _mm_and_ps(_mm_cmplt_ps(qMinY, maxY), _mm_cmplt_ps(minY, qMaxY));
+            const unsigned mask = static_cast<unsigned>(_mm_movemask_ps(_mm_and_ps(overlapX, overlapY)));
+            if (mask == 0) {
+                continue;
+            }
+
+            alignas(16) float depthX[4];
+            alignas(16) float depthY[4];
+            _mm_store_ps(depthX, _mm_sub_ps(_mm_min_ps(qMaxX, maxX), _mm_max_ps(qMinX, minX)));
+            _mm_store_ps(depthY, _mm_sub_ps(_mm_min_ps(qMaxY, maxY), _mm_max_ps(qMinY, minY)));
+            count = EmitLanes(mask, i, depthX, depthY, hits, count);
+        }
+#elif defined(ECS_AABB_NEON)
+        const float32x4_t qMinX = vdupq_n_f32(q.minX);
+        const float32x4_t qMinY = vdupq_n_f32(q.minY);
+        const float32x4_t qMaxX = vdupq_n_f32(q.maxX);
+        const float32x4_t qMaxY = vdupq_n_f32(q.maxY);
+        // Lane i contributes bit i, like movemask
+        const uint32_t laneBitsInit[4] = { 1, 2, 4, 8 };
+        const uint32x4_t laneBits = vld1q_u32(laneBitsInit);
+
+        for (; i + 4 <= Size(); i += 4) {
+            const float32x4_t minX = vld1q_f32(mMinX.data() + i);
+            const float32x4_t minY = vld1q_f32(mMinY.data() + i);
+            const float32x4_t maxX = vld1q_f32(mMaxX.data() + i);
+            const float32x4_t maxY = vld1q_f32(mMaxY.data() + i);
+
+            const uint32x4_t overlapX = vandq_u32(vcltq_f32(qMinX, maxX), vcltq_f32(minX, qMaxX));
+            const uint32x4_t overlapY = vandq_u32(vcltq_f32(qMinY, maxY), vcltq_f32(minY, qMaxY));
+            const unsigned mask
+                = vaddvq_u32(vandq_u32(vandq_u32(overlapX, overlapY), laneBits));
+            if (mask == 0) {
+                continue;
+            }
+
+            float depthX[4];
+            float depthY[4];
+            vst1q_f32(depthX, vsubq_f32(vminq_f32(qMaxX, maxX), vmaxq_f32(qMinX, minX)));
+            vst1q_f32(depthY, vsubq_f32(vminq_f32(qMaxY, maxY), vmaxq_f32(qMinY, minY)));
+            count = EmitLanes(mask, i, depthX, depthY, hits, count);
+        }
+#endif
+
+        // Remainder (or everything, without SIMD)
+        count = ScalarRange(q, i, Size(), hits, count);
+        return EndHits(hits, count);
+    }
+
+    /**
+     * @brief Reference implementation of Overlaps(), one box at a time.
+     */
+    size_t OverlapsScalar(const Rect& query, AABBHits& hits) const
+    {
+        BeginHits(hits);
+        return EndHits(hits, ScalarRange(BoundsOf(query), 0, Size(), hits, 0));
+    }
+
+private:
+    struct Bounds {
+        float minX, minY, maxX, maxY;
+    };
+
+    static Bounds BoundsOf(const Rect& box)
+    {
+        return { box.topLeft.x, box.topLeft.y, box.topLeft.x + box.width,
+            box.topLeft.y + box.height };
+    }
+
+    // Hits are written in place, so size for the worst case and trim at the end
+    void BeginHits(AABBHits& hits) const
+    {
+        hits.index.resize(Size());
+        hits.horizontal.resize(Size());
+        hits.vertical.resize(Size());
+    }
+
+    static size_t EndHits(AABBHits& hits, size_t count)
+    {
+        hits.index.resize(count);
+        hits.horizontal.resize(count);
+        hits.vertical.resize(count);
+        return count;
+    }
+
+    size_t ScalarRange(const Bounds& q, size_t first, size_t last, AABBHits& hits, size_t count) const
+    {
+        for (size_t i = first; i < last; ++i) {
+            if (q.minX < mMaxX[i] && mMinX[i] < q.maxX && q.minY < mMaxY[i] && mMinY[i] < q.maxY) {
+                hits.index[count] = static_cast<uint32_t>(i);
+                hits.horizontal[count] = std::min(q.maxX, mMaxX[i]) - std::max(q.minX, mMinX[i]);
+                hits.vertical[count] = std::min(q.maxY, mMaxY[i]) - std::max(q.minY, mMinY[i]);
+                ++count;
+            }
+        }
+        return count;
+    }
+
+    [[maybe_unused]] static size_t EmitLanes(unsigned mask, size_t first, const float* depthX,
+        const float* depthY, AABBHits& hits, size_t count)
+    {
+        while (mask != 0) {
+            const int lane = std::countr_zero(mask);
+            hits.index[count] = static_cast<uint32_t>(first + lane);
+            hits.horizontal[count] = depthX[lane];
+            hits.vertical[count] = depthY[lane];
+            ++count;
+            mask &= mask - 1;
+        }
+        return count;
+    }
+
+    std::vector<float> mMinX;
+    std::vector<float> mMinY;
+    std::vector<float> mMaxX;
+    std::vector<float> mMaxY;
+};
+
+} // namespace ECSEngine
@@ -0,0 +1,196 @@
+/**
+ * @file ChunkedStorage.h
+ * @brief Component storage in fixed-size chunks that never move once allocated.
+ * @details Slots behave like ComponentStorage (stable handles, a free list), but growing
+ * allocates one more chunk instead of reallocating, so adding components mid-frame never
+ * copies the existing ones and references to them stay valid until they are removed.
+ * Freed slots are reused first, which makes each chunk a fixed-block pool for
+ * components that come and go (spawned pickups).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+#include <memory>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "ComponentStorage.h"
+
+namespace ECSEngine {
+
+template <typename T> class ChunkedStorage {
+public:
+    // About 16 KB per chunk, rounded down to a power of two so a slot is a shift and a mask
+    static constexpr size_t CHUNK_SLOTS = std::bit_floor(std::max<size_t>(16384 / sizeof(T), 1));
+
+    std::vector<std::unique_ptr<T[]>> mChunks; // Never reallocated, only appended
+    std::vector<bool> mValid; // Quickly track if a component is valid
+    std::vector<size_t> mFreeList; // Avoid scanning for free slots
+    std::vector<size_t> mOwners; // Entity owning each slot (INVALID_OWNER for free slots)
+    std::vector<uint32_t> mVersions; // Change tick of each slot's last recorded write
+    size_t mCount = 0;
+
+    ChunkedStorage() = default;
+    ~ChunkedStorage() = default;
+
+    // Store By Copy
+    size_t store(size_t owner, const T& value)
+    {
+        const size_t id = Claim(owner);
+        Slot(id) = value;
+        return id;
+    }
+
+    // Store by Move
+    size_t store(size_t owner, T&& value)
+    {
+        const size_t id = Claim(owner);
+        Slot(id) = std::move(value);
+        return id;
+    }
+
+    void remove(size_t id)
+    {
+        assert(valid(id));
+
+        mValid[id] = false;
+        Slot(id) = T {};
+        mOwners[id] = INVALID_OWNER;
+        mFreeList.push_back(id);
+        mCount -= 1;
+    }
+
+    T& operator[](size_t id)
+    {
+        assert(valid(id));
+        return Slot(id);
+    }
+
+    const T& operator[](size_t id) const { return mChunks[id / CHUNK_SLOTS][id % CHUNK_SLOTS]; }
+
+    bool valid(size_t id) const { return id < mValid.size() && mValid[id]; }
+
+    // Slot -> owning entity, used by EntityManager views to walk only live components
+    const std::vector<size_t>& owners() const { return mOwners; }
+
+    // Change tracking, see EntityManager::MarkChanged()
+    uint32_t version(size_t id) const { return mVersions[id]; }
+
+    void touch(size_t id, uint32_t tick)
+    {
+        assert(valid(id));
+        mVersions[id] = tick;
+    }
+
+    size_t size() const { return mCount; }
+
+    size_t memoryUsage() const
+    {
+        return mChunks.size() * CHUNK_SLOTS * sizeof(T) + VectorBytes(mChunks)
+            + VectorBytes(mValid) + VectorBytes(mFreeList) + VectorBytes(mOwners)
+            + VectorBytes(mVersions);
+    }
+
+    // Allocates the chunks up front as well, so filling them never allocates
+    void reserve(size_t capacity)
+    {
+        while (mChunks.size() * CHUNK_SLOTS < capacity) {
+            mChunks.push_back(std::make_unique<T[]>(CHUNK_SLOTS));
+        }
+        mValid.reserve(capacity);
+        mOwners.reserve(capacity);
+        mVersions.reserve(capacity);
+    }
+
+    void save(SnapshotWriter& writer) const
+    {
+        writer.WriteValue(static_cast<uint64_t>(mOwners.size()));
+        for (size_t first = 0; first < mOwners.size(); first += CHUNK_SLOTS) {
+            const T* chunk = mChunks[first / CHUNK_SLOTS].get();
+            const size_t count = std::min(CHUNK_SLOTS, mOwners.size() - first);
+            if constexpr (CustomSnapshot<T>) {
+                for (size_t i = 0; i < count; ++i) {
+                    writer.WriteValue(chunk[i]);
+                }
+            } else {
+                static_assert(std::is_trivially_copyable_v<T>,
+                    "Specialize SnapshotTraits for types that own memory");
+                writer.WriteBytes(chunk, count * sizeof(T));
+            }
+        }
+        writer.WriteValues(mValid);
+        writer.WriteValues(mFreeList);
+        writer.WriteValues(mOwners);
+        writer.WriteValues(mVersions);
+        writer.WriteValue(static_cast<uint64_t>(mCount));
+    }
+
+    // Keeps the chunks it already has, so restoring every frame does not allocate
+    bool load(SnapshotReader& reader)
+    {
+        uint64_t slots = 0;
+        if (!reader.ReadValue(slots)) {
+            return false;
+        }
+        for (uint64_t first = 0; first < slots; first += CHUNK_SLOTS) {
+            // One chunk at a time, so a damaged count fails before allocating much
+            if (mChunks.size() <= first / CHUNK_SLOTS) {
+                mChunks.push_back(std::make_unique<T[]>(CHUNK_SLOTS));
+            }
+            T* chunk = mChunks[first / CHUNK_SLOTS].get();
+            const auto count = static_cast<size_t>(std::min<uint64_t>(CHUNK_SLOTS, slots - first));
+            if constexpr (CustomSnapshot<T>) {
+                for (size_t i = 0; i < count; ++i) {
+                    if (!reader.ReadValue(chunk[i])) {
+                        return false;
+                    }
+                }
+            } else if (!reader.ReadBytes(chunk, count * sizeof(T))) {
+                return false;
+            }
+        }
+
+        uint64_t count = 0;
+        const bool loaded = reader.ReadValues(mValid) && reader.ReadValues(mFreeList)
+            && reader.ReadValues(mOwners) && reader.ReadValues(mVersions)
+            && reader.ReadValue(count);
+        mCount = static_cast<size_t>(count);
+        return loaded && mOwners.size() == slots;
+    }
+
+private:
+    T& Slot(size_t id) { return mChunks[id / CHUNK_SLOTS][id % CHUNK_SLOTS]; }
+
+    size_t Claim(size_t owner)
+    {
+        size_t id;
+
+        if (!mFreeList.empty()) {
+            id = mFreeList.back();
+            mFreeList.pop_back();
+
+            mValid[id] = true;
+            mOwners[id] = owner;
+            mVersions[id] = 0;
+        } else {
+            id = mOwners.size();
+            if (id == mChunks.size() * CHUNK_SLOTS) {
+                mChunks.push_back(std::make_unique<T[]>(CHUNK_SLOTS));
+            }
+            mValid.push_back(true);
+            mOwners.push_back(owner);
+            mVersions.push_back(0);
+        }
+
+        mCount += 1;
+
+        return id;
+    }
+};
+
+}
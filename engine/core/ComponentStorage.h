@@ -9,14 +9,31 @@
 
 #include <vector>
 #include <cassert>
+#include <cstdint>
+#include <limits>
+
+#include "Snapshot.h"
 
 namespace ECSEngine {
 
+// Owner recorded for slots that are not currently holding a component
+inline constexpr size_t INVALID_OWNER = std::numeric_limits<size_t>::max();
+
+// Heap bytes a storage array holds on to, for memoryUsage()
+template <typename V> size_t VectorBytes(const std::vector<V>& values)
+{
+    return values.capacity() * sizeof(V);
+}
+
+inline size_t VectorBytes(const std::vector<bool>& flags) { return (flags.capacity() + 7) / 8; }
+
 template <typename T> class ComponentStorage {
 public: // why are these public????
     std::vector<T> mStorage;
     std::vector<bool> mValid; // Quickly track if a component is valid
     std::vector<size_t> mFreeList; // Avoid scanning for free slots
+    std::vector<size_t> mOwners; // Entity owning each slot (INVALID_OWNER for free slots)
+    std::vector<uint32_t> mVersions; // Change tick of each slot's last recorded write
     size_t mCount = 0;
 
     ComponentStorage() = default;
@@ -25,7 +42,7 @@ public: // why are these public????
     // We can do perfect forwarding here, but this is what I had
 
     // Store By Copy
-    size_t store(const T& value)
+    size_t store(size_t owner, const T& value)
     {
 
         size_t id;
@@ -37,11 +54,15 @@ public: // why are these public????
 
             mStorage[id] = value;
             mValid[id] = true;
+            mOwners[id] = owner;
+            mVersions[id] = 0;
         } else {
 
             id = mStorage.size();
             mStorage.push_back(value);
             mValid.push_back(true);
+            mOwners.push_back(owner);
+            mVersions.push_back(0);
         }
 
         mCount += 1;
@@ -50,7 +71,7 @@ public: // why are these public????
     }
 
     // Store by Move
-    size_t store(T&& value)
+    size_t store(size_t owner, T&& value)
     {
 
         size_t id;
@@ -62,11 +83,15 @@ public: // why are these public????
 
             mStorage[id] = std::move(value);
             mValid[id] = true;
+            mOwners[id] = owner;
+            mVersions[id] = 0;
         } else {
 
             id = mStorage.size();
             mStorage.push_back(std::move(value));
             mValid.push_back(true);
+            mOwners.push_back(owner);
+            mVersions.push_back(0);
         }
 
         mCount += 1;
@@ -80,6 +105,7 @@ public: // why are these public????
 
         mValid[id] = false;
         mStorage[id] = T {};
+        mOwners[id] = INVALID_OWNER;
         mFreeList.push_back(id);
         mCount -= 1;
     }
@@ -95,16 +121,57 @@ public: // why are these public????
 
     bool valid(size_t id) const { return id < mValid.size() && mValid[id]; }
 
+    // Slot -> owning entity, used by EntityManager views to walk only live components
+    const std::vector<size_t>& owners() const { return mOwners; }
+
+    // Change tracking, see EntityManager::MarkChanged()
+    uint32_t version(size_t id) const { return mVersions[id]; }
+
+    void touch(size_t id, uint32_t tick)
+    {
+        assert(valid(id));
+        mVersions[id] = tick;
+    }
+
     size_t size() const
     {
 
         return mCount; // or mStorage.size() - mFreeList.size()
     }
 
+    size_t memoryUsage() const
+    {
+        return VectorBytes(mStorage) + VectorBytes(mValid) + VectorBytes(mFreeList)
+            + VectorBytes(mOwners) + VectorBytes(mVersions);
+    }
+
     void reserve(size_t capacity)
     {
         mStorage.reserve(capacity);
         mValid.reserve(capacity);
+        mOwners.reserve(capacity);
+        mVersions.reserve(capacity);
+    }
+
+    // Snapshots keep every slot, free ones included, so component handles stay valid
+    void save(SnapshotWriter& writer) const
+    {
+        writer.WriteValues(mStorage);
+        writer.WriteValues(mValid);
+        writer.WriteValues(mFreeList);
+        writer.WriteValues(mOwners);
+        writer.WriteValues(mVersions);
+        writer.WriteValue(static_cast<uint64_t>(mCount));
+    }
+
+    bool load(SnapshotReader& reader)
+    {
+        uint64_t count = 0;
+        const bool loaded = reader.ReadValues(mStorage) && reader.ReadValues(mValid)
+            && reader.ReadValues(mFreeList) && reader.ReadValues(mOwners)
+            && reader.ReadValues(mVersions) && reader.ReadValue(count);
+        mCount = static_cast<size_t>(count);
+        return loaded;
     }
 };
 
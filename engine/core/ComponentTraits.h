@@ -0,0 +1,105 @@
+/**
+ * @file ComponentTraits.h
+ * @brief Compile-time selection of the storage used for each component type.
+ * @details Each component type picks a StoragePolicy and an expected capacity by
+ * specializing the traits below next to its definition. EntityManager builds its
+ * registries from them, so the choice costs nothing at runtime.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <initializer_list>
+#include <string_view>
+#include <type_traits>
+
+#include "ChunkedStorage.h"
+#include "ComponentStorage.h"
+#include "SingletonStorage.h"
+#include "SparseSetStorage.h"
+#include "TagStorage.h"
+
+namespace ECSEngine {
+
+/**
+ * @brief How the components of one type are stored.
+ */
+enum class StoragePolicy {
+    Dense, // ComponentStorage: stable slots with a free list
+    Chunked, // ChunkedStorage: stable slots in chunks that never move, for churny types
+    Sparse, // SparseSetStorage: packed, for hot components streamed every frame
+    Tag, // TagStorage: empty markers, only the holders are kept
+    Singleton, // SingletonStorage: one inline slot, for components a single entity holds
+};
+
+/**
+ * @brief Opt a component type into SparseSetStorage.
+ * @details Specialize to std::true_type next to the component definition for hot
+ * components that are streamed every frame. Shorthand for StoragePolicy::Sparse.
+ *
+ *   template <> struct UseSparseSet<LocationComponent> : std::true_type { };
+ */
+template <typename T> struct UseSparseSet : std::false_type { };
+
+/**
+ * @brief The StoragePolicy of component T.
+ * @details Empty types default to Tag, UseSparseSet types to Sparse, the rest to Dense.
+ * Specialize for anything else:
+ *
+ *   template <> struct ComponentStoragePolicy<CameraComponent>
+ *       : std::integral_constant<StoragePolicy, StoragePolicy::Singleton> { };
+ */
+template <typename T>
+struct ComponentStoragePolicy
+    : std::integral_constant<StoragePolicy,
+          std::is_empty_v<T>         ? StoragePolicy::Tag
+              : UseSparseSet<T>::value ? StoragePolicy::Sparse
+                                       : StoragePolicy::Dense> { };
+
+/**
+ * @brief Components of type T the EntityManager reserves room for when it is created.
+ * @details Specialize for types that reliably grow large, so filling a level does not
+ * reallocate their storage over and over.
+ *
+ *   template <> struct ExpectedCapacity<LocationComponent>
+ *       : std::integral_constant<size_t, 4096> { };
+ */
+template <typename T> struct ExpectedCapacity : std::integral_constant<size_t, 0> { };
+
+// The registry type the EntityManager keeps for component T
+template <typename T, StoragePolicy Policy = ComponentStoragePolicy<T>::value>
+using StorageFor = std::conditional_t<Policy == StoragePolicy::Sparse, SparseSetStorage<T>,
+    std::conditional_t<Policy == StoragePolicy::Tag, TagStorage<T>,
+        std::conditional_t<Policy == StoragePolicy::Singleton, SingletonStorage<T>,
+            std::conditional_t<Policy == StoragePolicy::Chunked, ChunkedStorage<T>,
+                ComponentStorage<T>>>>>;
+
+/**
+ * @brief The unqualified name of component type T, for reports ("LocationComponent").
+ * @details Taken from the compiler's function signature (GCC and Clang, or MSVC).
+ */
+template <typename T> constexpr std::string_view ComponentName()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+    // "... ComponentName<struct ECSEngine::LocationComponent>(void)"
+    std::string_view name = __FUNCSIG__;
+    name.remove_prefix(name.find("ComponentName<") + sizeof("ComponentName<") - 1);
+    name = name.substr(0, name.rfind(">("));
+    for (std::string_view keyword : { "struct ", "class ", "enum " }) {
+        if (name.starts_with(keyword)) {
+            name.remove_prefix(keyword.size());
+        }
+    }
+#else
+    // "... [with T = ECSEngine::LocationComponent; ...]" or "... [T = ECSEngine::...]"
+    std::string_view name = __PRETTY_FUNCTION__;
+    name.remove_prefix(name.find("T = ") + 4);
+    name = name.substr(0, name.find_first_of(";]"));
+#endif
+    if (name.starts_with("ECSEngine::")) {
+        name.remove_prefix(sizeof("ECSEngine::") - 1);
+    }
+    return name;
+}
+
+}
@@ -1,13 +1,32 @@
 #pragma once
 
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <functional>
+#include <memory_resource>
+#include <random>
 #include <vector>
 
 #include "core/MathUtil.h"
+#include "core/Prefab.h"
+#include "core/Profiler.h"
+#include "core/Scheduler.h"
+#include "core/Snapshot.h"
+#include "core/ThreadPool.h"
+#include "core/TimerWheel.h"
+#include "managers/AssetLoader.h"
+#include "managers/CollisionManager.h"
+#include "managers/EntityCommandBuffer.h"
 #include "managers/EntityManager.h"
+#include "managers/InputLog.h"
+#include "managers/InputManager.h"
+#include "managers/RenderManager.h"
 #include "managers/SoundManager.h"
 #include "managers/SpriteManager.h"
 #include "managers/WindowManager.h"
 
+#include "components/AccelerationComponent.h"
 #include "components/CameraComponent.h"
 #include "components/CameraFollowerComponent.h"
 #include "components/CameraShakeComponent.h"
@@ -25,8 +44,12 @@
 #include "systems/GravitySystem.h"
 #include "systems/InputSystem.h"
 #include "systems/MovementSystem.h"
+#include "systems/PickupSystem.h"
+#include "systems/PlayerContactSystem.h"
 #include "systems/ProcessEvents.h"
+#include "systems/ProfilerOverlaySystem.h"
 #include "systems/ScoreSystem.h"
+#include "systems/SleepSystem.h"
 #include "systems/SpawnSystem.h"
 #include "systems/SpriteSystem.h"
 #include "systems/TimeSystem.h"
@@ -36,58 +59,711 @@
 
 namespace ECSEngine {
 
+/**
+ * @brief The points in a frame where a schedule runs.
+ */
+enum class Stage {
+    FrameStart, // Once per frame before simulating (window events)
+    Simulation, // Once per fixed step, or per frame in variable mode
+    Render, // Once per frame after simulating
+};
+
+/**
+ * @struct HeadlessOptions
+ * @brief Settings for an ECSEngine that simulates without a window, audio or textures.
+ * @details A headless engine steps as fast as the CPU allows: every frame advances by one
+ * fixed timestep (1 / 60 s in variable mode) instead of the wall clock, so a run is
+ * repeatable for the same input. Input comes from an InputScript.
+ *
+ * Headless engines share no state, so several worlds can step in parallel (RunWorlds()).
+ * Give each one threadCount = 0 to run its systems inline on the thread stepping it; the
+ * profiler, if compiled in, is process wide and should only watch one world at a time.
+ */
+struct HeadlessOptions {
+    unsigned int viewWidth = 1024; // Camera view in pixels, for camera and streaming code
+    unsigned int viewHeight = 768;
+    size_t threadCount = 0; // Worker threads for this world's systems, 0 = run them inline
+};
+
+/**
+ * @brief Feeds a headless engine's input: called at the start of every frame to press and
+ * release keys through InputManager::SetKey(). frame counts from 0.
+ */
+using InputScript = std::function<void(InputManager& input, uint64_t frame)>;
+
 template <typename... Components> class ECSEngine {
 public:
+    // Length of a headless frame without a fixed timestep
+    static constexpr float HEADLESS_FRAME_SECONDS = 1.0f / 60.0f;
+
+    /**
+     * @brief Creates the window and registers the built-in systems.
+     * @details Systems are registered with the component types and managers they touch, so
+     * each Stage's Scheduler can run independent systems in parallel. Games can add their own
+     * systems through GetSchedule().
+     */
     ECSEngine(unsigned int width, unsigned int height, const std::string& name);
 
+    /**
+     * @brief Creates a headless engine: no window, no audio, no texture uploads.
+     * @details The same systems run, minus event polling (replaced by the input script),
+     * sound playback and drawing. Assets can be requested as usual; they are recorded
+     * without being decoded. See HeadlessOptions.
+     */
+    explicit ECSEngine(const HeadlessOptions& options);
+
+    /**
+     * @brief Runs frames until the window closes, or until Stop() when headless.
+     */
     void Run();
 
+    /**
+     * @brief Runs exactly frameCount frames, back to back.
+     * @details Meant for headless engines; a windowed engine still polls, draws and uses
+     * the wall clock for each frame.
+     */
+    void RunFrames(uint64_t frameCount);
+
+    /**
+     * @brief Makes Run() return after the current frame (closes the window if there is one).
+     */
+    void Stop();
+
+    bool IsHeadless() const { return mHeadless; }
+
+    /**
+     * @brief Frames run so far.
+     */
+    uint64_t GetFrameCount() const { return mFrameCount; }
+
+    /**
+     * @brief Sets the input of a headless engine (ignored with a window, which polls events).
+     */
+    void SetInputScript(InputScript script) { mInputScript = std::move(script); }
+
+    /**
+     * @brief Reseeds the generator behind every random choice the engine makes.
+     * @details Engines start from a random seed; two runs with the same seed, timestep and
+     * input make the same choices.
+     */
+    void SetRandomSeed(uint32_t seed);
+
+    uint32_t GetRandomSeed() const { return mRandomSeed; }
+
+    /**
+     * @brief Starts writing every frame's delta time and input to a log for StartReplay().
+     * @details Call after setting up the world and the timestep, right before Run(). The
+     * generator is reseeded from its seed, which the log keeps together with the timestep.
+     * The log is complete once the engine is destroyed or StopRecording() is called.
+     * @return false (after printing why) if the log could not be created
+     */
+    bool StartRecording(const std::string& logPath);
+
+    void StopRecording()
+    {
+        if (mRecorder.IsOpen()) {
+            mRecorder.Close();
+        }
+    }
+
+    /**
+     * @brief Drives the following frames from a recorded log instead of the clock and input.
+     * @details Set up the same world as the recorded run, then call this right before Run()
+     * (or RunFrames()), which stops when the log ends. Seed, timestep and steps per frame are
+     * taken from the log, every frame uses its recorded delta time, so the simulation runs
+     * the recorded steps with the recorded input as fast as the machine allows - under the
+     * profiler, this reproduces a captured session's workload.
+     *
+     * Live key presses still reach the InputManager (so the profiler keys work) but not the
+     * InputComponents. The replay is exact with a serial engine (HeadlessOptions with
+     * threadCount 0). With worker threads, entities created by parallel systems can get
+     * other IDs, and streamed chunks can finish loading on other frames; the work is the same.
+     * @return false (after printing why) if the log could not be read
+     */
+    bool StartReplay(const std::string& logPath);
+
+    bool IsReplaying() const { return mReplay.IsOpen(); }
+
+    /**
+     * @brief Saves the simulation between frames: the world, the generator, the partial
+     * fixed step and the timer clocks, for LoadSnapshot().
+     * @details Cheap enough to keep one snapshot per frame for rewinding, or to fork a run
+     * by loading one snapshot into several headless engines. Assets, prefabs, tile layers
+     * and state kept by the game itself (e.g. a LevelStreamer) are not included.
+     */
+    void SaveSnapshot(WorldSnapshot& snapshot) const;
+
+    /**
+     * @brief Restores a snapshot saved by an engine with the same components and setup.
+     * @details Call between frames. The collision broadphase is rebuilt from the restored
+     * bodies, the timer wheels from the restored countdowns. Continuing from the snapshot
+     * with the same input repeats the saved run.
+     * @return false (after printing why) if the snapshot does not fit this engine
+     */
+    bool LoadSnapshot(const WorldSnapshot& snapshot);
+
+    /**
+     * @brief Runs the simulation systems at a fixed rate, decoupled from rendering.
+     * @details Each frame the elapsed time is accumulated and consumed in steps of
+     * 1 / ticksPerSecond. Rendering interpolates entity locations between the last two
+     * steps. If a frame needs more than maxStepsPerFrame steps, the remaining backlog is
+     * dropped so a long hitch slows the game down instead of stalling it.
+     * @param ticksPerSecond Simulation rate, or 0 to step once per frame with the raw delta
+     * @param maxStepsPerFrame Upper bound on catch-up steps per frame (must be > 0)
+     */
+    void SetFixedTimestep(float ticksPerSecond, unsigned int maxStepsPerFrame = 8);
+
     SoundManager& GetSoundManager() { return mSoundManager; }
 
     SpriteManager& GetSpriteManager() { return mSpriteManager; }
 
     WindowManager& GetWindowManager() { return mWindowManager; }
 
+    /**
+     * @brief Key state and key edges of the current frame, decoded by ProcessEvents.
+     */
+    InputManager& GetInputManager() { return mInputManager; }
+
     EntityManager<Components...>& GetEntityManager() { return mEntityManager; }
 
+    CollisionManager& GetCollisionManager() { return mCollisionManager; }
+
+    /**
+     * @brief Wheel running the TimeComponents, for TimeComponent::TimeLeft().
+     */
+    const TimerWheel& GetTimers() const { return mTimers; }
+
+    RenderManager& GetRenderManager() { return mRenderManager; }
+
+    /**
+     * @brief Arena for data that lives as long as the level, such as TileCollisionGrid cells.
+     * @details Allocation is a pointer bump and freeing is a no-op; everything is released
+     * together when the engine is destroyed, after the managers holding level data.
+     */
+    std::pmr::memory_resource& GetLevelArena() { return mLevelArena; }
+
+    /**
+     * @brief Background loader for LoadTextureAsync() and RegisterSoundAsync().
+     * @details Finished loads are uploaded at the start of every frame within
+     * AssetLoader::DEFAULT_BUDGET_MS.
+     */
+    AssetLoader& GetAssetLoader() { return mAssetLoader; }
+
+    /**
+     * @brief Prefabs that SpawnComponents refer to. Register them before calling Run().
+     */
+    PrefabRegistry<Components...>& GetPrefabs() { return mPrefabs; }
+
+    /**
+     * @brief Deferred structural changes, played back at the end of every simulation step.
+     */
+    EntityCommandQueue<Components...>& GetCommandQueue() { return mCommands; }
+
+    ThreadPool& GetThreadPool() { return mThreadPool; }
+
+    Scheduler<Components...>& GetSchedule(Stage stage)
+    {
+        switch (stage) {
+        case Stage::FrameStart:
+            return mFrameStartSchedule;
+        case Stage::Simulation:
+            return mSimulationSchedule;
+        default:
+            return mRenderSchedule;
+        }
+    }
+
 private:
+    static constexpr size_t LEVEL_ARENA_BLOCK_BYTES = 1 << 20; // First block; later ones grow
+
+    void RegisterSystems();
+
+    bool IsRunning() const;
+
+    // Wall clock time since the last frame, one step when headless, or the replay's time;
+    // false once the replay has ended
+    bool NextDeltaTime(sf::Clock& clock, float& deltaTime);
+
+    // Records this frame's input, or replaces it with the replayed frame's
+    void UpdateInputLog(float deltaTime);
+
+    // One frame: frame start, as many simulation steps as deltaTime covers, render
+    void RunFrame(float deltaTime);
+
+    // Remembers where every moving body was before a step, for render interpolation
+    void SavePreviousLocations();
+
+    // First, so it outlives the tile layers and anything else allocated from it
+    std::pmr::monotonic_buffer_resource mLevelArena { LEVEL_ARENA_BLOCK_BYTES };
+
     EntityManager<Components...> mEntityManager;
     SpriteManager mSpriteManager;
     SoundManager mSoundManager;
     WindowManager mWindowManager;
+    InputManager mInputManager;
+    CollisionManager mCollisionManager;
+    TimerWheel mTimers; // TimeComponents
+    TimerWheel mSpawnTimers; // SpawnComponents, SpawnSystem's own
+    RenderManager mRenderManager;
+    PrefabRegistry<Components...> mPrefabs;
+    EntityCommandQueue<Components...> mCommands;
+    AssetLoader mAssetLoader; // After the managers its jobs write to, so it is destroyed first
+
+    ThreadPool mThreadPool;
+    ThreadPool* mPool; // &mThreadPool, or nullptr to run every system inline
+    Scheduler<Components...> mFrameStartSchedule;
+    Scheduler<Components...> mSimulationSchedule;
+    Scheduler<Components...> mRenderSchedule;
+
+#ifdef ECS_ENABLE_PROFILER
+    ProfilerOverlay mProfilerOverlay;
+#endif
+
+    float mAlpha = 1.0f; // Render interpolation factor for the current frame
+    float mFixedTimestep = 0.0f; // Seconds per step, 0 = variable timestep
+    float mAccumulator = 0.0f; // Unsimulated time carried to the next frame
+    unsigned int mMaxStepsPerFrame = 8;
+
+    bool mHeadless = false;
+    bool mStopRequested = false;
+    uint64_t mFrameCount = 0;
+    InputScript mInputScript;
+
+    std::mt19937 mRandom;
+    uint32_t mRandomSeed = 0;
+    InputRecorder mRecorder;
+    InputReplay mReplay;
+    InputLogFrame mReplayFrame;
+    InputManager mReplayInput; // Keys of the replayed frames, published instead of live ones
 };
 
 template <typename... Components>
 ECSEngine<Components...>::ECSEngine(
     unsigned int width, unsigned int height, const std::string& name)
     : mWindowManager(width, height, name)
+    , mPool(&mThreadPool)
+    , mFrameStartSchedule(mPool)
+    , mSimulationSchedule(mPool)
+    , mRenderSchedule(mPool)
 {
+    SetRandomSeed(std::random_device {}());
+    RegisterSystems();
+}
+
+template <typename... Components>
+ECSEngine<Components...>::ECSEngine(const HeadlessOptions& options)
+    : mWindowManager(options.viewWidth, options.viewHeight)
+    , mThreadPool(options.threadCount)
+    , mPool(options.threadCount > 0 ? &mThreadPool : nullptr)
+    , mFrameStartSchedule(mPool)
+    , mSimulationSchedule(mPool)
+    , mRenderSchedule(mPool)
+    , mHeadless(true)
+{
+    mSpriteManager.SetHeadless(true);
+    mSoundManager.SetHeadless(true);
+    SetRandomSeed(std::random_device {}());
+    RegisterSystems();
+}
+
+template <typename... Components> void ECSEngine<Components...>::RegisterSystems()
+{
+    // Order of registration is the order of execution wherever two systems conflict
+
+    if (mHeadless) {
+        mFrameStartSchedule.template AddSystem<Reads<>, Writes<InputComponent, InputManager>>(
+            "InputScript", [this](float) {
+                mInputManager.BeginFrame();
+                if (mInputScript) {
+                    mInputScript(mInputManager, mFrameCount);
+                }
+                PublishInput(mEntityManager, mInputManager);
+            });
+    } else {
+        // SFML only delivers window events to the thread that created the window
+        mFrameStartSchedule.template AddSystem<Reads<>,
+            Writes<InputComponent, InputManager, WindowManager>>("ProcessEvents",
+            [this](float) { ProcessEvents(mEntityManager, mWindowManager, mInputManager); },
+            true);
+    }
+
+    // Sees exactly what the InputComponents got from the system above, or overrides it
+    mFrameStartSchedule.template AddSystem<Reads<InputManager>,
+        Writes<InputComponent, WindowManager>>(
+        "InputLog", [this](float dt) { UpdateInputLog(dt); }, true);
+
+    // Textures upload through the window's GL context, so this stays on the main thread too
+    mFrameStartSchedule.template AddSystem<Reads<>, Writes<SpriteManager, SoundManager>>(
+        "AssetUploads", [this](float) { mAssetLoader.Update(); }, true);
+
+    mSimulationSchedule.template AddSystem<Reads<MovementComponent>, Writes<LocationComponent>>(
+        "SavePreviousLocations", [this](float) { SavePreviousLocations(); });
+
+    mSimulationSchedule
+        .template AddSystem<Reads<LocationComponent>, Writes<CollisionComponent, CollisionManager>>(
+            "CollisionSystemUpdate",
+            [this](float) { CollisionSystemUpdate(mEntityManager, mCollisionManager, mPool); });
+
+    mSimulationSchedule.template AddSystem<Reads<InputComponent, AccelerationComponent>,
+        Writes<MovementComponent, CollisionComponent, SoundManager>>("InputSystem",
+        [this, jump = INVALID_SOUND](float dt) mutable {
+            // Resolved once, the first frame the game has registered it
+            if (jump == INVALID_SOUND) {
+                jump = mSoundManager.FindSound("jump");
+            }
+            InputSystem(mEntityManager, mSoundManager, jump, dt);
+        });
+
+    mSimulationSchedule
+        .template AddSystem<Reads<CollisionComponent, InputComponent>, Writes<MovementComponent>>(
+            "GravitySystem", [this](float dt) { GravitySystem(mEntityManager, dt, mPool); });
+
+    mSimulationSchedule.template AddSystem<Reads<MovementComponent>, Writes<LocationComponent>>(
+        "MovementSystem", [this](float dt) { MovementSystem(mEntityManager, dt, mPool); });
+
+    mSimulationSchedule.template AddSystem<Reads<>,
+        Writes<CollisionComponent, LocationComponent, MovementComponent, CollisionManager>>(
+        "CollisionSystem", [this](float) { CollisionSystem(mEntityManager, mCollisionManager); });
+
+    // Gameplay reactions to the contacts found above
+    mSimulationSchedule.template AddSystem<Reads<InputComponent, StarTag, CollisionManager>,
+        Writes<ScoreComponent, SpriteComponent, SoundManager>>("PickupSystem",
+        [this, sparkle = INVALID_SOUND](float) mutable {
+            if (sparkle == INVALID_SOUND) {
+                sparkle = mSoundManager.FindSound("sparkle");
+            }
+            PickupSystem(
+                mEntityManager, mSoundManager, sparkle, mCollisionManager, mCommands.Local());
+        });
+
+    mSimulationSchedule.template AddSystem<Reads<InputComponent, MainCameraTag, CollisionManager>,
+        Writes<CollisionComponent, MovementComponent, CameraShake>>("PlayerContactSystem",
+        [this](float) { PlayerContactSystem(mEntityManager, mCollisionManager); });
+
+    // Opt-in: only games whose components include the Sleeping tag get sleeping bodies
+    if constexpr (Pack<Components...>::template contains<Sleeping>) {
+        mSimulationSchedule.template AddSystem<Reads<>,
+            Writes<CollisionComponent, MovementComponent, LocationComponent, CollisionManager>>(
+            "SleepSystem",
+            [this](float) { SleepSystem(mEntityManager, mCollisionManager, mCommands.Local()); });
+    }
+
+    mSimulationSchedule.template AddSystem<Reads<ScoreComponent>, Writes<SpriteComponent>>(
+        "ScoreSystem", [this](float) { ScoreSystem(mEntityManager); });
+
+    // Update timers before systems that check them. mTimers is only used along with
+    // TimeComponent, so declaring that covers it
+    mSimulationSchedule.template AddSystem<Reads<>, Writes<TimeComponent>>(
+        "TimeSystem", [this](float dt) { TimeSystem(mEntityManager, mTimers, dt); });
+
+    // Structural changes are only recorded, so spawning doesn't block the other systems.
+    // The only user of mRandom, so its draws keep their order whatever runs in parallel.
+    // mSpawnTimers is only used here
+    mSimulationSchedule.template AddSystem<Reads<LocationComponent>, Writes<SpawnComponent>>(
+        "SpawnSystem", [this](float dt) {
+            SpawnSystem(mEntityManager, mPrefabs, mCommands.Local(), mRandom, mSpawnTimers, dt);
+        });
+
+    // Sync point: writing the entity structure orders this after every other system
+    mSimulationSchedule.template AddSystem<Reads<>, Writes<EntityStructure>>(
+        "PlaybackCommands", [this](float) { mCommands.Playback(mEntityManager); });
+
+    // Camera and streaming still follow the player without a window
+    if (mHeadless) {
+        mRenderSchedule.template AddSystem<Reads<CameraFollower, LocationComponent>,
+            Writes<CameraComponent, CameraShake, TimeComponent, WindowManager>>("CameraSystem",
+            [this](float dt) {
+                CameraSystem(mEntityManager, mWindowManager, mTimers, dt, mAlpha);
+            });
+        return;
+    }
+
+    // Sounds queued by this frame's steps start together
+    mRenderSchedule.template AddSystem<Reads<>, Writes<SoundManager>>(
+        "FlushSounds", [this](float) { mSoundManager.Flush(); });
+
+    // Present at the display rate
+    mRenderSchedule.template AddSystem<Reads<CameraFollower, LocationComponent>,
+        Writes<CameraComponent, CameraShake, TimeComponent, WindowManager>>(
+        "CameraSystem",
+        [this](float dt) { CameraSystem(mEntityManager, mWindowManager, mTimers, dt, mAlpha); },
+        true);
+
+    mRenderSchedule.template AddSystem<Reads<SpriteComponent, LocationComponent, SpriteManager>,
+        Writes<RenderManager, WindowManager>>(
+        "SpriteSystem",
+        [this](float) {
+            SpriteSystem(mEntityManager, mSpriteManager, mWindowManager, mRenderManager, mAlpha);
+        },
+        true);
+
+#ifdef ECS_ENABLE_PROFILER
+    // F3 toggles the timing overlay, F4 starts and stops a Chrome trace
+    mRenderSchedule.template AddSystem<Reads<InputManager>, Writes<WindowManager>>(
+        "ProfilerOverlay",
+        [this](float) {
+            ProfilerOverlaySystem(
+                mWindowManager, mInputManager, Profiler::Get(), mProfilerOverlay);
+        },
+        true);
+#endif
+
+    // Let'er rip, bud~!
+    mRenderSchedule.template AddSystem<Reads<>, Writes<WindowManager>>(
+        "Present", [this](float) { mWindowManager.GetWindow()->display(); }, true);
+}
+
+template <typename... Components>
+void ECSEngine<Components...>::SetFixedTimestep(float ticksPerSecond, unsigned int maxStepsPerFrame)
+{
+    assert(ticksPerSecond >= 0.0f && "Tick rate must not be negative!");
+    assert(maxStepsPerFrame > 0 && "Need at least one step per frame!");
+
+    mFixedTimestep = ticksPerSecond > 0.0f ? 1.0f / ticksPerSecond : 0.0f;
+    mMaxStepsPerFrame = maxStepsPerFrame;
 }
 
 template <typename... Components> void ECSEngine<Components...>::Run()
 {
     // Delta time tracking
     sf::Clock clock;
+    mStopRequested = false;
+
+    // Main game loop - while window is still open (or until Stop() when headless)
     float deltaTime = 0.0f;
+    while (IsRunning() && NextDeltaTime(clock, deltaTime)) {
+        RunFrame(deltaTime);
+    }
+}
+
+template <typename... Components> void ECSEngine<Components...>::RunFrames(uint64_t frameCount)
+{
+    sf::Clock clock;
+    float deltaTime = 0.0f;
+    for (uint64_t frame = 0; frame < frameCount && NextDeltaTime(clock, deltaTime); ++frame) {
+        RunFrame(deltaTime);
+    }
+}
+
+template <typename... Components> void ECSEngine<Components...>::Stop()
+{
+    mStopRequested = true;
+    if (!mHeadless) {
+        mWindowManager.GetWindow()->close();
+    }
+}
+
+template <typename... Components> bool ECSEngine<Components...>::IsRunning() const
+{
+    return !mStopRequested && (mHeadless || mWindowManager.GetWindow()->isOpen());
+}
+
+template <typename... Components>
+bool ECSEngine<Components...>::NextDeltaTime(sf::Clock& clock, float& deltaTime)
+{
+    if (mReplay.IsOpen()) {
+        if (!mReplay.Read(mReplayFrame)) {
+            mReplay.Close();
+            Stop();
+            return false;
+        }
+        deltaTime = mReplayFrame.deltaTime;
+        return true;
+    }
 
-    // Main game loop - while window is still open
-    while (mWindowManager.GetWindow()->isOpen()) {
-        // Calculate delta time
+    // Headless frames advance by exactly one step however long they took, so runs repeat
+    if (mHeadless) {
+        deltaTime = mFixedTimestep > 0.0f ? mFixedTimestep : HEADLESS_FRAME_SECONDS;
+    } else {
         deltaTime = clock.restart().asSeconds();
+    }
+    return true;
+}
+
+template <typename... Components> void ECSEngine<Components...>::SetRandomSeed(uint32_t seed)
+{
+    mRandomSeed = seed;
+    mRandom.seed(seed);
+}
+
+template <typename... Components>
+bool ECSEngine<Components...>::StartRecording(const std::string& logPath)
+{
+    assert(!mReplay.IsOpen() && "Cannot record while replaying!");
+
+    if (!mRecorder.Open(logPath, { mRandomSeed, mFixedTimestep, mMaxStepsPerFrame })) {
+        return false;
+    }
 
-        // Run all systems in order
-        ProcessEvents(mEntityManager, mWindowManager);
-        CollisionSystemUpdate(mEntityManager);
-        InputSystem(mEntityManager, mSoundManager, deltaTime);
-        GravitySystem(mEntityManager, deltaTime);
-        MovementSystem(mEntityManager, deltaTime);
-        CollisionSystem(mEntityManager, mSoundManager);
-        ScoreSystem(mEntityManager);
-        TimeSystem(mEntityManager, deltaTime); // Update timers before systems that check them
-        CameraSystem(mEntityManager, mWindowManager, deltaTime);
-        SpriteSystem(mEntityManager, mSpriteManager, mWindowManager);
-        SpawnSystem(mEntityManager, mSpriteManager, deltaTime);
+    // Start from the state a replay starts from
+    SetRandomSeed(mRandomSeed);
+    mAccumulator = 0.0f;
+    return true;
+}
+
+template <typename... Components>
+bool ECSEngine<Components...>::StartReplay(const std::string& logPath)
+{
+    assert(!mRecorder.IsOpen() && "Cannot replay while recording!");
+
+    if (!mReplay.Open(logPath)) {
+        return false;
+    }
+
+    const InputLogSettings& settings = mReplay.GetSettings();
+    SetRandomSeed(settings.randomSeed);
+    mFixedTimestep = settings.fixedTimestep;
+    mMaxStepsPerFrame = settings.maxStepsPerFrame;
+    mAccumulator = 0.0f;
+    mReplayInput = InputManager();
+    return true;
+}
+
+template <typename... Components>
+void ECSEngine<Components...>::SaveSnapshot(WorldSnapshot& snapshot) const
+{
+    static_assert(std::is_trivially_copyable_v<std::mt19937>);
+
+    SnapshotWriter writer(snapshot.bytes);
+    mEntityManager.SaveSnapshot(writer);
+    writer.WriteValue(mRandom);
+    writer.WriteValue(mAccumulator);
+    writer.WriteValue(mCollisionManager.GetLocationTick());
+    writer.WriteValue(mCollisionManager.GetPreviousBoxTick());
+    mTimers.Save(writer);
+    mSpawnTimers.Save(writer);
+}
+
+template <typename... Components>
+bool ECSEngine<Components...>::LoadSnapshot(const WorldSnapshot& snapshot)
+{
+    SnapshotReader reader(snapshot.bytes);
+    uint32_t locationTick = 0;
+    uint32_t previousBoxTick = 0;
+    if (!mEntityManager.LoadSnapshot(reader) || !reader.ReadValue(mRandom)
+        || !reader.ReadValue(mAccumulator) || !reader.ReadValue(locationTick)
+        || !reader.ReadValue(previousBoxTick)
+        || !mTimers.Load(reader) || !mSpawnTimers.Load(reader)) {
+        return false;
+    }
+
+    // Only the clocks are saved; the countdowns come back from their components
+    for (auto [id, timer] : mEntityManager.template View<TimeComponent>()) {
+        if (timer.isRunning && timer.expiryTick != 0) {
+            mTimers.Schedule(id, timer.expiryTick);
+        }
+    }
+    for (auto [id, spawn] : mEntityManager.template View<SpawnComponent>()) {
+        if (spawn.nextSpawnTick != 0) {
+            mSpawnTimers.Schedule(id, spawn.nextSpawnTick);
+        }
+    }
+
+    // Statics first: with nothing asleep yet, inserting them records no geometry changes
+    mCollisionManager.ClearBodies();
+    mCollisionManager.SetLocationTick(locationTick);
+    mCollisionManager.SetPreviousBoxTick(previousBoxTick);
+    for (auto [id, collision] : mEntityManager.template View<CollisionComponent>()) {
+        if (collision.isStatic && collision.boundingBoxInitialized) {
+            mCollisionManager.InsertStatic(id, collision.currentBoundingBox);
+        }
+    }
+    if constexpr (Pack<Components...>::template contains<Sleeping>) {
+        for (auto [id, collision, sleeping] :
+            mEntityManager.template View<CollisionComponent, Sleeping>()) {
+            mCollisionManager.InsertSleeping(id, collision.currentBoundingBox);
+        }
+    }
+    return true;
+}
+
+template <typename... Components> void ECSEngine<Components...>::UpdateInputLog(float deltaTime)
+{
+    if (mRecorder.IsOpen()) {
+        mRecorder.Record(deltaTime, mInputManager);
+    }
+
+    if (mReplay.IsOpen()) {
+        mReplayInput.BeginFrame();
+        mReplayFrame.Apply(mReplayInput);
+        for (const sf::Vector2u& size : mReplayFrame.resizes) {
+            mWindowManager.SetWindowSize(size.x, size.y);
+        }
+        PublishInput(mEntityManager, mReplayInput);
+    }
+}
+
+template <typename... Components> void ECSEngine<Components...>::RunFrame(float deltaTime)
+{
+    // Last frame's scopes have all closed
+    ECS_PROFILE_END_FRAME();
+    ECS_PROFILE_SCOPE("Frame");
+
+    {
+        ECS_PROFILE_SCOPE("FrameStart");
+        mFrameStartSchedule.Run(deltaTime);
+    }
+
+    // Advance the simulation
+    mAlpha = 1.0f;
+
+    if (mFixedTimestep > 0.0f) {
+        mAccumulator += deltaTime;
+
+        unsigned int steps = 0;
+        while (mAccumulator >= mFixedTimestep && steps < mMaxStepsPerFrame) {
+            ECS_PROFILE_SCOPE("Simulation");
+            mSimulationSchedule.Run(mFixedTimestep);
+            mAccumulator -= mFixedTimestep;
+            ++steps;
+        }
+
+        // Too far behind to catch up: drop whole steps, keep the phase
+        if (mAccumulator >= mFixedTimestep) {
+            mAccumulator = std::fmod(mAccumulator, mFixedTimestep);
+        }
+
+        mAlpha = mAccumulator / mFixedTimestep;
+    } else {
+        ECS_PROFILE_SCOPE("Simulation");
+        mSimulationSchedule.Run(deltaTime);
+    }
+
+    {
+        ECS_PROFILE_SCOPE("Render");
+        mRenderSchedule.Run(deltaTime);
+    }
+
+    ++mFrameCount;
+}
+
+template <typename... Components> void ECSEngine<Components...>::SavePreviousLocations()
+{
+    // Everything else stays put, so its previousPosition already equals its position (bodies
+    // falling asleep are brought level by SleepSystem)
+    for (auto [id, location, movement] :
+        mEntityManager.template View<LocationComponent, MovementComponent>(Exclude<Sleeping> {})) {
+        location.previousPosition = location.position;
+    }
+}
+
+/**
+ * @brief Runs worldCount independent jobs in parallel, one per thread, typically each
+ * building and stepping its own headless engine.
+ * @details Worlds are handed out as threads free up, so uneven worlds still keep every
+ * thread busy. Returns once all of them have finished.
+ * @param runWorld Called once per world index in [0, worldCount), from any thread
+ * @param threadCount Threads to use besides the calling one (which helps too)
+ */
+template <typename Fn>
+void RunWorlds(
+    size_t worldCount, Fn&& runWorld, size_t threadCount = ThreadPool::DefaultThreadCount())
+{
+    ThreadPool pool(threadCount);
+    for (size_t world = 0; world < worldCount; ++world) {
+        pool.Submit([&runWorld, world] { runWorld(world); });
     }
+    pool.Wait();
 }
 
 } // namespace ECSEngine
@@ -0,0 +1,39 @@
+/**
+ * @file EntityID.h
+ * @brief Generational entity handles shared by the managers, components and systems.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <limits>
+
+namespace ECSEngine {
+
+/**
+ * @brief Handle to an entity: a 32-bit slot index in the low half and a 32-bit generation
+ * in the high half.
+ * @details The manager bumps a slot's generation every time the entity in it is removed,
+ * so a handle kept after its entity died never matches the slot's new occupant. Checking a
+ * handle is one compare against the handle stored in the slot (see ValidEntity()).
+ * Every index, including 0, is a real entity; use INVALID_ENTITY for "no entity".
+ */
+using EntityID = uint64_t;
+
+constexpr EntityID MakeEntityID(uint32_t index, uint32_t generation)
+{
+    return (static_cast<EntityID>(generation) << 32) | index;
+}
+
+// Slot in the entity tables and component owner lists
+constexpr uint32_t EntityIndex(EntityID entity) { return static_cast<uint32_t>(entity); }
+
+constexpr uint32_t EntityGeneration(EntityID entity)
+{
+    return static_cast<uint32_t>(entity >> 32);
+}
+
+// Never returned by CreateEntity(); its index is past any table the manager can grow
+inline constexpr EntityID INVALID_ENTITY = std::numeric_limits<EntityID>::max();
+
+} // namespace ECSEngine
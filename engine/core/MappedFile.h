@@ -0,0 +1,90 @@
+/**
+ * @file MappedFile.h
+ * @brief Read-only memory mapping of a whole file.
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+#ifdef _WIN32
+#include <fstream>
+#include <iterator>
+#include <vector>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace ECSEngine {
+
+/**
+ * @class MappedFile
+ * @brief Read-only view of a whole file, memory mapped where the platform allows.
+ * @details Pages are faulted in on first touch, so a compiled map or cached asset is usable
+ * as soon as the mapping exists. On Windows the file is read into memory instead.
+ */
+class MappedFile {
+public:
+    explicit MappedFile(const std::string& path)
+    {
+#ifdef _WIN32
+        std::ifstream file(path, std::ios::binary);
+        if (file.is_open()) {
+            mBuffer.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+            mData = reinterpret_cast<const uint8_t*>(mBuffer.data());
+            mSize = mBuffer.size();
+            mOpen = true;
+        }
+#else
+        const int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) {
+            return;
+        }
+
+        struct stat info;
+        if (::fstat(fd, &info) == 0 && info.st_size > 0) {
+            void* mapping = ::mmap(nullptr, static_cast<size_t>(info.st_size), PROT_READ,
+                MAP_PRIVATE, fd, 0);
+            if (mapping != MAP_FAILED) {
+                mData = static_cast<const uint8_t*>(mapping);
+                mSize = static_cast<size_t>(info.st_size);
+                mOpen = true;
+            }
+        }
+
+        // The mapping stays valid after the descriptor is closed
+        ::close(fd);
+#endif
+    }
+
+    ~MappedFile()
+    {
+#ifndef _WIN32
+        if (mData) {
+            ::munmap(const_cast<uint8_t*>(mData), mSize);
+        }
+#endif
+    }
+
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    bool IsOpen() const { return mOpen; }
+    const uint8_t* Data() const { return mData; }
+    size_t Size() const { return mSize; }
+
+private:
+    const uint8_t* mData = nullptr;
+    size_t mSize = 0;
+    bool mOpen = false;
+#ifdef _WIN32
+    std::vector<char> mBuffer;
+#endif
+};
+
+} // namespace ECSEngine
@@ -0,0 +1,123 @@
+/**
+ * @file NameTable.h
+ * @brief String interning: each distinct name is stored once and referred to by a NameID.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+
+#include "Snapshot.h"
+
+namespace ECSEngine {
+
+// Index of an interned name; compare these instead of strings
+using NameID = uint32_t;
+
+/**
+ * @class NameTable
+ * @brief Maps names to compact NameIDs and back.
+ * @details Interning the same string twice yields the same NameID, so name checks are
+ * integer compares and entities sharing a name share one allocation. Names are only
+ * removed by Load(). NameID 0 is always the empty name.
+ *
+ * RESOURCE LIFETIME:
+ * - References from GetName() are valid for the lifetime of the table, unless a Load()
+ *   drops the name.
+ */
+class NameTable {
+public:
+    static constexpr NameID EMPTY_NAME = 0;
+    static constexpr NameID INVALID_NAME = std::numeric_limits<NameID>::max();
+
+    NameTable() { Intern(""); }
+
+    /**
+     * @brief Returns the NameID for a name, adding it on first use.
+     */
+    NameID Intern(std::string_view name)
+    {
+        auto it = mLookup.find(name);
+        if (it != mLookup.end()) {
+            return it->second;
+        }
+
+        const NameID id = static_cast<NameID>(mNames.size());
+        // Keys view the stored strings, which a deque never moves
+        const std::string& stored = mNames.emplace_back(name);
+        mLookup.emplace(stored, id);
+        return id;
+    }
+
+    /**
+     * @brief Returns the NameID for a name, or INVALID_NAME if it was never interned.
+     */
+    NameID Find(std::string_view name) const
+    {
+        auto it = mLookup.find(name);
+        return it != mLookup.end() ? it->second : INVALID_NAME;
+    }
+
+    const std::string& GetName(NameID id) const
+    {
+        assert(id < mNames.size() && "Unknown NameID!");
+        return mNames[id];
+    }
+
+    size_t Size() const { return mNames.size(); }
+
+    // Every name in NameID order, for Load()
+    void Save(SnapshotWriter& writer) const
+    {
+        writer.WriteValue(static_cast<uint64_t>(mNames.size()));
+        for (const std::string& name : mNames) {
+            writer.WriteString(name);
+        }
+    }
+
+    /**
+     * @brief Restores a saved table so every saved NameID means the same name again.
+     * @details Names the table already holds under the same IDs are kept, so rewinding a
+     * world only compares strings. Names interned after the save stay as well; from the
+     * first ID that names something else, the table is replaced by the saved names.
+     */
+    bool Load(SnapshotReader& reader)
+    {
+        uint64_t count = 0;
+        if (!reader.ReadValue(count)) {
+            return false;
+        }
+
+        std::string name;
+        for (uint64_t id = 0; id < count; ++id) {
+            if (!reader.ReadString(name)) {
+                return false;
+            }
+            if (id < mNames.size() && mNames[id] == name) {
+                continue;
+            }
+
+            // Diverged: drop this ID and everything after it (a deque keeps the rest in place)
+            while (mNames.size() > id) {
+                mLookup.erase(mNames.back());
+                mNames.pop_back();
+            }
+
+            [[maybe_unused]] const NameID interned = Intern(name);
+            assert(interned == id && "Snapshot names must be unique!");
+        }
+        return true;
+    }
+
+private:
+    std::deque<std::string> mNames; // [NameID]
+    std::unordered_map<std::string_view, NameID> mLookup;
+};
+
+} // namespace ECSEngine
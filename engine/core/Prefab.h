@@ -0,0 +1,104 @@
+/**
+ * @file Prefab.h
+ * @brief Prebuilt component bundles that entities are instantiated from.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <deque>
+#include <limits>
+#include <optional>
+#include <tuple>
+
+#include "NameTable.h"
+#include "pack.h"
+
+namespace ECSEngine {
+
+// Index of a prefab in a PrefabRegistry
+using PrefabID = uint32_t;
+inline constexpr PrefabID INVALID_PREFAB = std::numeric_limits<PrefabID>::max();
+
+/**
+ * @class Prefab
+ * @brief A name plus at most one component of each type, copied onto every instance.
+ * @details Build one at setup, with everything that is the same for every instance (sprite,
+ * collision box, tags), and instantiate it through EntityManager::Instantiate() or
+ * EntityCommandBuffer::Instantiate(). Per-instance data such as the location is added to
+ * the new entity afterwards.
+ *
+ * @tparam Components The component types in the EntityManager
+ */
+template <typename... Components> class Prefab {
+public:
+    explicit Prefab(NameID name = NameTable::EMPTY_NAME)
+        : mName(name)
+    {
+    }
+
+    /**
+     * @brief Sets the prefab's component of type T, replacing any previous one.
+     * @return *this, so a prefab can be built in one expression
+     */
+    template <typename T> Prefab& Set(T component)
+    {
+        static_assert(Pack<Components...>::template contains<T>, "Unknown component type!");
+        std::get<std::optional<T>>(mComponents) = std::move(component);
+        return *this;
+    }
+
+    template <typename T> bool Has() const
+    {
+        return std::get<std::optional<T>>(mComponents).has_value();
+    }
+
+    template <typename T> const T& Get() const
+    {
+        assert(Has<T>() && "Prefab has no such component!");
+        return *std::get<std::optional<T>>(mComponents);
+    }
+
+    NameID GetName() const { return mName; }
+
+private:
+    NameID mName;
+    std::tuple<std::optional<Components>...> mComponents;
+};
+
+/**
+ * @class PrefabRegistry
+ * @brief Owns the prefabs and hands out PrefabIDs for components to refer to.
+ * @details Prefabs are never removed.
+ *
+ * RESOURCE LIFETIME:
+ * - References from Get() stay valid for the lifetime of the registry, so command buffers
+ *   can hold on to them until playback.
+ *
+ * @tparam Components The component types in the EntityManager
+ */
+template <typename... Components> class PrefabRegistry {
+public:
+    using PrefabType = Prefab<Components...>;
+
+    PrefabID Register(PrefabType prefab)
+    {
+        assert(mPrefabs.size() < INVALID_PREFAB && "Out of prefab IDs!");
+        mPrefabs.push_back(std::move(prefab));
+        return static_cast<PrefabID>(mPrefabs.size() - 1);
+    }
+
+    const PrefabType& Get(PrefabID id) const
+    {
+        assert(id < mPrefabs.size() && "Unknown PrefabID!");
+        return mPrefabs[id];
+    }
+
+    size_t Size() const { return mPrefabs.size(); }
+
+private:
+    std::deque<PrefabType> mPrefabs; // [PrefabID], a deque never moves its elements
+};
+
+} // namespace ECSEngine
@@ -0,0 +1,326 @@
+/**
+ * @file Profiler.h
+ * @brief Scoped frame profiler: per-system timings, live statistics and Chrome trace export.
+ * @details Everything here is compiled only with ECS_ENABLE_PROFILER defined (the CMake option
+ * of the same name). Without it the ECS_PROFILE_ macros expand to nothing and the engine
+ * contains no profiling code at all.
+ */
+
+#pragma once
+
+#ifdef ECS_ENABLE_PROFILER
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+namespace ECSEngine {
+
+/**
+ * @class Profiler
+ * @brief Collects timed scopes from any thread and keeps per-name statistics.
+ * @details ProfileScope records one event (name, thread, start, duration) when it closes.
+ * Recording is lock free: a thread claims a slot of a fixed ring buffer with one atomic
+ * increment, fills it, and publishes it through the slot's sequence number.
+ *
+ * EndFrame(), called once per frame by ECSEngine::Run() between frames, drains the ring.
+ * Each name's time is summed over the frame and kept for the last HISTORY_FRAMES frames it
+ * ran in, from which GetStats() reports min, average and 99th percentile. While a capture
+ * is running the drained events are also kept, and StopCapture() writes them as a Chrome
+ * trace (chrome://tracing, Perfetto).
+ *
+ * RESOURCE LIFETIME:
+ * - Scope names are stored as pointers, so they must outlive the profiler: string literals,
+ *   or strings returned by Intern().
+ *
+ * - A frame producing more than RING_CAPACITY events loses the oldest ones (counted by
+ *   GetDroppedCount()).
+ */
+class Profiler {
+public:
+    static constexpr size_t RING_CAPACITY = 1 << 14; // Events per frame at most
+    static constexpr size_t HISTORY_FRAMES = 240;
+    static constexpr size_t MAX_CAPTURE_EVENTS = 1 << 21;
+
+    struct Event {
+        const char* name;
+        uint32_t thread; // Small per-thread number, in order of first use
+        int64_t startNs; // Since the profiler was created
+        int64_t durationNs;
+    };
+
+    struct Stats {
+        std::string_view name;
+        float minMs;
+        float avgMs;
+        float p99Ms;
+    };
+
+    /**
+     * @brief The process-wide profiler that ECS_PROFILE_SCOPE records into.
+     */
+    static Profiler& Get()
+    {
+        static Profiler profiler;
+        return profiler;
+    }
+
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    /**
+     * @brief Returns a copy of name that lives as long as the profiler, for dynamic names.
+     */
+    const char* Intern(std::string_view name)
+    {
+        std::lock_guard lock(mInternMutex);
+        for (const std::unique_ptr<std::string>& interned : mInterned) {
+            if (*interned == name) {
+                return interned->c_str();
+            }
+        }
+        mInterned.push_back(std::make_unique<std::string>(name));
+        return mInterned.back()->c_str();
+    }
+
+    int64_t Now() const
+    {
+        const auto elapsed = Clock::now() - mEpoch;
+        return std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count();
+    }
+
+    /**
+     * @brief Records one finished scope. Safe to call from any thread.
+     */
+    void Record(const char* name, int64_t startNs, int64_t endNs)
+    {
+        const uint64_t index = mHead.fetch_add(1, std::memory_order_relaxed);
+        Slot& slot = mRing[index & (RING_CAPACITY - 1)];
+        slot.event = Event { name, ThreadNumber(), startNs, endNs - startNs };
+        slot.sequence.store(index + 1, std::memory_order_release);
+    }
+
+    /**
+     * @brief Drains the events recorded since the last call and updates the statistics.
+     * @details Call from one thread while no scope is being recorded (between frames).
+     */
+    void EndFrame()
+    {
+        const uint64_t head = mHead.load(std::memory_order_acquire);
+        if (head - mTail > RING_CAPACITY) {
+            mDropped += head - mTail - RING_CAPACITY;
+            mTail = head - RING_CAPACITY;
+        }
+
+        for (; mTail < head; ++mTail) {
+            const Slot& slot = mRing[mTail & (RING_CAPACITY - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != mTail + 1) {
+                break; // Claimed but not filled yet; picked up next frame
+            }
+
+            const Event& event = slot.event;
+            History& history = HistoryOf(event.name);
+            history.frameNs += event.durationNs;
+            history.ranThisFrame = true;
+
+            if (mCapturing && mCapture.size() < MAX_CAPTURE_EVENTS) {
+                mCapture.push_back(event);
+            }
+        }
+
+        for (History& history : mHistories) {
+            if (!history.ranThisFrame) {
+                continue;
+            }
+            history.samples[history.next] = static_cast<float>(history.frameNs) * 1e-6f;
+            history.next = (history.next + 1) % HISTORY_FRAMES;
+            history.count = std::min(history.count + 1, HISTORY_FRAMES);
+            history.frameNs = 0;
+            history.ranThisFrame = false;
+        }
+    }
+
+    /**
+     * @brief Per-frame milliseconds of every recorded name, in order of first appearance.
+     */
+    std::vector<Stats> GetStats() const
+    {
+        std::vector<Stats> stats;
+        std::vector<float> sorted;
+
+        for (const History& history : mHistories) {
+            if (history.count == 0) {
+                continue;
+            }
+
+            sorted.assign(history.samples.begin(), history.samples.begin() + history.count);
+            std::sort(sorted.begin(), sorted.end());
+
+            float sum = 0.0f;
+            for (float sample : sorted) {
+                sum += sample;
+            }
+
+            const size_t p99 = std::min(sorted.size() - 1, sorted.size() * 99 / 100);
+            stats.push_back(Stats { history.name, sorted.front(),
+                sum / static_cast<float>(sorted.size()), sorted[p99] });
+        }
+
+        return stats;
+    }
+
+    size_t GetDroppedCount() const { return mDropped; }
+
+    /**
+     * @brief Starts keeping every drained event for StopCapture().
+     */
+    void StartCapture()
+    {
+        mCapture.clear();
+        mCapturing = true;
+    }
+
+    bool IsCapturing() const { return mCapturing; }
+
+    /**
+     * @brief Ends a capture and writes it in the Chrome trace event format.
+     * @return false (after printing why) if the file could not be written
+     */
+    bool StopCapture(const std::string& tracePath)
+    {
+        mCapturing = false;
+
+        std::ofstream file(tracePath, std::ios::trunc);
+        if (!file.is_open()) {
+            std::cerr << "Error: Could not write trace: " << tracePath << std::endl;
+            return false;
+        }
+
+        // Complete ("X") events; timestamps are microseconds
+        file << std::fixed << std::setprecision(3) << "{\"traceEvents\":[\n";
+        for (size_t i = 0; i < mCapture.size(); ++i) {
+            const Event& event = mCapture[i];
+            file << (i ? ",\n" : "") << "{\"name\":\"";
+            for (const char* c = event.name; *c; ++c) {
+                if (*c == '"' || *c == '\\') {
+                    file << '\\';
+                }
+                file << *c;
+            }
+            file << "\",\"ph\":\"X\",\"pid\":1,\"tid\":" << event.thread
+                 << ",\"ts\":" << static_cast<double>(event.startNs) * 1e-3
+                 << ",\"dur\":" << static_cast<double>(event.durationNs) * 1e-3 << "}";
+        }
+        file << "\n]}\n";
+
+        mCapture.clear();
+        return static_cast<bool>(file);
+    }
+
+private:
+    using Clock = std::chrono::steady_clock;
+
+    struct Slot {
+        std::atomic<uint64_t> sequence { 0 }; // Index + 1 of the event stored here
+        Event event;
+    };
+
+    struct History {
+        std::string_view name;
+        std::array<float, HISTORY_FRAMES> samples {}; // Ring of per-frame milliseconds
+        size_t next = 0;
+        size_t count = 0;
+        int64_t frameNs = 0; // Summed over the frame being drained
+        bool ranThisFrame = false;
+    };
+
+    Profiler()
+        : mEpoch(Clock::now())
+    {
+    }
+
+    uint32_t ThreadNumber()
+    {
+        thread_local uint32_t number = mThreadCount.fetch_add(1, std::memory_order_relaxed);
+        return number;
+    }
+
+    // Same text from different pointers (one literal per translation unit) shares a history
+    History& HistoryOf(std::string_view name)
+    {
+        auto [it, inserted] = mHistoryLookup.try_emplace(name, mHistories.size());
+        if (inserted) {
+            mHistories.push_back(History { name });
+        }
+        return mHistories[it->second];
+    }
+
+    const Clock::time_point mEpoch;
+
+    std::vector<Slot> mRing = std::vector<Slot>(RING_CAPACITY);
+    std::atomic<uint64_t> mHead { 0 }; // Next slot to claim
+    uint64_t mTail = 0; // Next slot for EndFrame() to drain
+    size_t mDropped = 0;
+    std::atomic<uint32_t> mThreadCount { 0 };
+
+    std::vector<History> mHistories;
+    std::unordered_map<std::string_view, size_t> mHistoryLookup;
+
+    bool mCapturing = false;
+    std::vector<Event> mCapture;
+
+    std::mutex mInternMutex;
+    std::vector<std::unique_ptr<std::string>> mInterned;
+};
+
+/**
+ * @class ProfileScope
+ * @brief Records the time between its construction and destruction under a name.
+ */
+class ProfileScope {
+public:
+    explicit ProfileScope(const char* name)
+        : mName(name)
+        , mStart(Profiler::Get().Now())
+    {
+    }
+
+    ~ProfileScope() { Profiler::Get().Record(mName, mStart, Profiler::Get().Now()); }
+
+    ProfileScope(const ProfileScope&) = delete;
+    ProfileScope& operator=(const ProfileScope&) = delete;
+
+private:
+    const char* mName;
+    int64_t mStart;
+};
+
+} // namespace ECSEngine
+
+#define ECS_PROFILE_CONCAT_INNER(a, b) a##b
+#define ECS_PROFILE_CONCAT(a, b) ECS_PROFILE_CONCAT_INNER(a, b)
+
+// Times the rest of the enclosing block; name must outlive the profiler (see Profiler)
+#define ECS_PROFILE_SCOPE(name)                                                              \
+    ::ECSEngine::ProfileScope ECS_PROFILE_CONCAT(ecsProfileScope, __LINE__)(name)
+
+// Closes the profiler's frame; call where no scope is open
+#define ECS_PROFILE_END_FRAME() ::ECSEngine::Profiler::Get().EndFrame()
+
+#else
+
+#define ECS_PROFILE_SCOPE(name)
+#define ECS_PROFILE_END_FRAME()
+
+#endif
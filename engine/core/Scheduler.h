@@ -0,0 +1,224 @@
+/**
+ * @file Scheduler.h
+ * @brief Runs systems in dependency order, in parallel where their data access allows.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bitset>
+#include <cassert>
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "Profiler.h"
+#include "ThreadPool.h"
+#include "pack.h"
+
+namespace ECSEngine {
+
+class CollisionManager;
+class InputManager;
+class RenderManager;
+class SoundManager;
+class SpriteManager;
+class WindowManager;
+
+/**
+ * @brief Access tag: creating or removing entities, or adding or removing components.
+ * @details Every system implicitly reads the entity structure, so writing it orders a system
+ * against all others.
+ */
+struct EntityStructure { };
+
+// Component and resource types a system reads or writes
+template <typename... Ts> struct Reads { };
+template <typename... Ts> struct Writes { };
+
+/**
+ * @class Scheduler
+ * @brief Orders registered systems into waves of non-conflicting systems.
+ * @details Each system declares the component types (from the Components... pack) and shared
+ * resources (managers, EntityStructure) it reads and writes. Two systems conflict when one
+ * writes something the other reads or writes. A system runs after every conflicting system
+ * registered before it, so registration order is the tie breaker and the result matches
+ * running the systems one by one in that order.
+ *
+ * Systems in the same wave run concurrently on the ThreadPool; systems flagged mainThreadOnly
+ * (window and input handling) run on the calling thread while the rest of their wave runs.
+ * Without a pool, every wave runs serially in registration order.
+ *
+ * With ECS_ENABLE_PROFILER every system call is timed under the system's name.
+ *
+ * @tparam Components The component types in the EntityManager
+ */
+template <typename... Components> class Scheduler {
+    using ComponentPack = Pack<Components...>;
+    using ResourcePack
+        = Pack<EntityStructure, CollisionManager, InputManager, RenderManager, SoundManager,
+            SpriteManager, WindowManager>;
+
+    static constexpr size_t ACCESS_BITS = ComponentPack::size + ResourcePack::size;
+
+public:
+    using AccessMask = std::bitset<ACCESS_BITS>;
+    using SystemFn = std::function<void(float)>;
+
+    explicit Scheduler(ThreadPool* pool = nullptr)
+        : mPool(pool)
+    {
+    }
+
+    /**
+     * @brief Registers a system after all previously registered ones.
+     * @tparam ReadList Reads<...> of the types the system only reads
+     * @tparam WriteList Writes<...> of the types the system modifies
+     * @param name Name for debugging and profiling
+     * @param fn The system, called with the step's delta time
+     * @param mainThreadOnly Run on the thread calling Run() (required for SFML window access)
+     */
+    template <typename ReadList = Reads<>, typename WriteList = Writes<>>
+    void AddSystem(const std::string& name, SystemFn fn, bool mainThreadOnly = false)
+    {
+        SystemEntry entry;
+        entry.name = name;
+        entry.fn = std::move(fn);
+        entry.reads = MaskOf(ReadList {});
+        entry.writes = MaskOf(WriteList {});
+        entry.reads.set(BitOf<EntityStructure>()); // Everyone iterates the entity tables
+        entry.mainThreadOnly = mainThreadOnly;
+#ifdef ECS_ENABLE_PROFILER
+        entry.profileName = Profiler::Get().Intern(name);
+#endif
+
+        mSystems.push_back(std::move(entry));
+        mDirty = true;
+    }
+
+    /**
+     * @brief Runs every system once, wave by wave.
+     */
+    void Run(float deltaTime)
+    {
+        if (mDirty) {
+            BuildWaves();
+        }
+
+        for (const std::vector<size_t>& wave : mWaves) {
+            // Nothing to overlap with, skip the pool round trip
+            if (!mPool || wave.size() == 1) {
+                for (size_t system : wave) {
+                    RunSystem(mSystems[system], deltaTime);
+                }
+                continue;
+            }
+
+            TaskGroup group;
+
+            for (size_t system : wave) {
+                if (!mSystems[system].mainThreadOnly) {
+                    SystemEntry& entry = mSystems[system];
+                    mPool->Submit([&entry, deltaTime] { RunSystem(entry, deltaTime); }, &group);
+                }
+            }
+
+            for (size_t system : wave) {
+                if (mSystems[system].mainThreadOnly) {
+                    RunSystem(mSystems[system], deltaTime);
+                }
+            }
+
+            mPool->Wait(group);
+        }
+    }
+
+    /**
+     * @brief The system indices of each wave, in execution order.
+     */
+    const std::vector<std::vector<size_t>>& GetWaves()
+    {
+        if (mDirty) {
+            BuildWaves();
+        }
+        return mWaves;
+    }
+
+    const std::string& GetSystemName(size_t system) const { return mSystems[system].name; }
+    size_t GetSystemCount() const { return mSystems.size(); }
+
+    /**
+     * @brief Bit index of a component or resource type in an AccessMask.
+     */
+    template <typename T> static constexpr size_t BitOf()
+    {
+        if constexpr (ComponentPack::template contains<T>) {
+            return ComponentPack::template index<T>;
+        } else {
+            static_assert(ResourcePack::template contains<T>,
+                "Type is neither a component of this engine nor a known resource!");
+            return ComponentPack::size + ResourcePack::template index<T>;
+        }
+    }
+
+private:
+    struct SystemEntry {
+        std::string name;
+        SystemFn fn;
+        AccessMask reads;
+        AccessMask writes;
+        bool mainThreadOnly = false;
+#ifdef ECS_ENABLE_PROFILER
+        const char* profileName = nullptr; // Interned, so events outlive re-registration
+#endif
+    };
+
+    static void RunSystem(SystemEntry& entry, float deltaTime)
+    {
+        ECS_PROFILE_SCOPE(entry.profileName);
+        entry.fn(deltaTime);
+    }
+
+    template <template <typename...> class List, typename... Ts>
+    static AccessMask MaskOf(List<Ts...>)
+    {
+        AccessMask mask;
+        (mask.set(BitOf<Ts>()), ...);
+        return mask;
+    }
+
+    static bool Conflicts(const SystemEntry& a, const SystemEntry& b)
+    {
+        return (a.writes & (b.reads | b.writes)).any() || (b.writes & a.reads).any();
+    }
+
+    // Level of a system = one past the deepest earlier system it conflicts with
+    void BuildWaves()
+    {
+        std::vector<size_t> levels(mSystems.size(), 0);
+        size_t levelCount = 0;
+
+        for (size_t i = 0; i < mSystems.size(); ++i) {
+            for (size_t j = 0; j < i; ++j) {
+                if (Conflicts(mSystems[i], mSystems[j])) {
+                    levels[i] = std::max(levels[i], levels[j] + 1);
+                }
+            }
+            levelCount = std::max(levelCount, levels[i] + 1);
+        }
+
+        mWaves.assign(levelCount, {});
+        for (size_t i = 0; i < mSystems.size(); ++i) {
+            mWaves[levels[i]].push_back(i);
+        }
+
+        mDirty = false;
+    }
+
+    ThreadPool* mPool;
+    std::vector<SystemEntry> mSystems;
+    std::vector<std::vector<size_t>> mWaves; // System indices, registration order within a wave
+    bool mDirty = false;
+};
+
+} // namespace ECSEngine
@@ -0,0 +1,103 @@
+/**
+ * @file SingletonStorage.h
+ * @brief Storage for components that at most one entity holds at a time (the main camera...).
+ * @details One inline slot instead of growable arrays. The handle is always 0, and the
+ * owner list views walk has at most one entry.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include "ComponentStorage.h"
+
+namespace ECSEngine {
+
+template <typename T> class SingletonStorage {
+public:
+    SingletonStorage() = default;
+    ~SingletonStorage() = default;
+
+    // Store By Copy
+    size_t store(size_t owner, const T& value)
+    {
+        Link(owner);
+        mValue = value;
+        return 0;
+    }
+
+    // Store by Move
+    size_t store(size_t owner, T&& value)
+    {
+        Link(owner);
+        mValue = std::move(value);
+        return 0;
+    }
+
+    void remove([[maybe_unused]] size_t id)
+    {
+        assert(valid(id));
+
+        mValue = T {};
+        mOwners.clear();
+    }
+
+    T& operator[]([[maybe_unused]] size_t id)
+    {
+        assert(valid(id));
+        return mValue;
+    }
+
+    const T& operator[](size_t) const { return mValue; }
+
+    bool valid(size_t id) const { return id == 0 && !mOwners.empty(); }
+
+    // The holder, if any; used by EntityManager views and GetSingleton()
+    const std::vector<size_t>& owners() const { return mOwners; }
+
+    // Change tracking, see EntityManager::MarkChanged()
+    uint32_t version(size_t) const { return mVersion; }
+
+    void touch([[maybe_unused]] size_t id, uint32_t tick)
+    {
+        assert(valid(id));
+        mVersion = tick;
+    }
+
+    size_t size() const { return mOwners.size(); }
+
+    size_t memoryUsage() const { return sizeof(T) + VectorBytes(mOwners); }
+
+    void reserve(size_t) { }
+
+    void save(SnapshotWriter& writer) const
+    {
+        writer.WriteValues(mOwners);
+        writer.WriteValue(mValue);
+        writer.WriteValue(mVersion);
+    }
+
+    bool load(SnapshotReader& reader)
+    {
+        return reader.ReadValues(mOwners) && reader.ReadValue(mValue)
+            && reader.ReadValue(mVersion);
+    }
+
+private:
+    void Link(size_t owner)
+    {
+        assert(mOwners.empty() && "A singleton component can only be held by one entity!");
+
+        mOwners.assign(1, owner);
+        mVersion = 0;
+    }
+
+    T mValue {};
+    std::vector<size_t> mOwners; // Empty, or the one owning entity
+    uint32_t mVersion = 0;
+};
+
+}
@@ -0,0 +1,255 @@
+/**
+ * @file Snapshot.h
+ * @brief Flat binary snapshots of world state, for saving, rewinding and forking.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace ECSEngine {
+
+class SnapshotWriter;
+class SnapshotReader;
+
+/**
+ * @brief How a component type is written to a snapshot.
+ * @details Trivially copyable components need nothing: their storages are copied with one
+ * memcpy per array. Components owning memory (strings, vectors) specialize this next to
+ * their definition, writing and reading each field:
+ *
+ *   template <> struct SnapshotTraits<ScoreComponent> {
+ *       static void Write(SnapshotWriter& writer, const ScoreComponent& score);
+ *       static bool Read(SnapshotReader& reader, ScoreComponent& score);
+ *   };
+ */
+template <typename T> struct SnapshotTraits { };
+
+// True when T has a SnapshotTraits specialization, false when it is copied bitwise
+template <typename T>
+concept CustomSnapshot = requires(SnapshotWriter& writer, const T& value) {
+    SnapshotTraits<T>::Write(writer, value);
+};
+
+/**
+ * @struct WorldSnapshot
+ * @brief The bytes of one snapshot. Keep it around to reuse its capacity on the next save.
+ * @details The layout is the host's, like compiled maps: a snapshot only loads into a
+ * build with the same component types.
+ */
+struct WorldSnapshot {
+    std::vector<uint8_t> bytes;
+
+    /**
+     * @brief Writes the snapshot to a file (a quick save).
+     * @return false (after printing why) if the file could not be written
+     */
+    bool WriteFile(const std::string& path) const
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+        file.write(reinterpret_cast<const char*>(bytes.data()),
+            static_cast<std::streamsize>(bytes.size()));
+        if (!file) {
+            std::cerr << "Error: Could not write snapshot: " << path << std::endl;
+            return false;
+        }
+        return true;
+    }
+
+    /**
+     * @brief Reads a file written by WriteFile().
+     * @return false (after printing why) if the file could not be read
+     */
+    bool ReadFile(const std::string& path)
+    {
+        std::ifstream file(path, std::ios::binary);
+        if (!file.is_open()) {
+            std::cerr << "Error: Could not open snapshot: " << path << std::endl;
+            return false;
+        }
+        bytes.assign(std::istreambuf_iterator<char>(file), std::istreambuf_iterator<char>());
+        return true;
+    }
+};
+
+/**
+ * @class SnapshotWriter
+ * @brief Appends values to a snapshot's bytes.
+ */
+class SnapshotWriter {
+public:
+    /**
+     * @param bytes Emptied, then written to; its capacity is kept
+     */
+    explicit SnapshotWriter(std::vector<uint8_t>& bytes)
+        : mBytes(bytes)
+    {
+        mBytes.clear();
+    }
+
+    void WriteBytes(const void* data, size_t size)
+    {
+        const auto* begin = static_cast<const uint8_t*>(data);
+        mBytes.insert(mBytes.end(), begin, begin + size);
+    }
+
+    template <typename T> void WriteValue(const T& value)
+    {
+        if constexpr (CustomSnapshot<T>) {
+            SnapshotTraits<T>::Write(*this, value);
+        } else {
+            static_assert(std::is_trivially_copyable_v<T>,
+                "Specialize SnapshotTraits for types that own memory");
+            WriteBytes(&value, sizeof(T));
+        }
+    }
+
+    // Count, then the elements: one memcpy unless T has SnapshotTraits
+    template <typename T> void WriteValues(const std::vector<T>& values)
+    {
+        WriteValue(static_cast<uint64_t>(values.size()));
+        if constexpr (CustomSnapshot<T>) {
+            for (const T& value : values) {
+                SnapshotTraits<T>::Write(*this, value);
+            }
+        } else {
+            static_assert(std::is_trivially_copyable_v<T>,
+                "Specialize SnapshotTraits for types that own memory");
+            WriteBytes(values.data(), values.size() * sizeof(T));
+        }
+    }
+
+    // std::vector<bool> has no contiguous storage; one byte per flag
+    void WriteValues(const std::vector<bool>& flags)
+    {
+        WriteValue(static_cast<uint64_t>(flags.size()));
+        const size_t start = mBytes.size();
+        mBytes.resize(start + flags.size());
+        for (size_t i = 0; i < flags.size(); ++i) {
+            mBytes[start + i] = flags[i] ? 1 : 0;
+        }
+    }
+
+    void WriteString(std::string_view text)
+    {
+        WriteValue(static_cast<uint64_t>(text.size()));
+        WriteBytes(text.data(), text.size());
+    }
+
+private:
+    std::vector<uint8_t>& mBytes;
+};
+
+/**
+ * @class SnapshotReader
+ * @brief Reads values back in the order a SnapshotWriter wrote them.
+ * @details Every read checks the remaining size. Once one fails, the reader stays failed
+ * and every later read returns false too.
+ */
+class SnapshotReader {
+public:
+    explicit SnapshotReader(const std::vector<uint8_t>& bytes)
+        : mData(bytes.data())
+        , mSize(bytes.size())
+    {
+    }
+
+    bool ReadBytes(void* data, size_t size)
+    {
+        if (mFailed || size > mSize - mOffset) {
+            mFailed = true;
+            return false;
+        }
+        if (size > 0) { // Empty vectors have no data pointer
+            std::memcpy(data, mData + mOffset, size);
+            mOffset += size;
+        }
+        return true;
+    }
+
+    template <typename T> bool ReadValue(T& value)
+    {
+        if constexpr (CustomSnapshot<T>) {
+            return SnapshotTraits<T>::Read(*this, value);
+        } else {
+            static_assert(std::is_trivially_copyable_v<T>,
+                "Specialize SnapshotTraits for types that own memory");
+            return ReadBytes(&value, sizeof(T));
+        }
+    }
+
+    // Resizes values to the stored count; existing capacity is reused
+    template <typename T> bool ReadValues(std::vector<T>& values)
+    {
+        uint64_t count = 0;
+        if (!ReadValue(count)) {
+            return false;
+        }
+
+        if constexpr (CustomSnapshot<T>) {
+            values.resize(static_cast<size_t>(count));
+            for (T& value : values) {
+                if (!SnapshotTraits<T>::Read(*this, value)) {
+                    return false;
+                }
+            }
+            return true;
+        } else {
+            // Checked before resizing so a damaged count can't allocate the world
+            if (count > (mSize - mOffset) / sizeof(T)) {
+                mFailed = true;
+                return false;
+            }
+            values.resize(static_cast<size_t>(count));
+            return ReadBytes(values.data(), values.size() * sizeof(T));
+        }
+    }
+
+    bool ReadValues(std::vector<bool>& flags)
+    {
+        uint64_t count = 0;
+        if (!ReadValue(count) || count > mSize - mOffset) {
+            mFailed = true;
+            return false;
+        }
+        flags.resize(static_cast<size_t>(count));
+        for (size_t i = 0; i < flags.size(); ++i) {
+            flags[i] = mData[mOffset + i] != 0;
+        }
+        mOffset += flags.size();
+        return true;
+    }
+
+    bool ReadString(std::string& text)
+    {
+        uint64_t size = 0;
+        if (!ReadValue(size) || size > mSize - mOffset) {
+            mFailed = true;
+            return false;
+        }
+        text.assign(reinterpret_cast<const char*>(mData + mOffset), static_cast<size_t>(size));
+        mOffset += static_cast<size_t>(size);
+        return true;
+    }
+
+    bool Failed() const { return mFailed; }
+
+    // Everything has been read
+    bool AtEnd() const { return mOffset == mSize; }
+
+private:
+    const uint8_t* mData;
+    size_t mSize;
+    size_t mOffset = 0;
+    bool mFailed = false;
+};
+
+} // namespace ECSEngine
@@ -0,0 +1,135 @@
+/**
+ * @file SparseSetStorage.h
+ * @brief Packed component storage with swap-and-pop removal: The Sparse Set.
+ * @details Components live in a dense, hole-free array so systems can stream them
+ * linearly. A sparse entity -> dense index table gives O(1) lookup. Handles returned by
+ * store() are the owning entity IDs, which stay stable while the dense slots move.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+#include "ComponentStorage.h"
+
+namespace ECSEngine {
+
+template <typename T> class SparseSetStorage {
+public:
+    std::vector<T> mDense; // Packed components, no holes
+    std::vector<size_t> mOwners; // Dense index -> owning entity
+    std::vector<size_t> mSparse; // Entity -> dense index (INVALID_OWNER if absent)
+    std::vector<uint32_t> mVersions; // Dense index -> change tick of the last recorded write
+
+    SparseSetStorage() = default;
+    ~SparseSetStorage() = default;
+
+    // Store By Copy
+    size_t store(size_t owner, const T& value)
+    {
+        Link(owner);
+        mDense.push_back(value);
+        return owner;
+    }
+
+    // Store by Move
+    size_t store(size_t owner, T&& value)
+    {
+        Link(owner);
+        mDense.push_back(std::move(value));
+        return owner;
+    }
+
+    // Swap the last component into the hole so the dense array stays packed
+    void remove(size_t id)
+    {
+        assert(valid(id));
+
+        const size_t index = mSparse[id];
+        const size_t last = mDense.size() - 1;
+
+        if (index != last) {
+            mDense[index] = std::move(mDense[last]);
+            mOwners[index] = mOwners[last];
+            mVersions[index] = mVersions[last];
+            mSparse[mOwners[index]] = index;
+        }
+
+        mDense.pop_back();
+        mOwners.pop_back();
+        mVersions.pop_back();
+        mSparse[id] = INVALID_OWNER;
+    }
+
+    T& operator[](size_t id)
+    {
+        assert(valid(id));
+        return mDense[mSparse[id]];
+    }
+
+    const T& operator[](size_t id) const { return mDense[mSparse[id]]; }
+
+    bool valid(size_t id) const { return id < mSparse.size() && mSparse[id] != INVALID_OWNER; }
+
+    // Dense index -> owning entity, used by EntityManager views (never contains holes)
+    const std::vector<size_t>& owners() const { return mOwners; }
+
+    // Change tracking, see EntityManager::MarkChanged()
+    uint32_t version(size_t id) const { return mVersions[mSparse[id]]; }
+
+    void touch(size_t id, uint32_t tick)
+    {
+        assert(valid(id));
+        mVersions[mSparse[id]] = tick;
+    }
+
+    // Direct access to the packed components for linear streaming
+    std::vector<T>& dense() { return mDense; }
+    const std::vector<T>& dense() const { return mDense; }
+
+    size_t size() const { return mDense.size(); }
+
+    size_t memoryUsage() const
+    {
+        return VectorBytes(mDense) + VectorBytes(mOwners) + VectorBytes(mSparse)
+            + VectorBytes(mVersions);
+    }
+
+    void reserve(size_t capacity)
+    {
+        mDense.reserve(capacity);
+        mOwners.reserve(capacity);
+        mVersions.reserve(capacity);
+    }
+
+    void save(SnapshotWriter& writer) const
+    {
+        writer.WriteValues(mDense);
+        writer.WriteValues(mOwners);
+        writer.WriteValues(mSparse);
+        writer.WriteValues(mVersions);
+    }
+
+    bool load(SnapshotReader& reader)
+    {
+        return reader.ReadValues(mDense) && reader.ReadValues(mOwners)
+            && reader.ReadValues(mSparse) && reader.ReadValues(mVersions);
+    }
+
+private:
+    void Link(size_t owner)
+    {
+        if (owner >= mSparse.size()) {
+            mSparse.resize(owner + 1, INVALID_OWNER);
+        }
+        assert(mSparse[owner] == INVALID_OWNER && "Entity already has this component!");
+
+        mSparse[owner] = mDense.size();
+        mOwners.push_back(owner);
+        mVersions.push_back(0);
+    }
+};
+
+}
@@ -0,0 +1,183 @@
+/**
+ * @file SpatialGrid.h
+ * @brief Uniform grid (spatial hash) used as a collision broadphase.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+#include "MathUtil.h"
+
+namespace ECSEngine {
+
+/**
+ * @class SpatialGrid
+ * @brief Buckets IDs by the square cells their bounding boxes overlap.
+ * @details Cells are hashed by their integer coordinates, so the grid is unbounded and
+ * only costs memory where something is. A box is registered in every cell it touches;
+ * queries return each ID at most once.
+ *
+ * The grid remembers which cells were filled since the last Clear(), so clearing costs the
+ * cells in use rather than every cell ever touched. A cleared cell keeps its allocation for
+ * one more step and is freed if nothing refills it, as is a cell emptied by Remove(), so
+ * memory follows what is in the grid now, not the area explored so far.
+ */
+class SpatialGrid {
+public:
+    explicit SpatialGrid(float cellSize = 64.0f)
+        : mCellSize(cellSize)
+    {
+        assert(cellSize > 0.0f && "Cell size must be positive!");
+    }
+
+    /**
+     * @brief Changes the cell size. Drops everything currently in the grid.
+     * @param cellSize Side length of a cell in world units (must be > 0)
+     */
+    void SetCellSize(float cellSize)
+    {
+        assert(cellSize > 0.0f && "Cell size must be positive!");
+        mCellSize = cellSize;
+        mCells.clear();
+        mFilled.clear();
+        mKept.clear();
+    }
+
+    float GetCellSize() const { return mCellSize; }
+
+    /**
+     * @brief Registers an ID in every cell overlapped by box.
+     */
+    void Insert(size_t id, const Rect& box)
+    {
+        ForEachCell(box, [&](int64_t key) {
+            auto& ids = mCells[key];
+            if (ids.empty()) {
+                mFilled.push_back(key);
+            }
+            ids.push_back(id);
+        });
+
+        // Grids that are never cleared refill cells emptied by Remove(); keep the list bounded
+        if (mFilled.size() > 2 * mCells.size() + 64) {
+            mFilled.clear();
+            for (const auto& [key, ids] : mCells) {
+                if (!ids.empty()) {
+                    mFilled.push_back(key);
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief Unregisters an ID. box must be the one it was inserted with.
+     */
+    void Remove(size_t id, const Rect& box)
+    {
+        ForEachCell(box, [&](int64_t key) {
+            auto it = mCells.find(key);
+            if (it == mCells.end())
+                return;
+
+            auto& ids = it->second;
+            auto found = std::find(ids.begin(), ids.end(), id);
+            if (found != ids.end()) {
+                *found = ids.back();
+                ids.pop_back();
+            }
+            if (ids.empty()) {
+                mCells.erase(it);
+            }
+        });
+    }
+
+    /**
+     * @brief Empties every cell, freeing those that stayed empty since the previous Clear().
+     * @details Cells refilled every frame keep their allocations.
+     */
+    void Clear()
+    {
+        for (int64_t key : mKept) {
+            auto it = mCells.find(key);
+            if (it != mCells.end() && it->second.empty()) {
+                mCells.erase(it);
+            }
+        }
+
+        mKept.swap(mFilled);
+        mFilled.clear();
+        for (int64_t key : mKept) {
+            auto it = mCells.find(key);
+            if (it != mCells.end()) {
+                it->second.clear();
+            }
+        }
+    }
+
+    /**
+     * @brief Number of cells holding memory, empty ones kept for reuse included.
+     */
+    size_t CellCount() const { return mCells.size(); }
+
+    /**
+     * @brief Collects the IDs registered in any cell overlapped by box.
+     * @param box Region to query
+     * @param out Replaced with the candidate IDs, sorted and without duplicates
+     */
+    void Query(const Rect& box, std::vector<size_t>& out) const
+    {
+        out.clear();
+        ForEachCell(box, [&](int64_t key) {
+            auto it = mCells.find(key);
+            if (it != mCells.end()) {
+                out.insert(out.end(), it->second.begin(), it->second.end());
+            }
+        });
+
+        // A box spanning several cells sees the same neighbour more than once
+        std::sort(out.begin(), out.end());
+        out.erase(std::unique(out.begin(), out.end()), out.end());
+    }
+
+    /**
+     * @brief Calls fn(int64_t key) for each cell overlapped by box.
+     */
+    template <typename Fn> void ForEachCell(const Rect& box, Fn&& fn) const
+    {
+        const int32_t minX = CellCoord(box.topLeft.x);
+        const int32_t minY = CellCoord(box.topLeft.y);
+        const int32_t maxX = CellCoord(box.topLeft.x + box.width);
+        const int32_t maxY = CellCoord(box.topLeft.y + box.height);
+
+        for (int32_t y = minY; y <= maxY; ++y) {
+            for (int32_t x = minX; x <= maxX; ++x) {
+                fn(CellKey(x, y));
+            }
+        }
+    }
+
+    // Packs a cell coordinate into a single hashable key
+    static int64_t CellKey(int32_t x, int32_t y)
+    {
+        return (static_cast<int64_t>(x) << 32) | static_cast<uint32_t>(y);
+    }
+
+    int32_t CellCoord(float worldCoord) const
+    {
+        return static_cast<int32_t>(std::floor(worldCoord / mCellSize));
+    }
+
+private:
+    float mCellSize;
+    std::unordered_map<int64_t, std::vector<size_t>> mCells;
+    std::vector<int64_t> mFilled; // Cells filled since the last Clear(), may repeat
+    std::vector<int64_t> mKept; // Cells the last Clear() emptied but kept
+};
+
+}
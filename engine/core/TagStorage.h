@@ -0,0 +1,116 @@
+/**
+ * @file TagStorage.h
+ * @brief Storage for empty marker components: which entities hold the tag, nothing else.
+ * @details Laid out like SparseSetStorage minus the component array: a packed owner list
+ * for views and a sparse entity -> index table for lookups. Every tag value is the same,
+ * so operator[] hands out one shared instance.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+#include "ComponentStorage.h"
+
+namespace ECSEngine {
+
+template <typename T> class TagStorage {
+    static_assert(std::is_empty_v<T>, "TagStorage only holds empty types");
+
+public:
+    std::vector<size_t> mOwners; // Packed owning entities, no holes
+    std::vector<size_t> mSparse; // Entity -> index into mOwners (INVALID_OWNER if absent)
+    std::vector<uint32_t> mVersions; // Index -> change tick of the last recorded write
+
+    TagStorage() = default;
+    ~TagStorage() = default;
+
+    // Handles are the owning entity, like SparseSetStorage
+    size_t store(size_t owner, const T&)
+    {
+        if (owner >= mSparse.size()) {
+            mSparse.resize(owner + 1, INVALID_OWNER);
+        }
+        assert(mSparse[owner] == INVALID_OWNER && "Entity already has this component!");
+
+        mSparse[owner] = mOwners.size();
+        mOwners.push_back(owner);
+        mVersions.push_back(0);
+        return owner;
+    }
+
+    // Swap the last owner into the hole so the owner list stays packed
+    void remove(size_t id)
+    {
+        assert(valid(id));
+
+        const size_t index = mSparse[id];
+        const size_t last = mOwners.size() - 1;
+
+        if (index != last) {
+            mOwners[index] = mOwners[last];
+            mVersions[index] = mVersions[last];
+            mSparse[mOwners[index]] = index;
+        }
+
+        mOwners.pop_back();
+        mVersions.pop_back();
+        mSparse[id] = INVALID_OWNER;
+    }
+
+    T& operator[]([[maybe_unused]] size_t id)
+    {
+        assert(valid(id));
+        return mTag;
+    }
+
+    const T& operator[](size_t) const { return mTag; }
+
+    bool valid(size_t id) const { return id < mSparse.size() && mSparse[id] != INVALID_OWNER; }
+
+    // Index -> owning entity, used by EntityManager views (never contains holes)
+    const std::vector<size_t>& owners() const { return mOwners; }
+
+    // Change tracking, see EntityManager::MarkChanged()
+    uint32_t version(size_t id) const { return mVersions[mSparse[id]]; }
+
+    void touch(size_t id, uint32_t tick)
+    {
+        assert(valid(id));
+        mVersions[mSparse[id]] = tick;
+    }
+
+    size_t size() const { return mOwners.size(); }
+
+    size_t memoryUsage() const
+    {
+        return VectorBytes(mOwners) + VectorBytes(mSparse) + VectorBytes(mVersions);
+    }
+
+    void reserve(size_t capacity)
+    {
+        mOwners.reserve(capacity);
+        mVersions.reserve(capacity);
+    }
+
+    void save(SnapshotWriter& writer) const
+    {
+        writer.WriteValues(mOwners);
+        writer.WriteValues(mSparse);
+        writer.WriteValues(mVersions);
+    }
+
+    bool load(SnapshotReader& reader)
+    {
+        return reader.ReadValues(mOwners) && reader.ReadValues(mSparse)
+            && reader.ReadValues(mVersions);
+    }
+
+private:
+    T mTag {};
+};
+
+}
@@ -0,0 +1,252 @@
+/**
+ * @file ThreadPool.h
+ * @brief Work-stealing worker threads for running systems and jobs concurrently.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace ECSEngine {
+
+/**
+ * @class TaskGroup
+ * @brief Counts the unfinished tasks of one batch so a caller can wait for just that batch.
+ */
+class TaskGroup {
+public:
+    bool Done() const { return mPending.load(std::memory_order_acquire) == 0; }
+
+private:
+    friend class ThreadPool;
+    std::atomic<size_t> mPending { 0 };
+};
+
+/**
+ * @class ThreadPool
+ * @brief Runs submitted tasks on a fixed number of worker threads.
+ * @details Every worker owns a task deque. Workers push and pop their own tasks at the back
+ * (newest first, cache friendly) and steal from the front of other deques when theirs runs
+ * dry. Tasks submitted from outside the pool are spread over the deques round robin.
+ *
+ * Wait() blocks until a TaskGroup (or every task) has finished, and the waiting thread runs
+ * queued tasks itself in the meantime. That makes it safe to submit and wait from inside a
+ * task, and a pool with zero workers still works (everything runs inside Wait()).
+ *
+ * Tasks must not throw; the engine reports errors through asserts.
+ */
+class ThreadPool {
+public:
+    /**
+     * @brief Starts the workers.
+     * @param threadCount Number of worker threads, in addition to the thread calling Wait()
+     */
+    explicit ThreadPool(size_t threadCount = DefaultThreadCount())
+    {
+        // One deque per worker, plus one for threads outside the pool when there are none
+        const size_t queueCount = threadCount > 0 ? threadCount : 1;
+        for (size_t i = 0; i < queueCount; ++i) {
+            mQueues.push_back(std::make_unique<WorkerQueue>());
+        }
+
+        mWorkers.reserve(threadCount);
+        for (size_t i = 0; i < threadCount; ++i) {
+            mWorkers.emplace_back([this, i] { WorkerLoop(i); });
+        }
+    }
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    /**
+     * @brief Finishes all queued tasks and joins the workers.
+     */
+    ~ThreadPool()
+    {
+        Wait();
+
+        {
+            std::lock_guard lock(mSleepMutex);
+            mStopping = true;
+        }
+        mWake.notify_all();
+
+        for (std::thread& worker : mWorkers) {
+            worker.join();
+        }
+    }
+
+    /**
+     * @brief Queues a task.
+     * @param task Work to run on any thread of the pool
+     * @param group Optional group to count the task in, for Wait(TaskGroup&)
+     */
+    void Submit(std::function<void()> task, TaskGroup* group = nullptr)
+    {
+        if (group) {
+            group->mPending.fetch_add(1, std::memory_order_relaxed);
+        }
+        mPending.fetch_add(1, std::memory_order_relaxed);
+
+        // Workers keep their own tasks local; everyone else spreads them out
+        const size_t queue = tWorker.pool == this
+            ? tWorker.index
+            : mNextQueue.fetch_add(1, std::memory_order_relaxed) % mQueues.size();
+
+        // Counted before it is visible so a thief never sees more tasks than mQueued
+        {
+            std::lock_guard lock(mSleepMutex);
+            ++mQueued;
+        }
+
+        {
+            std::lock_guard lock(mQueues[queue]->mutex);
+            mQueues[queue]->tasks.push_back(Task { std::move(task), group });
+        }
+        mWake.notify_one();
+    }
+
+    /**
+     * @brief Blocks until every task of the group has finished, helping out meanwhile.
+     */
+    void Wait(TaskGroup& group)
+    {
+        WaitUntil([&group] { return group.Done(); });
+    }
+
+    /**
+     * @brief Blocks until every submitted task has finished, helping out meanwhile.
+     */
+    void Wait()
+    {
+        WaitUntil([this] { return mPending.load(std::memory_order_acquire) == 0; });
+    }
+
+    size_t GetThreadCount() const { return mWorkers.size(); }
+
+    // One worker per hardware thread, leaving one for the main thread
+    static size_t DefaultThreadCount()
+    {
+        const unsigned int hardware = std::thread::hardware_concurrency();
+        return hardware > 1 ? hardware - 1 : 0;
+    }
+
+private:
+    struct Task {
+        std::function<void()> fn;
+        TaskGroup* group;
+    };
+
+    struct WorkerQueue {
+        std::mutex mutex;
+        std::deque<Task> tasks;
+    };
+
+    // Identifies the pool and deque of the current thread, if it is a worker
+    struct WorkerIdentity {
+        ThreadPool* pool;
+        size_t index;
+    };
+    static inline thread_local WorkerIdentity tWorker {}; // Null pool outside workers
+
+    void WorkerLoop(size_t index)
+    {
+        tWorker = WorkerIdentity { this, index };
+
+        while (true) {
+            if (RunOne(index)) {
+                continue;
+            }
+
+            std::unique_lock lock(mSleepMutex);
+            mWake.wait(lock, [this] { return mStopping || mQueued > 0; });
+
+            if (mStopping && mQueued == 0) {
+                return;
+            }
+        }
+    }
+
+    template <typename Pred> void WaitUntil(Pred done)
+    {
+        const size_t home = tWorker.pool == this ? tWorker.index : 0;
+
+        while (!done()) {
+            if (RunOne(home)) {
+                continue;
+            }
+
+            // Nothing to steal: sleep until new work arrives or a task finishes
+            std::unique_lock lock(mSleepMutex);
+            mWake.wait(lock, [&] { return done() || mQueued > 0; });
+        }
+    }
+
+    // Runs one task, preferring the newest in our own deque, then stealing the oldest elsewhere
+    bool RunOne(size_t home)
+    {
+        Task task;
+        bool found = false;
+
+        for (size_t i = 0; i < mQueues.size() && !found; ++i) {
+            WorkerQueue& queue = *mQueues[(home + i) % mQueues.size()];
+            std::lock_guard lock(queue.mutex);
+
+            if (queue.tasks.empty()) {
+                continue;
+            }
+
+            if (i == 0) {
+                task = std::move(queue.tasks.back());
+                queue.tasks.pop_back();
+            } else {
+                task = std::move(queue.tasks.front());
+                queue.tasks.pop_front();
+            }
+            found = true;
+        }
+
+        if (!found) {
+            return false;
+        }
+
+        {
+            std::lock_guard lock(mSleepMutex);
+            --mQueued;
+        }
+
+        task.fn();
+
+        const bool groupDone
+            = task.group && task.group->mPending.fetch_sub(1, std::memory_order_acq_rel) == 1;
+        const bool allDone = mPending.fetch_sub(1, std::memory_order_acq_rel) == 1;
+
+        // Waiters sleep on the same condition as idle workers
+        if (groupDone || allDone) {
+            std::lock_guard lock(mSleepMutex);
+            mWake.notify_all();
+        }
+
+        return true;
+    }
+
+    std::vector<std::unique_ptr<WorkerQueue>> mQueues;
+    std::vector<std::thread> mWorkers;
+    std::atomic<size_t> mNextQueue { 0 };
+    std::atomic<size_t> mPending { 0 }; // Queued plus running
+
+    std::mutex mSleepMutex; // Guards mQueued and mStopping for the sleep condition
+    std::condition_variable mWake;
+    size_t mQueued = 0; // Tasks sitting in a deque
+    bool mStopping = false;
+};
+
+} // namespace ECSEngine
@@ -0,0 +1,162 @@
+/**
+ * @file TileCollisionGrid.h
+ * @brief Compact static collision layer for tile maps.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <cstdint>
+#include <memory_resource>
+#include <vector>
+
+#include "MathUtil.h"
+
+namespace ECSEngine {
+
+/**
+ * @class TileCollisionGrid
+ * @brief A byte grid of solid cells that stands in for per-tile collision entities.
+ * @details Each cell stores 0 (empty) or a 1-based index into a small table of collision
+ * shapes, so a level costs one byte per tile. Shapes are bounding boxes relative to the
+ * cell's top-left corner and must lie within the cell. Dynamic bodies are resolved against
+ * the cells under their bounding box by direct lookup; no entities are involved.
+ *
+ * RESOURCE LIFETIME:
+ * - The cells live in the memory resource the grid was created with (ECSEngine's level
+ *   arena for level data), which must outlive the grid. Assigning a grid keeps the
+ *   destination's resource, so size a grid in place with one created on its resource.
+ */
+class TileCollisionGrid {
+public:
+    TileCollisionGrid() = default;
+
+    explicit TileCollisionGrid(std::pmr::memory_resource* memory)
+        : mCells(memory)
+    {
+    }
+
+    /**
+     * @brief Sizes the grid. Every cell starts empty.
+     * @param origin World position of the top-left corner of cell (0, 0)
+     * @param tileWidth Cell width in world units
+     * @param tileHeight Cell height in world units
+     * @param width Number of columns
+     * @param height Number of rows
+     * @param memory Where the cells are allocated
+     */
+    TileCollisionGrid(Point2D origin, float tileWidth, float tileHeight, int width, int height,
+        std::pmr::memory_resource* memory = std::pmr::get_default_resource())
+        : mOrigin(origin)
+        , mTileWidth(tileWidth)
+        , mTileHeight(tileHeight)
+        , mWidth(width)
+        , mHeight(height)
+        , mCells(static_cast<size_t>(width) * height, 0, memory)
+    {
+        assert(tileWidth > 0.0f && tileHeight > 0.0f && "Tile size must be positive!");
+        assert(width >= 0 && height >= 0 && "Grid size must not be negative!");
+    }
+
+    /**
+     * @brief Registers a collision shape, reusing an identical one if present.
+     * @param box Bounding box relative to the cell's top-left corner
+     * @return Shape index to pass to SetCell()
+     */
+    uint8_t AddShape(const Rect& box)
+    {
+        for (size_t i = 0; i < mShapes.size(); ++i) {
+            const Rect& shape = mShapes[i];
+            if (shape.topLeft == box.topLeft && shape.width == box.width
+                && shape.height == box.height) {
+                return static_cast<uint8_t>(i + 1);
+            }
+        }
+
+        assert(mShapes.size() < 255 && "Too many distinct tile collision shapes!");
+        mShapes.push_back(box);
+        return static_cast<uint8_t>(mShapes.size());
+    }
+
+    /**
+     * @brief Marks a cell solid with the given shape, or empty when shape is 0.
+     */
+    void SetCell(int col, int row, uint8_t shape)
+    {
+        assert(InBounds(col, row));
+        assert(shape <= mShapes.size() && "Unknown collision shape!");
+        mCells[Index(col, row)] = shape;
+    }
+
+    uint8_t GetCell(int col, int row) const { return mCells[Index(col, row)]; }
+
+    std::pmr::memory_resource* GetMemoryResource() const
+    {
+        return mCells.get_allocator().resource();
+    }
+
+    bool InBounds(int col, int row) const
+    {
+        return col >= 0 && row >= 0 && col < mWidth && row < mHeight;
+    }
+
+    /**
+     * @brief World-space bounding box of a solid cell.
+     */
+    Rect CellBox(int col, int row) const
+    {
+        const uint8_t shape = GetCell(col, row);
+        assert(shape != 0 && "Cell is empty!");
+
+        const Rect& local = mShapes[shape - 1];
+        return Rect(Point2D(mOrigin.x + col * mTileWidth + local.topLeft.x,
+                        mOrigin.y + row * mTileHeight + local.topLeft.y),
+            local.width, local.height);
+    }
+
+    /**
+     * @brief Calls fn(int col, int row) for every solid cell under box.
+     */
+    template <typename Fn> void ForEachSolidCell(const Rect& box, Fn&& fn) const
+    {
+        if (mCells.empty())
+            return;
+
+        const int minCol = std::max(0, ColumnAt(box.topLeft.x));
+        const int maxCol = std::min(mWidth - 1, ColumnAt(box.topLeft.x + box.width));
+        const int minRow = std::max(0, RowAt(box.topLeft.y));
+        const int maxRow = std::min(mHeight - 1, RowAt(box.topLeft.y + box.height));
+
+        for (int row = minRow; row <= maxRow; ++row) {
+            for (int col = minCol; col <= maxCol; ++col) {
+                if (mCells[Index(col, row)] != 0) {
+                    fn(col, row);
+                }
+            }
+        }
+    }
+
+    int ColumnAt(float x) const { return static_cast<int>(std::floor((x - mOrigin.x) / mTileWidth)); }
+    int RowAt(float y) const { return static_cast<int>(std::floor((y - mOrigin.y) / mTileHeight)); }
+
+    const Point2D& GetOrigin() const { return mOrigin; }
+    float GetTileWidth() const { return mTileWidth; }
+    float GetTileHeight() const { return mTileHeight; }
+    int GetWidth() const { return mWidth; }
+    int GetHeight() const { return mHeight; }
+
+private:
+    size_t Index(int col, int row) const { return static_cast<size_t>(row) * mWidth + col; }
+
+    Point2D mOrigin;
+    float mTileWidth = 1.0f;
+    float mTileHeight = 1.0f;
+    int mWidth = 0;
+    int mHeight = 0;
+    std::pmr::vector<uint8_t> mCells; // [row * width + col], 0 = empty, n = mShapes[n - 1]
+    std::vector<Rect> mShapes; // Collision boxes relative to a cell's top-left
+};
+
+}
@@ -0,0 +1,192 @@
+/**
+ * @file TimerWheel.h
+ * @brief Hierarchical timer wheel: countdowns that cost nothing until they run out.
+ * @details Time is counted in ticks of TICK_SECONDS. A timer is an entity and the tick it
+ * expires at, filed in one of LEVELS wheels of SLOTS slots each: level 0 holds the next
+ * SLOTS ticks one slot per tick, each level above covers SLOTS times the span of the one
+ * below with coarser slots. Advancing visits one level 0 slot per tick; whenever a level
+ * wraps, the matching slot of the level above is spread over the levels below. Scheduling
+ * is an append and nothing is done per timer per frame, so thousands of idle timers cost
+ * as little as none.
+ *
+ * Timers are never removed. An owner that stops or restarts a countdown just stores the new
+ * expiry tick; when the old entry fires, it no longer matches and the owner skips it (see
+ * TimeSystem, SpawnSystem).
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <vector>
+
+#include "EntityID.h"
+#include "Snapshot.h"
+
+namespace ECSEngine {
+
+class TimerWheel {
+public:
+    using Tick = uint64_t;
+
+    static constexpr double TICK_SECONDS = 0.001;
+    static constexpr unsigned SLOT_BITS = 8;
+    static constexpr unsigned LEVELS = 4; // 2^32 ticks ahead, about 49 days
+    static constexpr size_t SLOTS = size_t { 1 } << SLOT_BITS;
+    static constexpr Tick MAX_DELAY = (Tick { 1 } << (SLOT_BITS * LEVELS)) - 1;
+
+    struct Timer {
+        EntityID entity;
+        Tick tick; // Expiry tick it was scheduled for
+    };
+
+    TimerWheel()
+        : mSlots(LEVELS * SLOTS)
+    {
+    }
+
+    // Current tick; timers scheduled for it or earlier have fired
+    Tick GetTick() const { return mNow; }
+
+    // Whole ticks covering seconds, at least one so a restarting timer always moves on
+    static Tick TicksFor(float seconds)
+    {
+        const double ticks = std::ceil(static_cast<double>(seconds) / TICK_SECONDS);
+        return static_cast<Tick>(std::clamp(ticks, 1.0, static_cast<double>(MAX_DELAY)));
+    }
+
+    // Expiry tick of a countdown of seconds starting now
+    Tick TickAfter(float seconds) const { return mNow + TicksFor(seconds); }
+
+    // Time until tick expires, 0 once it has
+    float SecondsUntil(Tick tick) const
+    {
+        if (tick <= mNow) {
+            return 0.0f;
+        }
+        return static_cast<float>(std::max(0.0, (tick - mNow) * TICK_SECONDS - mCarry));
+    }
+
+    /**
+     * @brief Fires entity's timer once Advance() reaches tick.
+     * @details Ticks that have passed fire on the next tick. Delays longer than MAX_DELAY are
+     * shortened to it.
+     */
+    void Schedule(EntityID entity, Tick tick)
+    {
+        tick = std::clamp(tick, mNow + 1, mNow + MAX_DELAY);
+        Insert(Timer { entity, tick });
+        mCount += 1;
+    }
+
+    /**
+     * @brief Moves time forward by deltaTime and collects the timers that expired.
+     * @details Left over fractions of a tick are carried to the next call. The batch is
+     * ordered by expiry tick, then entity, so it does not depend on the order timers were
+     * scheduled in (the wheel is rebuilt in another order after a snapshot is loaded).
+     * @return Expired timers, valid until the next call; stale ones included
+     */
+    const std::vector<Timer>& Advance(float deltaTime)
+    {
+        mFired.clear();
+
+        mCarry += deltaTime;
+        const auto steps = static_cast<Tick>(std::max(0.0, mCarry / TICK_SECONDS));
+        mCarry -= steps * TICK_SECONDS;
+        const Tick target = mNow + steps;
+
+        while (mNow < target) {
+            // Empty wheels have nothing to cascade, so skip straight to the end
+            if (mCount == 0) {
+                mNow = target;
+                break;
+            }
+
+            mNow += 1;
+            if ((mNow & (SLOTS - 1)) == 0) {
+                Cascade(1);
+            }
+
+            std::vector<Timer>& slot = mSlots[mNow & (SLOTS - 1)];
+            mFired.insert(mFired.end(), slot.begin(), slot.end());
+            mCount -= slot.size();
+            slot.clear();
+        }
+
+        std::sort(mFired.begin(), mFired.end(), [](const Timer& a, const Timer& b) {
+            return a.tick != b.tick ? a.tick < b.tick : a.entity < b.entity;
+        });
+        return mFired;
+    }
+
+    // Scheduled timers, stale ones included
+    size_t size() const { return mCount; }
+
+    /**
+     * @brief Change tick up to which the owning system has scheduled its components.
+     * @details The owner asks for Changed<...> { GetSyncTick() } to find countdowns that were
+     * added or restarted since, skipping the view when EntityManager::AnyChangedSince()
+     * says there are none (see EntityManager::AdvanceChangeTick()).
+     */
+    uint32_t GetSyncTick() const { return mSyncTick; }
+
+    void SetSyncTick(uint32_t tick) { mSyncTick = tick; }
+
+    // The clock only; the owner schedules its components again after Load()
+    void Save(SnapshotWriter& writer) const
+    {
+        writer.WriteValue(mNow);
+        writer.WriteValue(mCarry);
+        writer.WriteValue(mSyncTick);
+    }
+
+    // Drops every timer, then restores the clock
+    bool Load(SnapshotReader& reader)
+    {
+        for (std::vector<Timer>& slot : mSlots) {
+            slot.clear();
+        }
+        mCount = 0;
+        return reader.ReadValue(mNow) && reader.ReadValue(mCarry) && reader.ReadValue(mSyncTick);
+    }
+
+private:
+    // Files a timer in the lowest level whose span reaches it (tick >= mNow)
+    void Insert(const Timer& timer)
+    {
+        const Tick delay = timer.tick - mNow;
+        unsigned level = 0;
+        while (level + 1 < LEVELS && delay >= (Tick { 1 } << (SLOT_BITS * (level + 1)))) {
+            ++level;
+        }
+        const size_t slot = (timer.tick >> (SLOT_BITS * level)) & (SLOTS - 1);
+        mSlots[level * SLOTS + slot].push_back(timer);
+    }
+
+    // The level below just wrapped: spread this level's current slot over the levels below
+    void Cascade(unsigned level)
+    {
+        const size_t slot = (mNow >> (SLOT_BITS * level)) & (SLOTS - 1);
+
+        mCascading.swap(mSlots[level * SLOTS + slot]);
+        for (const Timer& timer : mCascading) {
+            Insert(timer);
+        }
+        mCascading.clear();
+
+        if (slot == 0 && level + 1 < LEVELS) {
+            Cascade(level + 1);
+        }
+    }
+
+    std::vector<std::vector<Timer>> mSlots; // LEVELS * SLOTS, level 0 first
+    std::vector<Timer> mFired; // Last Advance() batch
+    std::vector<Timer> mCascading; // Reused while a slot is spread out
+    size_t mCount = 0;
+    Tick mNow = 0;
+    double mCarry = 0.0; // Seconds short of the next tick
+    uint32_t mSyncTick = 0; // 0 = every component counts as changed
+};
+
+} // namespace ECSEngine
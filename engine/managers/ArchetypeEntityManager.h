@@ -0,0 +1,421 @@
+/**
+ * @file ArchetypeEntityManager.h
+ * @brief Archetype/chunk backed alternative to EntityManager.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bitset>
+#include <cassert>
+#include <limits>
+#include <string_view>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../core/pack.h"
+#include "EntityManager.h"
+
+namespace ECSEngine {
+
+/**
+ * @class ArchetypeEntityManager
+ * @brief Stores entities grouped by component signature in chunks of contiguous columns.
+ * @details Every distinct set of components (an archetype) owns a list of fixed-size
+ * chunks. A chunk holds one packed column per component in the signature plus the owning
+ * EntityIDs, so multi-component systems walk co-located data instead of doing one random
+ * lookup per component per entity. Adding or removing a component moves the entity to the
+ * archetype for its new signature (swap-and-pop in the old one).
+ *
+ * The entity/component API mirrors EntityManager; iteration goes through ForEach() and
+ * ForEachChunk() rather than per-component storages.
+ *
+ * RESOURCE LIFETIME:
+ * - Component references (from GetComponent()) are invalidated by ANY structural change
+ *   (creating/removing entities or adding/removing components), since rows move.
+ *
+ * - Do not make structural changes from inside ForEach()/ForEachChunk().
+ *
+ * - EntityIDs remain stable. Use ValidEntity() to check if an EntityID is still valid.
+ *   Reused slots get a new generation, as in EntityManager.
+ */
+template <typename... Components> class ArchetypeEntityManager {
+    static constexpr size_t NUM_COMPONENTS = Pack<Components...>::size;
+
+public:
+    using Signature = std::bitset<NUM_COMPONENTS>;
+
+    // Target chunk footprint; the row count per chunk is derived from the signature
+    static constexpr size_t CHUNK_BYTES = 16 * 1024;
+
+    ArchetypeEntityManager()
+    {
+        // Archetype 0 holds entities without any components
+        GetOrCreateArchetype(Signature {});
+    }
+
+    /**
+     * @brief Creates a new entity with the given name.
+     * @param name Descriptive name for the entity (for debugging)
+     * @return Stable EntityID that remains valid until entity is removed
+     */
+    [[nodiscard]] EntityID CreateEntity(NameID name);
+
+    /**
+     * @brief Creates a new entity, interning its name first.
+     */
+    [[nodiscard]] EntityID CreateEntity(std::string_view name)
+    {
+        return CreateEntity(mNames.Intern(name));
+    }
+
+    NameID InternName(std::string_view name) { return mNames.Intern(name); }
+
+    const NameTable& GetNameTable() const { return mNames; }
+
+    /**
+     * @brief Checks if an EntityID is currently valid.
+     * @param entity The EntityID to check
+     * @return true if the entity exists and is valid
+     */
+    bool ValidEntity(EntityID entity) const
+    {
+        const uint32_t index = EntityIndex(entity);
+        return index < mEntities.size() && mEntities[index].id == entity;
+    }
+
+    /**
+     * @brief Returns an entity name.
+     * @param id The EntityID
+     * @return A string representing the entity's name.
+     */
+    const std::string& GetEntityName(EntityID id)
+    {
+        assert(ValidEntity(id) && "GetName");
+        return mNames.GetName(mEntities[EntityIndex(id)].name);
+    }
+
+    NameID GetEntityNameID(EntityID id) const
+    {
+        assert(ValidEntity(id) && "GetNameID");
+        return mEntities[EntityIndex(id)].name;
+    }
+
+    /**
+     * @brief Removes an entity and all its components.
+     * @param entity The EntityID to remove
+     */
+    void RemoveEntity(EntityID entity);
+
+    /**
+     * @brief Adds a component to an entity, moving it to the matching archetype.
+     * @param entity The EntityID to add the component to
+     * @param component The component to add (passed by value, will be moved)
+     */
+    template <typename T> void AddComponent(EntityID entity, T component)
+    {
+        static constexpr size_t COMP_TYPE_ID = Pack<Components...>::template index<T>;
+        static_assert(COMP_TYPE_ID != -1);
+        assert(ValidEntity(entity) && "AddComp");
+        assert(!HasComponent<T>(entity) && "Entity already has this component!");
+
+        const Record from = mRecords[EntityIndex(entity)];
+        Signature signature = mArchetypes[from.archetype].signature;
+        signature.set(COMP_TYPE_ID);
+
+        const size_t to = GetOrCreateArchetype(signature);
+        const Record moved = MoveEntity(entity, from, to);
+
+        // The new column is the only one MoveEntity did not fill
+        std::get<COMP_TYPE_ID>(mArchetypes[to].chunks[moved.chunk].columns)
+            .push_back(std::move(component));
+    }
+
+    /**
+     * @brief Removes a component from an entity, moving it to the matching archetype.
+     * @param entity The EntityID to remove the component from
+     */
+    template <typename T> void RemoveComponent(EntityID entity)
+    {
+        static constexpr size_t COMP_TYPE_ID = Pack<Components...>::template index<T>;
+        static_assert(COMP_TYPE_ID != -1);
+
+        if (!ValidEntity(entity) || !HasComponent<T>(entity))
+            return;
+
+        const Record from = mRecords[EntityIndex(entity)];
+        Signature signature = mArchetypes[from.archetype].signature;
+        signature.reset(COMP_TYPE_ID);
+
+        MoveEntity(entity, from, GetOrCreateArchetype(signature));
+    }
+
+    /**
+     * @brief Checks if an entity has a specific component.
+     * @param entity The EntityID to check
+     * @return true if the entity has the component
+     */
+    template <typename T> bool HasComponent(EntityID entity) const
+    {
+        static constexpr size_t COMP_TYPE_ID = Pack<Components...>::template index<T>;
+        static_assert(COMP_TYPE_ID != -1);
+        assert(ValidEntity(entity) && "HasComp");
+        return mArchetypes[mRecords[EntityIndex(entity)].archetype].signature.test(COMP_TYPE_ID);
+    }
+
+    /**
+     * @brief Gets a reference to a component on an entity.
+     * @param entity The EntityID to get the component from
+     * @return Reference to the component (see RESOURCE LIFETIME in class docs)
+     */
+    template <typename T> T& GetComponent(EntityID entity)
+    {
+        static constexpr size_t COMP_TYPE_ID = Pack<Components...>::template index<T>;
+        static_assert(COMP_TYPE_ID != -1);
+        assert(HasComponent<T>(entity) && "GetComp");
+
+        const Record& record = mRecords[EntityIndex(entity)];
+        auto& chunk = mArchetypes[record.archetype].chunks[record.chunk];
+        return std::get<COMP_TYPE_ID>(chunk.columns)[record.row];
+    }
+
+    /**
+     * @brief Calls fn once per chunk whose archetype holds every component in Ts...
+     * @details fn(size_t count, const EntityID* entities, Ts*... columns) receives the
+     * packed columns of the chunk, suitable for tight loops over co-located data.
+     */
+    template <typename... Ts, typename Fn> void ForEachChunk(Fn&& fn)
+    {
+        const Signature required = SignatureOf<Ts...>();
+
+        for (auto& archetype : mArchetypes) {
+            if ((archetype.signature & required) != required)
+                continue;
+
+            for (auto& chunk : archetype.chunks) {
+                fn(chunk.entities.size(), chunk.entities.data(),
+                    std::get<Pack<Components...>::template index<Ts>>(chunk.columns).data()...);
+            }
+        }
+    }
+
+    /**
+     * @brief Calls fn(EntityID, Ts&...) for every entity holding every component in Ts...
+     */
+    template <typename... Ts, typename Fn> void ForEach(Fn&& fn)
+    {
+        ForEachChunk<Ts...>([&](size_t count, const EntityID* entities, Ts*... columns) {
+            for (size_t row = 0; row < count; ++row) {
+                fn(entities[row], columns[row]...);
+            }
+        });
+    }
+
+    // Number of distinct component signatures seen so far (for debugging)
+    size_t ArchetypeCount() const { return mArchetypes.size(); }
+
+    using tEntity = std::vector<Entity>;
+    using const_iterator = tEntity::const_iterator;
+    const_iterator cbegin() const { return mEntities.begin(); }
+    const_iterator cend() const { return mEntities.end(); }
+    const_iterator begin() { return mEntities.begin(); }
+    const_iterator end() { return mEntities.end(); }
+
+private:
+    struct Chunk {
+        std::vector<EntityID> entities;
+        std::tuple<std::vector<Components>...> columns; // Only columns in the signature are used
+    };
+
+    struct Archetype {
+        Signature signature;
+        size_t chunkCapacity; // Rows per chunk
+        std::vector<Chunk> chunks; // All full except the last one
+    };
+
+    // Where an entity's row lives
+    struct Record {
+        size_t archetype;
+        size_t chunk;
+        size_t row;
+    };
+
+    template <typename... Ts> static Signature SignatureOf()
+    {
+        Signature signature;
+        (signature.set(Pack<Components...>::template index<Ts>), ...);
+        return signature;
+    }
+
+    size_t GetOrCreateArchetype(const Signature& signature);
+    Record AppendRow(size_t archetype, EntityID entity);
+    void RemoveRow(const Record& record);
+    Record MoveEntity(EntityID entity, const Record& from, size_t to);
+
+    std::vector<Entity> mEntities; // [index], id is INVALID_ENTITY for free slots
+    NameTable mNames;
+    std::vector<Record> mRecords; // [index]
+    std::vector<uint32_t> mFreeList; // free slot indices
+    std::vector<uint32_t> mGenerations; // [index], generation of the next entity in the slot
+
+    std::vector<Archetype> mArchetypes;
+    std::unordered_map<Signature, size_t> mArchetypeLookup;
+};
+
+// Template implementations (must be in header for templates)
+
+template <typename... Components>
+EntityID ArchetypeEntityManager<Components...>::CreateEntity(NameID name)
+{
+    uint32_t index;
+
+    if (!mFreeList.empty()) {
+        // Reuse a free slot; its generation was bumped when the old entity was removed
+        index = mFreeList.back();
+        mFreeList.pop_back();
+    } else {
+        // No free slots available, create a new entity at the end
+        assert(mEntities.size() < std::numeric_limits<uint32_t>::max() && "Out of entity slots!");
+        index = static_cast<uint32_t>(mEntities.size());
+        mGenerations.push_back(0);
+        mRecords.push_back({});
+        mEntities.emplace_back();
+    }
+
+    const EntityID ret = MakeEntityID(index, mGenerations[index]);
+    mEntities[index].id = ret;
+    mEntities[index].name = name;
+
+    // New entities start in the empty archetype
+    mRecords[index] = AppendRow(0, ret);
+
+    return ret;
+}
+
+template <typename... Components>
+void ArchetypeEntityManager<Components...>::RemoveEntity(EntityID entity)
+{
+    if (!ValidEntity(entity))
+        return;
+
+    const uint32_t index = EntityIndex(entity);
+    RemoveRow(mRecords[index]);
+
+    // Clear data so iterators see an invalid slot
+    mEntities[index].name = NameTable::EMPTY_NAME;
+    mEntities[index].id = INVALID_ENTITY;
+
+    ++mGenerations[index];
+    mFreeList.push_back(index);
+}
+
+template <typename... Components>
+size_t ArchetypeEntityManager<Components...>::GetOrCreateArchetype(const Signature& signature)
+{
+    auto it = mArchetypeLookup.find(signature);
+    if (it != mArchetypeLookup.end()) {
+        return it->second;
+    }
+
+    // Size chunks so a full one is roughly CHUNK_BYTES
+    static constexpr std::array<size_t, NUM_COMPONENTS> COMPONENT_SIZES { sizeof(Components)... };
+    size_t rowBytes = sizeof(EntityID);
+    for (size_t compTypeID = 0; compTypeID < NUM_COMPONENTS; compTypeID++) {
+        rowBytes += signature.test(compTypeID) ? COMPONENT_SIZES[compTypeID] : 0;
+    }
+
+    Archetype archetype;
+    archetype.signature = signature;
+    archetype.chunkCapacity = std::max<size_t>(1, CHUNK_BYTES / rowBytes);
+
+    mArchetypes.push_back(std::move(archetype));
+    mArchetypeLookup.emplace(signature, mArchetypes.size() - 1);
+    return mArchetypes.size() - 1;
+}
+
+template <typename... Components>
+typename ArchetypeEntityManager<Components...>::Record
+ArchetypeEntityManager<Components...>::AppendRow(size_t archetypeIndex, EntityID entity)
+{
+    Archetype& archetype = mArchetypes[archetypeIndex];
+
+    if (archetype.chunks.empty()
+        || archetype.chunks.back().entities.size() == archetype.chunkCapacity) {
+        // Reserve every used column up front so a chunk never reallocates
+        Chunk& chunk = archetype.chunks.emplace_back();
+        chunk.entities.reserve(archetype.chunkCapacity);
+        [&]<size_t... Is>(std::index_sequence<Is...>) {
+            ((archetype.signature.test(Is)
+                     ? std::get<Is>(chunk.columns).reserve(archetype.chunkCapacity)
+                     : void()),
+                ...);
+        }(std::make_index_sequence<NUM_COMPONENTS> {});
+    }
+
+    Chunk& chunk = archetype.chunks.back();
+    chunk.entities.push_back(entity);
+
+    return { archetypeIndex, archetype.chunks.size() - 1, chunk.entities.size() - 1 };
+}
+
+template <typename... Components>
+void ArchetypeEntityManager<Components...>::RemoveRow(const Record& record)
+{
+    Archetype& archetype = mArchetypes[record.archetype];
+    Chunk& last = archetype.chunks.back();
+    const size_t lastChunk = archetype.chunks.size() - 1;
+    const size_t lastRow = last.entities.size() - 1;
+
+    // Fill the hole with the archetype's final row so chunks stay packed
+    if (record.chunk != lastChunk || record.row != lastRow) {
+        Chunk& chunk = archetype.chunks[record.chunk];
+        const EntityID movedEntity = last.entities[lastRow];
+
+        chunk.entities[record.row] = movedEntity;
+        [&]<size_t... Is>(std::index_sequence<Is...>) {
+            ((archetype.signature.test(Is)
+                     ? void(std::get<Is>(chunk.columns)[record.row]
+                         = std::move(std::get<Is>(last.columns)[lastRow]))
+                     : void()),
+                ...);
+        }(std::make_index_sequence<NUM_COMPONENTS> {});
+
+        mRecords[EntityIndex(movedEntity)] = record;
+    }
+
+    last.entities.pop_back();
+    [&]<size_t... Is>(std::index_sequence<Is...>) {
+        ((archetype.signature.test(Is) ? std::get<Is>(last.columns).pop_back() : void()), ...);
+    }(std::make_index_sequence<NUM_COMPONENTS> {});
+
+    if (last.entities.empty()) {
+        archetype.chunks.pop_back();
+    }
+}
+
+template <typename... Components>
+typename ArchetypeEntityManager<Components...>::Record
+ArchetypeEntityManager<Components...>::MoveEntity(EntityID entity, const Record& from, size_t to)
+{
+    const Record moved = AppendRow(to, entity);
+
+    // Move every component both archetypes share into the new row
+    const Signature shared = mArchetypes[from.archetype].signature & mArchetypes[to].signature;
+    Chunk& src = mArchetypes[from.archetype].chunks[from.chunk];
+    Chunk& dst = mArchetypes[to].chunks[moved.chunk];
+    [&]<size_t... Is>(std::index_sequence<Is...>) {
+        ((shared.test(Is)
+                 ? std::get<Is>(dst.columns).push_back(std::move(std::get<Is>(src.columns)[from.row]))
+                 : void()),
+            ...);
+    }(std::make_index_sequence<NUM_COMPONENTS> {});
+
+    RemoveRow(from);
+    mRecords[EntityIndex(entity)] = moved;
+    return moved;
+}
+
+}
@@ -0,0 +1,272 @@
+/**
+ * @file AssetCache.cpp
+ * @brief Implementation of the decoded asset cache and the asset manifest.
+ */
+
+#include "AssetCache.h"
+
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+
+#include "../core/MappedFile.h"
+
+namespace ECSEngine {
+
+namespace {
+
+constexpr char MAGIC[4] = { 'E', 'C', 'S', 'A' };
+constexpr uint32_t VERSION = 1;
+
+enum class EntryKind : uint32_t { Texture = 1, Sound = 2 };
+
+struct AssetFileHeader {
+    char magic[4];
+    uint32_t version;
+    EntryKind kind;
+    uint32_t padding;
+    uint64_t sourceHash; // Checked again on load, in case an entry was renamed or copied
+};
+
+struct TextureRecord {
+    uint32_t width;
+    uint32_t height;
+};
+
+struct SoundRecord {
+    uint64_t sampleCount;
+    uint32_t channelCount;
+    uint32_t sampleRate;
+};
+
+static_assert(sizeof(AssetFileHeader) == 24 && sizeof(TextureRecord) == 8
+        && sizeof(SoundRecord) == 16,
+    "Asset cache records must not contain implicit padding");
+
+// 64-bit FNV-1a; fast enough to hash a sheet on every launch, far cheaper than decoding it
+uint64_t HashBytes(const uint8_t* bytes, size_t size)
+{
+    uint64_t hash = 14695981039346656037ull;
+    for (size_t i = 0; i < size; ++i) {
+        hash ^= bytes[i];
+        hash *= 1099511628211ull;
+    }
+    return hash;
+}
+
+AssetFileHeader MakeHeader(EntryKind kind, uint64_t sourceHash)
+{
+    AssetFileHeader header {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.kind = kind;
+    header.sourceHash = sourceHash;
+    return header;
+}
+
+// Validates an entry's header and returns its record, or false if it cannot be used
+template <typename Record>
+bool ReadRecord(const MappedFile& entry, EntryKind kind, uint64_t sourceHash, Record& record)
+{
+    AssetFileHeader header;
+    if (!entry.IsOpen() || entry.Size() < sizeof(header) + sizeof(record)) {
+        return false;
+    }
+    std::memcpy(&header, entry.Data(), sizeof(header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION
+        || header.kind != kind || header.sourceHash != sourceHash) {
+        return false;
+    }
+
+    std::memcpy(&record, entry.Data() + sizeof(header), sizeof(record));
+    return true;
+}
+
+template <typename T> std::string_view AsBytes(const T& value)
+{
+    return { reinterpret_cast<const char*>(&value), sizeof(T) };
+}
+
+} // namespace
+
+AssetCache::AssetCache(const std::string& cacheDirectory)
+    : mDirectory(cacheDirectory)
+{
+    std::error_code error;
+    std::filesystem::create_directories(mDirectory, error);
+    if (error) {
+        std::cerr << "Warning: Could not create asset cache " << mDirectory << ": "
+                  << error.message() << std::endl;
+    }
+}
+
+bool AssetCache::LoadImage(const std::string& sourcePath, sf::Image& out) const
+{
+    MappedFile source(sourcePath);
+    if (!source.IsOpen()) {
+        return false;
+    }
+
+    const uint64_t hash = HashBytes(source.Data(), source.Size());
+    const std::string entryPath = EntryPath(hash, ".tex");
+
+    MappedFile entry(entryPath);
+    TextureRecord record;
+    if (ReadRecord(entry, EntryKind::Texture, hash, record)) {
+        const size_t pixelBytes = size_t(record.width) * record.height * 4;
+        if (entry.Size() == sizeof(AssetFileHeader) + sizeof(record) + pixelBytes) {
+            out.resize({ record.width, record.height },
+                entry.Data() + sizeof(AssetFileHeader) + sizeof(record));
+            return true;
+        }
+    }
+
+    // Miss: decode the bytes already mapped, then remember the result
+    if (!out.loadFromMemory(source.Data(), source.Size())) {
+        return false;
+    }
+
+    const sf::Vector2u size = out.getSize();
+    const AssetFileHeader header = MakeHeader(EntryKind::Texture, hash);
+    const TextureRecord written { size.x, size.y };
+    WriteEntry(entryPath,
+        { AsBytes(header), AsBytes(written),
+            { reinterpret_cast<const char*>(out.getPixelsPtr()), size_t(size.x) * size.y * 4 } });
+    return true;
+}
+
+bool AssetCache::LoadSound(const std::string& sourcePath, sf::SoundBuffer& out) const
+{
+    MappedFile source(sourcePath);
+    if (!source.IsOpen()) {
+        return false;
+    }
+
+    const uint64_t hash = HashBytes(source.Data(), source.Size());
+    const std::string entryPath = EntryPath(hash, ".snd");
+
+    MappedFile entry(entryPath);
+    SoundRecord record;
+    if (ReadRecord(entry, EntryKind::Sound, hash, record) && record.channelCount > 0) {
+        const size_t mapOffset = sizeof(AssetFileHeader) + sizeof(record);
+        const size_t samplesOffset = mapOffset + size_t(record.channelCount) * sizeof(uint32_t);
+
+        if (entry.Size() == samplesOffset + record.sampleCount * sizeof(int16_t)) {
+            std::vector<sf::SoundChannel> channelMap(record.channelCount);
+            for (uint32_t i = 0; i < record.channelCount; ++i) {
+                uint32_t channel;
+                std::memcpy(&channel, entry.Data() + mapOffset + i * sizeof(channel),
+                    sizeof(channel));
+                channelMap[i] = static_cast<sf::SoundChannel>(channel);
+            }
+
+            // Mapped pages are page aligned and the offset is even, so samples are aligned
+            const auto* samples = reinterpret_cast<const int16_t*>(entry.Data() + samplesOffset);
+            if (out.loadFromSamples(samples, record.sampleCount, record.channelCount,
+                    record.sampleRate, channelMap)) {
+                return true;
+            }
+        }
+    }
+
+    if (!out.loadFromMemory(source.Data(), source.Size())) {
+        return false;
+    }
+
+    const AssetFileHeader header = MakeHeader(EntryKind::Sound, hash);
+    const SoundRecord written { out.getSampleCount(), out.getChannelCount(), out.getSampleRate() };
+
+    std::vector<uint32_t> channelMap;
+    for (sf::SoundChannel channel : out.getChannelMap()) {
+        channelMap.push_back(static_cast<uint32_t>(channel));
+    }
+
+    WriteEntry(entryPath,
+        { AsBytes(header), AsBytes(written),
+            { reinterpret_cast<const char*>(channelMap.data()),
+                channelMap.size() * sizeof(uint32_t) },
+            { reinterpret_cast<const char*>(out.getSamples()),
+                out.getSampleCount() * sizeof(int16_t) } });
+    return true;
+}
+
+std::string AssetCache::EntryPath(uint64_t sourceHash, const char* extension) const
+{
+    char name[17];
+    std::snprintf(name, sizeof(name), "%016llx", static_cast<unsigned long long>(sourceHash));
+    return (std::filesystem::path(mDirectory) / name).string() + extension;
+}
+
+void AssetCache::WriteEntry(
+    const std::string& path, const std::vector<std::string_view>& blocks) const
+{
+    const std::string temporaryPath = path + ".tmp";
+    {
+        std::ofstream file(temporaryPath, std::ios::binary | std::ios::trunc);
+        for (std::string_view block : blocks) {
+            file.write(block.data(), static_cast<std::streamsize>(block.size()));
+        }
+        if (!file) {
+            std::cerr << "Warning: Could not write asset cache entry " << path << std::endl;
+            return;
+        }
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporaryPath, path, error);
+}
+
+bool AssetManifest::Load(const std::string& manifestPath, AssetManifest& out)
+{
+    std::ifstream file(manifestPath);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open asset manifest: " << manifestPath << std::endl;
+        return false;
+    }
+
+    const std::filesystem::path directory = std::filesystem::path(manifestPath).parent_path();
+    auto resolve = [&](const std::string& path) { return (directory / path).string(); };
+
+    std::string line;
+    int lineNumber = 0;
+    while (std::getline(file, line)) {
+        ++lineNumber;
+
+        std::istringstream iss(line);
+        std::string kind;
+        if (!(iss >> kind) || kind[0] == '#') {
+            continue;
+        }
+
+        if (kind == "texture") {
+            std::string path;
+            if (iss >> path) {
+                out.textures.push_back(resolve(path));
+                continue;
+            }
+        } else if (kind == "sound") {
+            Sound sound;
+            if (iss >> sound.name >> sound.path) {
+                // Voice settings are optional as a group
+                SoundSettings settings;
+                if (iss >> settings.maxVoices >> settings.priority >> settings.volume) {
+                    sound.settings = settings;
+                }
+                sound.path = resolve(sound.path);
+                out.sounds.push_back(std::move(sound));
+                continue;
+            }
+        }
+
+        std::cerr << "Error: Invalid asset at " << manifestPath << ":" << lineNumber << std::endl;
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace ECSEngine
@@ -0,0 +1,101 @@
+/**
+ * @file AssetCache.h
+ * @brief On-disk cache of decoded textures and sounds, plus the manifest listing them.
+ */
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <SFML/Audio.hpp>
+#include <SFML/Graphics.hpp>
+
+#include "SoundManager.h"
+
+namespace ECSEngine {
+
+/**
+ * @struct AssetManifest
+ * @brief Every texture and sound a game needs, read from a text manifest.
+ * @details Format, one asset per line, paths relative to the manifest's directory:
+ *
+ *   # comment
+ *   texture [path]
+ *   sound [name] [path] [maxVoices priority volume (optional)]
+ *
+ * Tools prebuild the AssetCache from it; games request its assets at startup.
+ */
+struct AssetManifest {
+    struct Sound {
+        std::string name;
+        std::string path;
+        SoundSettings settings;
+    };
+
+    std::vector<std::string> textures;
+    std::vector<Sound> sounds;
+
+    /**
+     * @brief Reads a manifest file.
+     * @param manifestPath Path to the manifest
+     * @param out Receives the assets, their paths prefixed with the manifest's directory
+     * @return false (after printing why) if the file is missing or malformed
+     */
+    static bool Load(const std::string& manifestPath, AssetManifest& out);
+};
+
+/**
+ * @class AssetCache
+ * @brief Keeps decoded copies of asset files so later launches skip PNG and OGG decoding.
+ * @details Entries are keyed by a hash of the source file's bytes, so an edited asset simply
+ * misses the cache and is decoded again; stale entries are never used. A hit maps the entry
+ * and copies the raw RGBA pixels or PCM samples straight into SFML:
+ *
+ *   AssetFileHeader
+ *   Texture: TextureRecord, uint8_t[width * height * 4] RGBA pixels
+ *   Sound:   SoundRecord, uint32_t[channelCount] channel map, int16_t[sampleCount] samples
+ *
+ * Entries are written (on a miss) in the host's byte order, like compiled maps. They are
+ * written to a temporary file and renamed, so a crash never leaves a truncated entry.
+ *
+ * RESOURCE LIFETIME:
+ * - The cache only holds its directory. Its load functions touch nothing else, so they can
+ *   run on an AssetLoader thread while the main thread uses the same cache.
+ *
+ * - SpriteManager and SoundManager keep a pointer to the cache they are given, so it must
+ *   outlive them and any AssetLoader jobs they submitted.
+ */
+class AssetCache {
+public:
+    /**
+     * @param cacheDirectory Where entries are kept; created if missing
+     */
+    explicit AssetCache(const std::string& cacheDirectory);
+
+    /**
+     * @brief Decodes an image file, through the cache.
+     * @return false if the source file is missing or cannot be decoded
+     */
+    bool LoadImage(const std::string& sourcePath, sf::Image& out) const;
+
+    /**
+     * @brief Decodes a sound file, through the cache.
+     * @return false if the source file is missing or cannot be decoded
+     */
+    bool LoadSound(const std::string& sourcePath, sf::SoundBuffer& out) const;
+
+    const std::string& GetDirectory() const { return mDirectory; }
+
+private:
+    // Entry file for a source file with the given content hash
+    std::string EntryPath(uint64_t sourceHash, const char* extension) const;
+
+    // Writes header, record and payload blocks to path atomically; failures only cost a miss
+    void WriteEntry(const std::string& path, const std::vector<std::string_view>& blocks) const;
+
+    std::string mDirectory;
+};
+
+} // namespace ECSEngine
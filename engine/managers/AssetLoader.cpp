@@ -0,0 +1,109 @@
+/**
+ * @file AssetLoader.cpp
+ * @brief Implementation of the background asset loader.
+ */
+
+#include <chrono>
+
+#include "AssetLoader.h"
+
+namespace ECSEngine {
+
+AssetLoader::AssetLoader()
+    : mWorker(&AssetLoader::WorkerLoop, this)
+{
+}
+
+AssetLoader::~AssetLoader()
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mStop = true;
+    }
+    mWake.notify_one();
+    mWorker.join();
+}
+
+void AssetLoader::Submit(std::function<void()> decode, std::function<void()> complete)
+{
+    {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mQueued.push_back(Job { std::move(decode), std::move(complete) });
+    }
+    mWake.notify_one();
+}
+
+size_t AssetLoader::Update(float budgetMs)
+{
+    using Clock = std::chrono::steady_clock;
+    const auto deadline
+        = Clock::now() + std::chrono::duration<float, std::milli>(budgetMs);
+
+    size_t completed = 0;
+    do {
+        std::function<void()> complete = TakeDecoded();
+        if (!complete)
+            break;
+
+        complete();
+        ++completed;
+    } while (Clock::now() < deadline);
+
+    return completed;
+}
+
+void AssetLoader::Finish()
+{
+    {
+        std::unique_lock<std::mutex> lock(mMutex);
+        mIdle.wait(lock, [this] { return mQueued.empty() && !mDecoding; });
+    }
+
+    while (std::function<void()> complete = TakeDecoded()) {
+        complete();
+    }
+}
+
+size_t AssetLoader::GetPendingCount() const
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mQueued.size() + mDecoded.size() + (mDecoding ? 1 : 0);
+}
+
+void AssetLoader::WorkerLoop()
+{
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (true) {
+        mWake.wait(lock, [this] { return mStop || !mQueued.empty(); });
+        if (mStop)
+            return;
+
+        Job job = std::move(mQueued.front());
+        mQueued.pop_front();
+        mDecoding = true;
+
+        // Decode without holding the lock so Submit() and Update() never wait on I/O
+        lock.unlock();
+        job.decode();
+        lock.lock();
+
+        mDecoded.push_back(std::move(job.complete));
+        mDecoding = false;
+        if (mQueued.empty()) {
+            mIdle.notify_all();
+        }
+    }
+}
+
+std::function<void()> AssetLoader::TakeDecoded()
+{
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mDecoded.empty())
+        return {};
+
+    std::function<void()> complete = std::move(mDecoded.front());
+    mDecoded.pop_front();
+    return complete;
+}
+
+} // namespace ECSEngine
@@ -0,0 +1,88 @@
+/**
+ * @file AssetLoader.h
+ * @brief Background I/O thread for decoding assets off the main thread.
+ */
+#pragma once
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+
+namespace ECSEngine {
+
+/**
+ * @class AssetLoader
+ * @brief Runs asset jobs in two halves: decoding on an I/O thread, finishing on the main one.
+ * @details Submit() queues a job and returns at once. The decode half (reading and decoding
+ * a PNG or OGG into memory) runs on the loader's thread, one job at a time in submission
+ * order. The complete half (uploading a texture to the GPU, publishing a sound buffer) runs
+ * on the main thread from Update(), which stops once the per-frame budget is spent so a
+ * burst of loads is spread over several frames instead of causing a hitch.
+ *
+ * SpriteManager::LoadTextureAsync() and SoundManager::RegisterSoundAsync() are built on it.
+ *
+ * RESOURCE LIFETIME:
+ * - Jobs hold whatever their functions capture. Destroying the loader joins the thread and
+ *   drops unfinished jobs without completing them, so it must be destroyed before the
+ *   managers its jobs write to.
+ */
+class AssetLoader {
+public:
+    // Main-thread time Update() spends per frame by default
+    static constexpr float DEFAULT_BUDGET_MS = 2.0f;
+
+    AssetLoader();
+    ~AssetLoader();
+
+    AssetLoader(const AssetLoader&) = delete;
+    AssetLoader& operator=(const AssetLoader&) = delete;
+
+    /**
+     * @brief Queues a job.
+     * @param decode Runs on the I/O thread; must not touch anything the main thread uses
+     * @param complete Runs on the main thread, from Update() or Finish(), after decode
+     */
+    void Submit(std::function<void()> decode, std::function<void()> complete);
+
+    /**
+     * @brief Completes decoded jobs until budgetMs has passed (at least one if any is ready).
+     * @return Number of jobs completed
+     */
+    size_t Update(float budgetMs = DEFAULT_BUDGET_MS);
+
+    /**
+     * @brief Blocks until every submitted job is decoded, then completes them all.
+     * @details For load screens and setup code that needs the assets right away.
+     */
+    void Finish();
+
+    /**
+     * @brief Jobs submitted but not yet completed.
+     */
+    size_t GetPendingCount() const;
+
+private:
+    struct Job {
+        std::function<void()> decode;
+        std::function<void()> complete;
+    };
+
+    void WorkerLoop();
+
+    // Pops one decoded job's completion, or returns an empty function
+    std::function<void()> TakeDecoded();
+
+    mutable std::mutex mMutex;
+    std::condition_variable mWake; // Worker: a job was queued or the loader is stopping
+    std::condition_variable mIdle; // Finish(): the worker ran out of jobs
+    std::deque<Job> mQueued;
+    std::deque<std::function<void()>> mDecoded;
+    bool mDecoding = false; // Worker is running a decode outside the lock
+    bool mStop = false;
+    std::thread mWorker; // Last, so it starts after everything it uses
+};
+
+} // namespace ECSEngine
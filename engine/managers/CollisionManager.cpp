@@ -0,0 +1,119 @@
+/**
+ * @file CollisionManager.cpp
+ * @brief Implementation of the collision broadphase.
+ */
+
+#include <cassert>
+
+#include "CollisionManager.h"
+
+namespace ECSEngine {
+
+void CollisionManager::SetCellSize(float cellSize)
+{
+    mStaticGrid.SetCellSize(cellSize);
+    mDynamicGrid.SetCellSize(cellSize);
+    mSleepingGrid.SetCellSize(cellSize);
+    mStaticBoxes.clear();
+    mSleepingBoxes.clear();
+    mGeometryChanges.clear();
+}
+
+void CollisionManager::ClearBodies()
+{
+    mStaticGrid.Clear();
+    mDynamicGrid.Clear();
+    mSleepingGrid.Clear();
+    mStaticBoxes.clear();
+    mSleepingBoxes.clear();
+    mGeometryChanges.clear();
+    mContacts.clear();
+}
+
+void CollisionManager::InsertStatic(size_t id, const Rect& box)
+{
+    RemoveStatic(id);
+
+    mStaticGrid.Insert(id, box);
+    mStaticBoxes.emplace(id, box);
+    MarkGeometryChanged(box);
+}
+
+void CollisionManager::RemoveStatic(size_t id)
+{
+    auto it = mStaticBoxes.find(id);
+    if (it == mStaticBoxes.end())
+        return;
+
+    mStaticGrid.Remove(id, it->second);
+    MarkGeometryChanged(it->second);
+    mStaticBoxes.erase(it);
+}
+
+void CollisionManager::InsertSleeping(size_t id, const Rect& box)
+{
+    RemoveSleeping(id);
+
+    mSleepingGrid.Insert(id, box);
+    mSleepingBoxes.emplace(id, box);
+}
+
+void CollisionManager::RemoveSleeping(size_t id)
+{
+    auto it = mSleepingBoxes.find(id);
+    if (it == mSleepingBoxes.end())
+        return;
+
+    mSleepingGrid.Remove(id, it->second);
+    mSleepingBoxes.erase(it);
+}
+
+void CollisionManager::QuerySleeping(const Rect& box, std::vector<size_t>& out) const
+{
+    mSleepingGrid.Query(box, out);
+}
+
+void CollisionManager::MarkGeometryChanged(const Rect& box)
+{
+    if (mSleepingBoxes.empty())
+        return;
+
+    // Grown by a unit so bodies resting against the edge overlap it
+    mGeometryChanges.emplace_back(
+        box.topLeft.x - 1.0f, box.topLeft.y - 1.0f, box.width + 2.0f, box.height + 2.0f);
+}
+
+void CollisionManager::BeginFrame()
+{
+    mDynamicGrid.Clear();
+    mContacts.clear();
+}
+
+void CollisionManager::InsertDynamic(size_t id, const Rect& box)
+{
+    mDynamicGrid.Insert(id, box);
+}
+
+void CollisionManager::QueryStatic(const Rect& box, std::vector<size_t>& out) const
+{
+    mStaticGrid.Query(box, out);
+}
+
+void CollisionManager::QueryDynamic(const Rect& box, std::vector<size_t>& out) const
+{
+    mDynamicGrid.Query(box, out);
+}
+
+size_t CollisionManager::AddTileLayer(TileCollisionGrid layer)
+{
+    mTileLayers.push_back(std::move(layer));
+    return mTileLayers.size() - 1;
+}
+
+TileCollisionGrid& CollisionManager::GetTileLayer(size_t index)
+{
+    assert(index < mTileLayers.size() && "Unknown tile layer!");
+    return mTileLayers[index];
+}
+
+} // namespace ECSEngine
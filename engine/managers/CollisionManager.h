@@ -0,0 +1,208 @@
+/**
+ * @file CollisionManager.h
+ * @brief Broadphase acceleration structures for the collision system.
+ */
+#pragma once
+
+#include <cstdint>
+#include <limits>
+#include <unordered_map>
+#include <vector>
+
+#include "../core/EntityID.h"
+#include "../core/MathUtil.h"
+#include "../core/SpatialGrid.h"
+#include "../core/TileCollisionGrid.h"
+
+namespace ECSEngine {
+
+// Stand-in EntityID for tile layer cells, which are not entities
+// (an out-of-range index that is distinct from INVALID_ENTITY)
+constexpr EntityID TILE_BODY = MakeEntityID(std::numeric_limits<uint32_t>::max(), 0);
+
+/**
+ * @struct Contact
+ * @brief One overlap found by the narrowphase.
+ * @details The normal is the axis-aligned direction the first body is pushed to separate
+ * from the second, and penetration is the overlap along it. Tile cells are reported as
+ * TILE_BODY. `resolved` is false when the layer masks let the bodies pass through each
+ * other.
+ */
+struct Contact {
+    EntityID a;
+    EntityID b;
+    Point2D normal;
+    float penetration;
+    bool resolved;
+};
+
+/**
+ * @class CollisionManager
+ * @brief Owns the broadphase used by CollisionSystem.
+ * @details Static bodies are inserted into a persistent grid once, when their bounding box
+ * is first computed. Dynamic bodies are re-inserted into a second grid every frame. Candidate
+ * pairs are only ever produced for a dynamic body, so collision cost scales with the number
+ * of moving objects rather than the size of the level.
+ *
+ * Sleeping dynamic bodies (see SleepSystem.h) move to a third grid that is kept between
+ * frames, so they cost nothing until an awake body queries them.
+ *
+ * Tile map collision can bypass entities entirely: layers registered with AddTileLayer()
+ * are resolved by direct cell lookup under each dynamic body.
+ *
+ * The manager also holds the frame's contact buffer. CollisionSystem fills it and gameplay
+ * systems (pickups, camera shake...) read it afterwards, so they react once per contact
+ * instead of the narrowphase branching on what kind of entity it is looking at.
+ *
+ * RESOURCE LIFETIME:
+ * - The grids hold plain IDs. An ID may outlive its entity; callers must check the
+ *   entity is still valid and still has a CollisionComponent before using a candidate.
+ *
+ * - GetContacts() is valid until the next BeginFrame(), i.e. the next collision step.
+ *
+ * - Call RemoveStatic() when a static body is destroyed or moved so the grid does not
+ *   keep reporting it.
+ *
+ * - Sleeping bodies stay registered until RemoveSleeping(); SleepSystem removes them when
+ *   they wake.
+ */
+class CollisionManager {
+public:
+    CollisionManager() = default;
+    ~CollisionManager() = default;
+
+    /**
+     * @brief Sets the broadphase cell size, ideally the map's tile size.
+     * @param cellSize Side length of a grid cell in world units (must be > 0)
+     * @details Drops every registered body; static bodies must be re-inserted.
+     */
+    void SetCellSize(float cellSize);
+
+    /**
+     * @brief Unregisters every body and drops the contacts, keeping the cell size and the
+     * tile layers. Used before re-inserting a restored world's bodies.
+     */
+    void ClearBodies();
+
+    /**
+     * @brief Registers a static body (replacing any previous registration of the same ID).
+     * @param id The entity owning the body
+     * @param box The body's world-space bounding box
+     */
+    void InsertStatic(size_t id, const Rect& box);
+
+    /**
+     * @brief Unregisters a static body.
+     * @param id The entity owning the body
+     */
+    void RemoveStatic(size_t id);
+
+    /**
+     * @brief Registers a sleeping dynamic body (replacing any previous registration).
+     * @details Sleeping bodies are not re-inserted every frame, but awake dynamic bodies still
+     * query them (see QuerySleeping()) so a touch can wake them up.
+     * @param id The entity owning the body
+     * @param box The body's world-space bounding box
+     */
+    void InsertSleeping(size_t id, const Rect& box);
+
+    /**
+     * @brief Unregisters a sleeping body, e.g. when it wakes up.
+     * @param id The entity owning the body
+     */
+    void RemoveSleeping(size_t id);
+
+    /**
+     * @brief Collects sleeping bodies whose cells overlap box.
+     * @param out Replaced with candidate IDs (sorted, unique)
+     */
+    void QuerySleeping(const Rect& box, std::vector<size_t>& out) const;
+
+    /**
+     * @brief Records that the collision geometry inside box changed, so bodies sleeping
+     * there must wake up.
+     * @details InsertStatic() and RemoveStatic() call this themselves. Call it after editing
+     * a tile layer in place (GetTileLayer()). Nothing is recorded while no body is asleep.
+     */
+    void MarkGeometryChanged(const Rect& box);
+
+    /**
+     * @brief Regions passed to MarkGeometryChanged() since the last ClearGeometryChanges().
+     */
+    const std::vector<Rect>& GetGeometryChanges() const { return mGeometryChanges; }
+
+    void ClearGeometryChanges() { mGeometryChanges.clear(); }
+
+    /**
+     * @brief Empties the dynamic grid and the contact buffer. Called once per frame before
+     * re-inserting.
+     */
+    void BeginFrame();
+
+    /**
+     * @brief Registers a dynamic body for the current frame.
+     * @param id The entity owning the body
+     * @param box The body's world-space bounding box
+     */
+    void InsertDynamic(size_t id, const Rect& box);
+
+    /**
+     * @brief Collects static bodies whose cells overlap box.
+     * @param out Replaced with candidate IDs (sorted, unique)
+     */
+    void QueryStatic(const Rect& box, std::vector<size_t>& out) const;
+
+    /**
+     * @brief Collects dynamic bodies whose cells overlap box.
+     * @param out Replaced with candidate IDs (sorted, unique)
+     */
+    void QueryDynamic(const Rect& box, std::vector<size_t>& out) const;
+
+    /**
+     * @brief Registers a static tile collision layer.
+     * @param layer Grid of solid cells, e.g. produced by LoadMapLayer()
+     * @return Index of the layer (see GetTileLayer())
+     */
+    size_t AddTileLayer(TileCollisionGrid layer);
+
+    TileCollisionGrid& GetTileLayer(size_t index);
+
+    void AddContact(const Contact& contact) { mContacts.push_back(contact); }
+
+    /**
+     * @brief Contacts found by this frame's collision step, in discovery order.
+     */
+    const std::vector<Contact>& GetContacts() const { return mContacts; }
+
+    const std::vector<TileCollisionGrid>& GetTileLayers() const { return mTileLayers; }
+
+    /**
+     * @brief EntityManager change tick up to which CollisionSystem has turned locations into
+     * bounding boxes (see EntityManager::AdvanceChangeTick()).
+     */
+    uint32_t GetLocationTick() const { return mLocationTick; }
+
+    void SetLocationTick(uint32_t tick) { mLocationTick = tick; }
+
+    /**
+     * @brief EntityManager change tick up to which CollisionSystemUpdate has copied current
+     * bounding boxes into previous ones.
+     */
+    uint32_t GetPreviousBoxTick() const { return mPreviousBoxTick; }
+
+    void SetPreviousBoxTick(uint32_t tick) { mPreviousBoxTick = tick; }
+
+private:
+    SpatialGrid mStaticGrid;
+    SpatialGrid mDynamicGrid;
+    SpatialGrid mSleepingGrid;
+    std::unordered_map<size_t, Rect> mStaticBoxes; // Box each static body was inserted with
+    std::unordered_map<size_t, Rect> mSleepingBoxes; // Box each sleeping body was inserted with
+    std::vector<Rect> mGeometryChanges; // Consumed by SleepSystem
+    std::vector<TileCollisionGrid> mTileLayers;
+    std::vector<Contact> mContacts; // Capacity is kept between frames
+    uint32_t mLocationTick = 0; // 0 = every location counts as changed
+    uint32_t mPreviousBoxTick = 0;
+};
+
+} // namespace ECSEngine
@@ -0,0 +1,330 @@
+/**
+ * @file EntityCommandBuffer.h
+ * @brief Records structural changes during iteration and applies them later in one batch.
+ */
+
+#pragma once
+
+#include <cassert>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "../core/Prefab.h"
+#include "../core/pack.h"
+#include "EntityManager.h"
+
+namespace ECSEngine {
+
+/**
+ * @brief Handle to an entity created through an EntityCommandBuffer.
+ * @details Only meaningful to the buffer that returned it; becomes a real EntityID at playback.
+ */
+struct DeferredEntity {
+    size_t index;
+};
+
+/**
+ * @class EntityCommandBuffer
+ * @brief Queues entity and component creation/removal for a later Playback().
+ * @details Systems record structural changes here instead of mutating the EntityManager while
+ * iterating it, which keeps views and references valid and lets systems run in parallel.
+ * Components are queued per type, so recording an add is a single push into a typed vector.
+ *
+ * Playback() applies the commands in a fixed order, reserving storage for each step first:
+ * 1. Create or acquire entities (copying prefab components), 2. remove components,
+ * 3. add components, 4. remove or release entities.
+ * Commands that target an entity which no longer exists are skipped, so removing the same
+ * entity twice is harmless.
+ *
+ * A buffer is not thread-safe; use one per thread (see EntityCommandQueue).
+ *
+ * @tparam Components The component types in the EntityManager
+ */
+template <typename... Components> class EntityCommandBuffer {
+public:
+    /**
+     * @brief Queues the creation of an entity.
+     * @param name Entity name, interned with EntityManager::InternName()
+     * @return Handle to use with AddComponent() before playback
+     */
+    DeferredEntity CreateEntity(NameID name)
+    {
+        mCreates.push_back(PendingCreate { name });
+        return DeferredEntity { mCreates.size() - 1 };
+    }
+
+    /**
+     * @brief Queues the creation of an entity from a prefab.
+     * @details The prefab's components are copied at playback, before queued additions, so
+     * add only components the prefab doesn't have.
+     * @param prefab Prefab owned by a PrefabRegistry (must outlive the playback)
+     * @return Handle to use with AddComponent() before playback
+     */
+    DeferredEntity Instantiate(const Prefab<Components...>& prefab)
+    {
+        mCreates.push_back(PendingCreate { prefab.GetName(), &prefab });
+        return DeferredEntity { mCreates.size() - 1 };
+    }
+
+    /**
+     * @brief Queues getting a pooled instance of a prefab (see EntityManager::Acquire()).
+     * @details A reused entity already holds the components it had when released, so
+     * AddComponent() on the returned handle overwrites existing components instead.
+     * @param prefabs Registry holding the prefab (must outlive the playback)
+     * @param prefab Prefab to instantiate
+     * @return Handle to use with AddComponent() before playback
+     */
+    DeferredEntity Acquire(const PrefabRegistry<Components...>& prefabs, PrefabID prefab)
+    {
+        mCreates.push_back(PendingCreate { NameTable::EMPTY_NAME, nullptr, &prefabs, prefab });
+        return DeferredEntity { mCreates.size() - 1 };
+    }
+
+    /**
+     * @brief Queues removing an entity and all its components.
+     */
+    void RemoveEntity(EntityID entity) { mEntityRemovals.push_back({ entity, false }); }
+
+    /**
+     * @brief Queues returning an entity to its pool (see EntityManager::Release()).
+     */
+    void Release(EntityID entity) { mEntityRemovals.push_back({ entity, true }); }
+
+    /**
+     * @brief Queues adding a component to an existing entity.
+     */
+    template <typename T> void AddComponent(EntityID entity, T&& component)
+    {
+        PushAdd(Target { entity, false }, std::forward<T>(component));
+    }
+
+    /**
+     * @brief Queues adding a component to an entity created by this buffer.
+     */
+    template <typename T> void AddComponent(DeferredEntity entity, T&& component)
+    {
+        assert(entity.index < mCreates.size() && "Deferred entity from another buffer!");
+        PushAdd(Target { entity.index, true }, std::forward<T>(component));
+    }
+
+    /**
+     * @brief Queues removing a component from an existing entity.
+     */
+    template <typename T> void RemoveComponent(EntityID entity)
+    {
+        static_assert(Pack<Components...>::template contains<T>, "Unknown component type!");
+        std::get<Removals<T>>(mComponentRemovals).ids.push_back(entity);
+    }
+
+    bool Empty() const
+    {
+        return mCreates.empty() && mEntityRemovals.empty()
+            && (std::get<Adds<Components>>(mAdds).empty() && ...)
+            && (std::get<Removals<Components>>(mComponentRemovals).ids.empty() && ...);
+    }
+
+    /**
+     * @brief Applies every queued command to the entity manager and clears the buffer.
+     */
+    void Playback(EntityManager<Components...>& entityManager)
+    {
+        // 1. Creations, so deferred handles can resolve
+        entityManager.ReserveEntities(mCreates.size());
+
+        mCreated.clear();
+        mCreated.reserve(mCreates.size());
+        for (const PendingCreate& create : mCreates) {
+            mCreated.push_back(create.pools
+                    ? entityManager.Acquire(*create.pools, create.pooled)
+                    : entityManager.CreateEntity(create.name));
+        }
+        (PlaybackPrefabs<Components>(entityManager), ...);
+
+        // 2. Component removals, 3. component additions (per type)
+        (PlaybackRemovals<Components>(entityManager), ...);
+        (PlaybackAdds<Components>(entityManager), ...);
+
+        // 4. Entity removals last, so nothing above refers to a dead entity
+        for (const PendingRemoval& removal : mEntityRemovals) {
+            if (!entityManager.ValidEntity(removal.entity)) {
+                continue;
+            }
+            if (removal.release) {
+                entityManager.Release(removal.entity);
+            } else {
+                entityManager.RemoveEntity(removal.entity);
+            }
+        }
+
+        Clear();
+    }
+
+    /**
+     * @brief Drops every queued command, keeping the allocated capacity.
+     */
+    void Clear()
+    {
+        mCreates.clear();
+        mEntityRemovals.clear();
+        (std::get<Adds<Components>>(mAdds).clear(), ...);
+        (std::get<Removals<Components>>(mComponentRemovals).ids.clear(), ...);
+    }
+
+private:
+    struct PendingCreate {
+        NameID name;
+        const Prefab<Components...>* prefab = nullptr; // Copied in bulk after creation
+        const PrefabRegistry<Components...>* pools = nullptr; // Set for Acquire()
+        PrefabID pooled = INVALID_PREFAB;
+    };
+
+    struct PendingRemoval {
+        EntityID entity;
+        bool release; // Return to its pool instead of removing
+    };
+
+    // Existing entity, or index into mCreates when deferred
+    struct Target {
+        EntityID id;
+        bool deferred;
+    };
+
+    template <typename T> struct PendingAdd {
+        Target target;
+        T component;
+    };
+
+    template <typename T> using Adds = std::vector<PendingAdd<T>>;
+
+    // Wrapped so every component type gets a distinct tuple element
+    template <typename T> struct Removals {
+        std::vector<EntityID> ids;
+    };
+
+    template <typename U> void PushAdd(Target target, U&& component)
+    {
+        using T = std::decay_t<U>;
+        static_assert(Pack<Components...>::template contains<T>, "Unknown component type!");
+        std::get<Adds<T>>(mAdds).push_back(PendingAdd<T> { target, std::forward<U>(component) });
+    }
+
+    EntityID Resolve(const Target& target) const
+    {
+        return target.deferred ? mCreated[target.id] : target.id;
+    }
+
+    template <typename T> void PlaybackRemovals(EntityManager<Components...>& entityManager)
+    {
+        for (EntityID entity : std::get<Removals<T>>(mComponentRemovals).ids) {
+            if (entityManager.ValidEntity(entity)
+                && entityManager.template HasComponent<T>(entity)) {
+                entityManager.template RemoveComponent<T>(entity);
+            }
+        }
+    }
+
+    // Copies component T of every instantiated prefab, reserving the storage once
+    template <typename T> void PlaybackPrefabs(EntityManager<Components...>& entityManager)
+    {
+        size_t count = 0;
+        for (const PendingCreate& create : mCreates) {
+            count += create.prefab && create.prefab->template Has<T>() ? 1 : 0;
+        }
+        if (count == 0) {
+            return;
+        }
+
+        entityManager.template ReserveComponents<T>(count);
+        for (size_t i = 0; i < mCreates.size(); ++i) {
+            const Prefab<Components...>* prefab = mCreates[i].prefab;
+            if (prefab && prefab->template Has<T>()) {
+                entityManager.template AddComponent<T>(mCreated[i], prefab->template Get<T>());
+            }
+        }
+    }
+
+    template <typename T> void PlaybackAdds(EntityManager<Components...>& entityManager)
+    {
+        Adds<T>& adds = std::get<Adds<T>>(mAdds);
+        if (adds.empty()) {
+            return;
+        }
+
+        entityManager.template ReserveComponents<T>(adds.size());
+
+        for (PendingAdd<T>& add : adds) {
+            const EntityID entity = Resolve(add.target);
+            if (!entityManager.ValidEntity(entity)) {
+                continue;
+            }
+
+            // Entities reused from a pool may already hold T; re-arm it in place
+            if (add.target.deferred && entityManager.template HasComponent<T>(entity)) {
+                entityManager.template GetComponent<T>(entity) = std::move(add.component);
+                entityManager.template MarkChanged<T>(entity);
+            } else {
+                entityManager.template AddComponent<T>(entity, std::move(add.component));
+            }
+        }
+    }
+
+    std::vector<PendingCreate> mCreates;
+    std::vector<EntityID> mCreated; // mCreates resolved during playback
+    std::vector<PendingRemoval> mEntityRemovals;
+    std::tuple<Adds<Components>...> mAdds;
+    std::tuple<Removals<Components>...> mComponentRemovals;
+};
+
+/**
+ * @class EntityCommandQueue
+ * @brief One EntityCommandBuffer per thread, played back together at a sync point.
+ * @details Local() hands each thread its own buffer, so parallel systems record without
+ * contention. Playback() runs the buffers in the order their threads first used them and
+ * must be called while no system is running.
+ *
+ * @tparam Components The component types in the EntityManager
+ */
+template <typename... Components> class EntityCommandQueue {
+public:
+    using Buffer = EntityCommandBuffer<Components...>;
+
+    /**
+     * @brief Gets the calling thread's buffer, creating it on first use.
+     */
+    Buffer& Local()
+    {
+        std::lock_guard lock(mMutex);
+
+        auto [it, inserted] = mThreadBuffers.try_emplace(std::this_thread::get_id(), nullptr);
+        if (inserted) {
+            mBuffers.push_back(std::make_unique<Buffer>());
+            it->second = mBuffers.back().get();
+        }
+        return *it->second;
+    }
+
+    /**
+     * @brief Applies and clears every thread's buffer.
+     */
+    void Playback(EntityManager<Components...>& entityManager)
+    {
+        std::lock_guard lock(mMutex);
+
+        for (auto& buffer : mBuffers) {
+            buffer->Playback(entityManager);
+        }
+    }
+
+private:
+    std::mutex mMutex;
+    std::vector<std::unique_ptr<Buffer>> mBuffers; // Stable playback order
+    std::unordered_map<std::thread::id, Buffer*> mThreadBuffers;
+};
+
+} // namespace ECSEngine
@@ -5,49 +5,92 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <atomic>
+#include <bit>
 #include <cassert>
+#include <cstdint>
+#include <cstring>
 #include <iostream>
 #include <limits>
+#include <string_view>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 #include "../core/ComponentStorage.h"
+#include "../core/ComponentTraits.h"
+#include "../core/EntityID.h"
+#include "../core/NameTable.h"
+#include "../core/Prefab.h"
+#include "../core/Snapshot.h"
+#include "../core/ThreadPool.h"
 #include "../core/pack.h"
 
 namespace ECSEngine {
 
-// Entity type definitions
-using EntityID = size_t;
-
 /**
  * @struct Entity
  * @brief Represents a game entity with a unique ID.
+ * @details Removed entities keep their slot with id set to INVALID_ENTITY. The name is
+ * interned in the owning manager's NameTable. Pooled entities remember the prefab whose
+ * pool they return to, and are inactive while they wait there.
  */
 struct Entity {
     EntityID id;
-    std::string name;
+    NameID name;
+    PrefabID pool; // INVALID_PREFAB unless created by EntityManager::Acquire()
+    bool active;
 
     Entity()
-        : id(0)
-        , name("")
+        : id(INVALID_ENTITY)
+        , name(NameTable::EMPTY_NAME)
+        , pool(INVALID_PREFAB)
+        , active(true)
     {
     }
 
-    explicit Entity(EntityID entityId, std::string entityName = "")
+    explicit Entity(EntityID entityId, NameID entityName = NameTable::EMPTY_NAME)
         : id(entityId)
-        , name(std::move(entityName))
+        , name(entityName)
+        , pool(INVALID_PREFAB)
+        , active(true)
     {
     }
 };
 
+/**
+ * @struct Exclude
+ * @brief Names components an entity must NOT hold to appear in a view.
+ * @details Pass one to View() or ParallelForEach(), e.g. View<MovementComponent>(Exclude<Sleeping> {}).
+ * Types that are not among the manager's components never exclude anything, so engine
+ * systems can skip opt-in tags the game may not use.
+ */
+template <typename... Ts> struct Exclude { };
+
+/**
+ * @struct Changed
+ * @brief Keeps only entities whose Ts... were all written after change tick `since`.
+ * @details Pass one to View(), e.g. View<CollisionComponent>(Changed<LocationComponent> { since }).
+ * Writes are recorded by AddComponent() and MarkChanged() (see EntityManager::AdvanceChangeTick()).
+ */
+template <typename... Ts> struct Changed {
+    uint32_t since = 0;
+};
+
 /**
  * @class EntityManager
  * @brief Manages entities and their components in the ECS architecture.
  * @details This is the core of the ECS engine, providing efficient entity creation,
  * deletion, and component management. Uses a free list for entity reuse and maintains
- * separate storage for each component type.
+ * separate storage for each component type, chosen by its StoragePolicy (see
+ * ComponentTraits.h): packed SparseSetStorage for hot types, TagStorage for empty tags,
+ * one inline slot for singletons, non-relocating ChunkedStorage for churny types, and
+ * ComponentStorage for the rest. GetMemoryUsage() reports what each of them holds.
+ * Every entity slot also carries a ComponentMask, so HasComponent() and view matching test
+ * bits instead of reading the per-type index table.
  *
  * RESOURCE LIFETIME:
  * - Component references (from GetComponent()) are valid until the component is
@@ -58,21 +101,183 @@ struct Entity {
  *
  * - Entity iterators are invalidated when entities are created or removed.
  *
+ * - View<Ts...>() iterators tolerate entities being created mid-iteration; components
+ *   added to the driving storage during iteration are not visited. Removing a sparse-set
+ *   or tag component mid-iteration swaps another one into its slot, which is then skipped.
+ *   Systems should record structural changes in an EntityCommandBuffer instead.
+ *
+ * - Inactive entities (DeactivateEntity(), Release()) keep their ID and components but are
+ *   skipped by views, so systems don't see them until they are activated again.
+ *
  * - EntityIDs remain stable. Use ValidEntity() to check if an EntityID is still valid.
+ *   Slots are reused, but every reuse bumps the slot's generation, so a stale EntityID
+ *   stays invalid instead of aliasing the slot's new entity. Component storages record
+ *   owners by slot index (EntityIndex()); views hand out the full EntityID.
  */
 template <typename... Components> class EntityManager {
 public:
+    // Storages start with the room their ExpectedCapacity asks for
+    EntityManager()
+    {
+        (GetComponentStorage<Components>().reserve(ExpectedCapacity<Components>::value), ...);
+    }
+
+    // One bit per component type, in the order of Components
+    using ComponentMask = uint64_t;
+    static_assert(sizeof...(Components) <= 64, "ComponentMask has one bit per component type");
+
+    /**
+     * @brief The mask with the bits of Ts... set. Types missing from Components add nothing.
+     */
+    template <typename... Ts> static constexpr ComponentMask MaskOf()
+    {
+        return (ComponentMask { 0 } | ... | BitOf<Ts>());
+    }
+
+    template <typename... Ts> static constexpr ComponentMask MaskOf(Exclude<Ts...>)
+    {
+        return MaskOf<Ts...>();
+    }
+
+    /**
+     * @brief The component types an entity holds, for testing several at once:
+     *
+     *   constexpr auto body = EM::template MaskOf<CollisionComponent, MovementComponent>();
+     *   if ((entityManager.GetComponentMask(id) & body) == body)
+     */
+    ComponentMask GetComponentMask(EntityID entity) const
+    {
+        assert(ValidEntity(entity) && "GetMask");
+        return mMasks[EntityIndex(entity)];
+    }
+
     /**
      * @brief Creates a new entity with the given name.
      * @param name Descriptive name for the entity (for debugging)
      * @return Stable EntityID that remains valid until entity is removed
      */
-    [[nodiscard]] EntityID CreateEntity(const std::string& name);
+    [[nodiscard]] EntityID CreateEntity(NameID name);
+
+    /**
+     * @brief Creates a new entity, interning its name first.
+     * @details Prefer the NameID overload when creating many entities with the same name.
+     */
+    [[nodiscard]] EntityID CreateEntity(std::string_view name)
+    {
+        return CreateEntity(mNames.Intern(name));
+    }
+
+    /**
+     * @brief Interns a name in this manager's NameTable.
+     * @return NameID to pass to CreateEntity() or compare against GetEntityNameID()
+     */
+    NameID InternName(std::string_view name) { return mNames.Intern(name); }
+
+    const NameTable& GetNameTable() const { return mNames; }
+
+    /**
+     * @brief Makes room for additional entities without reallocating the entity tables.
+     * @param additional Number of entities about to be created
+     */
+    void ReserveEntities(size_t additional)
+    {
+        // Freed IDs are reused first, only the rest grows the tables
+        const size_t reused = std::min(additional, mFreeList.size());
+        const size_t target = mEntities.size() + additional - reused;
+        mEntities.reserve(target);
+        mEntityToComponentIdx.reserve(target);
+        mMasks.reserve(target);
+        mGenerations.reserve(target);
+        // Removing every entity later then never reallocates the free list either
+        mFreeList.reserve(target);
+    }
+
+    /**
+     * @brief Makes room for additional components of each type in Ts... .
+     * @param additional Number of components of each type about to be added
+     */
+    template <typename... Ts> void ReserveComponents(size_t additional)
+    {
+        (ReserveStorage(GetComponentStorage<Ts>(), additional), ...);
+    }
+
+    /**
+     * @brief Creates count entities that each start with a copy of every prototype component.
+     * @details The entity tables and every touched storage are reserved once up front, then
+     * the components are written one type at a time, so each storage is filled in a single
+     * sequential pass instead of interleaving all of them per entity.
+     * @param count Number of entities to create
+     * @param name Name shared by the new entities
+     * @param prototype Components copied onto every new entity (one per type)
+     * @return The new entities, in creation order
+     */
+    template <typename... Ts>
+    std::vector<EntityID> CreateEntities(size_t count, NameID name, const Ts&... prototype)
+    {
+        ReserveEntities(count);
+        ReserveComponents<Ts...>(count);
+
+        std::vector<EntityID> created;
+        created.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            created.push_back(CreateEntity(name));
+        }
+
+        (
+            [&] {
+                for (EntityID entity : created) {
+                    AddComponent<Ts>(entity, prototype);
+                }
+            }(),
+            ...);
+
+        return created;
+    }
+
+    /**
+     * @brief Creates an entity holding a copy of every component in the prefab.
+     * @return The new entity
+     */
+    EntityID Instantiate(const Prefab<Components...>& prefab)
+    {
+        const EntityID entity = CreateEntity(prefab.GetName());
+        (CopyFromPrefab<Components>(prefab, entity), ...);
+        return entity;
+    }
+
+    /**
+     * @brief Creates count instances of a prefab, with every storage reserved once.
+     * @details Like CreateEntities(), components are written one type at a time.
+     * @return The new entities, in creation order
+     */
+    std::vector<EntityID> Instantiate(const Prefab<Components...>& prefab, size_t count)
+    {
+        ReserveEntities(count);
+
+        std::vector<EntityID> created;
+        created.reserve(count);
+        for (size_t i = 0; i < count; ++i) {
+            created.push_back(CreateEntity(prefab.GetName()));
+        }
+
+        (
+            [&] {
+                if (prefab.template Has<Components>()) {
+                    ReserveComponents<Components>(count);
+                    for (EntityID entity : created) {
+                        CopyFromPrefab<Components>(prefab, entity);
+                    }
+                }
+            }(),
+            ...);
+
+        return created;
+    }
 
     /**
      * @brief Checks if an EntityID is currently valid.
      * @param entity The EntityID to check
-     * @return true if the entity exists and is valid
+     * @return true if the entity exists and is valid (false for stale IDs and INVALID_ENTITY)
      */
     bool ValidEntity(EntityID entity) const;
 
@@ -83,12 +288,104 @@ public:
      */
     const std::string& GetEntityName(EntityID id);
 
+    /**
+     * @brief Returns an entity's interned name, for cheap comparisons.
+     */
+    NameID GetEntityNameID(EntityID id) const
+    {
+        assert(ValidEntity(id) && "GetNameID");
+        return mEntities[EntityIndex(id)].name;
+    }
+
     /**
      * @brief Removes an entity and all its components.
      * @param entity The EntityID to remove
      */
     void RemoveEntity(EntityID entity);
 
+    /**
+     * @brief Hides an entity from views without touching its components.
+     */
+    void DeactivateEntity(EntityID entity)
+    {
+        assert(ValidEntity(entity) && "Deactivate");
+        mEntities[EntityIndex(entity)].active = false;
+    }
+
+    void ActivateEntity(EntityID entity)
+    {
+        assert(ValidEntity(entity) && "Activate");
+        mEntities[EntityIndex(entity)].active = true;
+    }
+
+    bool IsActive(EntityID entity) const
+    {
+        assert(ValidEntity(entity) && "IsActive");
+        return mEntities[EntityIndex(entity)].active;
+    }
+
+    /**
+     * @brief Gets an instance of a prefab, reusing a released one when the pool has any.
+     * @details A reused entity keeps its ID and component slots: the prefab's components are
+     * assigned over the old values and the entity is activated, so no storage is touched.
+     * Components the entity gained outside the prefab keep their last values, ready to be
+     * overwritten by the caller. Pair with Release() for entities that come and go quickly.
+     * @param prefabs Registry holding the prefab
+     * @param prefab Prefab to instantiate; also identifies its pool
+     * @return An active instance of the prefab
+     */
+    EntityID Acquire(const PrefabRegistry<Components...>& prefabs, PrefabID prefab)
+    {
+        const Prefab<Components...>& source = prefabs.Get(prefab);
+
+        if (prefab < mPools.size()) {
+            std::vector<EntityID>& pool = mPools[prefab];
+            while (!pool.empty()) {
+                const EntityID entity = pool.back();
+                pool.pop_back();
+
+                // Entities removed while pooled leave stale IDs behind
+                if (!ValidEntity(entity) || mEntities[EntityIndex(entity)].active) {
+                    continue;
+                }
+
+                (AssignFromPrefab<Components>(source, entity), ...);
+                mEntities[EntityIndex(entity)].active = true;
+                return entity;
+            }
+        }
+
+        const EntityID entity = Instantiate(source);
+        mEntities[EntityIndex(entity)].pool = prefab;
+        return entity;
+    }
+
+    /**
+     * @brief Deactivates a pooled entity and returns it to its prefab's pool.
+     * @details Entities that did not come from Acquire() are removed instead.
+     */
+    void Release(EntityID entity)
+    {
+        if (!ValidEntity(entity)) {
+            return;
+        }
+
+        Entity& slot = mEntities[EntityIndex(entity)];
+        if (slot.pool == INVALID_PREFAB) {
+            RemoveEntity(entity);
+            return;
+        }
+        if (!slot.active) {
+            return; // Already pooled
+        }
+
+        if (slot.pool >= mPools.size()) {
+            mPools.resize(slot.pool + 1);
+        }
+        slot.active = false;
+        mPools[slot.pool].push_back(entity);
+    }
+
     /**
      * @brief Adds a component to an entity.
      * @param entity The EntityID to add the component to
@@ -100,12 +397,16 @@ public:
         static_assert(COMP_TYPE_ID != -1);
         assert(ValidEntity(entity) && "AddComp");
 
+        const uint32_t index = EntityIndex(entity);
         auto& registry = std::get<COMP_TYPE_ID>(mRegistries);
-        const size_t compID = mEntityToComponentIdx[entity][COMP_TYPE_ID];
+        const size_t compID = mEntityToComponentIdx[index][COMP_TYPE_ID];
         // Entity should NOT already have this component
         assert(compID == INVALID_COMPONENT_INDEX);
-        const size_t newCompID = registry.store(std::forward<T>(component));
-        mEntityToComponentIdx[entity][COMP_TYPE_ID] = newCompID;
+        const size_t newCompID = registry.store(index, std::forward<T>(component));
+        registry.touch(newCompID, GetChangeTick());
+        RecordWrite(COMP_TYPE_ID, GetChangeTick());
+        mEntityToComponentIdx[index][COMP_TYPE_ID] = newCompID;
+        mMasks[index] |= MaskOf<T>();
     }
 
     /**
@@ -122,13 +423,15 @@ public:
         static_assert(COMP_TYPE_ID != -1);
 
         // Get the component ID for this entity
-        const size_t compID = mEntityToComponentIdx[entity][COMP_TYPE_ID];
+        const uint32_t index = EntityIndex(entity);
+        const size_t compID = mEntityToComponentIdx[index][COMP_TYPE_ID];
 
         // Only remove if the component exists
         if (compID != INVALID_COMPONENT_INDEX) {
             auto& registry = std::get<COMP_TYPE_ID>(mRegistries);
             registry.remove(compID);
-            mEntityToComponentIdx[entity][COMP_TYPE_ID] = INVALID_COMPONENT_INDEX;
+            mEntityToComponentIdx[index][COMP_TYPE_ID] = INVALID_COMPONENT_INDEX;
+            mMasks[index] &= ~MaskOf<T>();
         }
     }
 
@@ -139,10 +442,8 @@ public:
      */
     template <typename T> bool HasComponent(EntityID entity) const
     {
-        static constexpr size_t COMP_TYPE_ID = Pack<Components...>::template index<T>;
-        static_assert(COMP_TYPE_ID != -1);
         assert(ValidEntity(entity) && "HasComp");
-        return mEntityToComponentIdx[entity][COMP_TYPE_ID] != INVALID_COMPONENT_INDEX;
+        return HasComponentAt<T>(EntityIndex(entity));
     }
 
     /**
@@ -151,28 +452,461 @@ public:
      * @return Reference to the component (see RESOURCE LIFETIME in class docs)
      */
     template <typename T> T& GetComponent(EntityID entity)
+    {
+        assert(ValidEntity(entity) && "GetComp");
+        return GetComponentAt<T>(EntityIndex(entity));
+    }
+
+    /**
+     * @brief Registers the entity that uniquely holds component T (main camera, player...).
+     * @details Systems then fetch it with GetSingleton<T>() in O(1) instead of scanning
+     * View<T>() every frame. Register during setup, not while systems are running.
+     * @param entity Entity holding T
+     */
+    template <typename T> void RegisterSingleton(EntityID entity)
     {
         static constexpr size_t COMP_TYPE_ID = Pack<Components...>::template index<T>;
         static_assert(COMP_TYPE_ID != -1);
-        assert(ValidEntity(entity) && "GetComp");
+        assert(HasComponent<T>(entity) && "Singleton entity must hold the component!");
+        mSingletons[COMP_TYPE_ID] = entity;
+    }
 
-        auto& registry = std::get<COMP_TYPE_ID>(mRegistries);
-        const size_t compID = mEntityToComponentIdx[entity][COMP_TYPE_ID];
-        assert(registry.valid(compID));
-        return registry[compID];
+    /**
+     * @brief Returns the entity registered for T, or INVALID_ENTITY if there is none.
+     * @details When nothing is registered, or the registered entity was removed or lost T,
+     * falls back to the first entity in View<T>(). The fallback is not cached, so the call
+     * never writes and is safe from concurrently running systems.
+     */
+    template <typename T> EntityID GetSingleton()
+    {
+        static constexpr size_t COMP_TYPE_ID = Pack<Components...>::template index<T>;
+        static_assert(COMP_TYPE_ID != -1);
+
+        // A singleton storage knows its holder
+        if constexpr (ComponentStoragePolicy<T>::value == StoragePolicy::Singleton) {
+            const std::vector<size_t>& owners = std::get<COMP_TYPE_ID>(mRegistries).owners();
+            return !owners.empty() && mEntities[owners[0]].active ? mEntities[owners[0]].id
+                                                                  : INVALID_ENTITY;
+        }
+
+        const EntityID registered = mSingletons[COMP_TYPE_ID];
+        if (ValidEntity(registered) && mEntities[EntityIndex(registered)].active
+            && HasComponentAt<T>(EntityIndex(registered))) {
+            return registered;
+        }
+
+        const ComponentView<T> view = View<T>();
+        auto first = view.begin();
+        return first != view.end() ? std::get<0>(*first) : INVALID_ENTITY;
     }
 
     /**
      * @brief Gets direct access to component storage for efficient iteration.
-     * @return Reference to the ComponentStorage for type T
+     * @return Reference to the storage for type T (see StorageFor in ComponentTraits.h)
      */
-    template <typename T> ComponentStorage<T>& GetComponentStorage()
+    template <typename T> StorageFor<T>& GetComponentStorage()
     {
         static constexpr size_t COMP_TYPE_ID = Pack<Components...>::template index<T>;
         static_assert(COMP_TYPE_ID != -1);
         return std::get<COMP_TYPE_ID>(mRegistries);
     }
 
+    /**
+     * @struct ComponentMemory
+     * @brief Heap memory held by the storage of one component type.
+     */
+    struct ComponentMemory {
+        std::string_view type; // See ComponentName()
+        size_t count; // Components stored
+        size_t bytes; // Allocated, including capacity not in use yet
+    };
+
+    /**
+     * @brief Memory per component type, in the order of Components.
+     */
+    std::vector<ComponentMemory> GetMemoryUsage() const
+    {
+        return [this]<size_t... Is>(std::index_sequence<Is...>) {
+            return std::vector<ComponentMemory> { ComponentMemory { ComponentName<Components>(),
+                std::get<Is>(mRegistries).size(), std::get<Is>(mRegistries).memoryUsage() }... };
+        }(std::index_sequence_for<Components...> {});
+    }
+
+    /**
+     * @brief Heap bytes of the per-entity tables (slots, masks, component indices, pools).
+     */
+    size_t GetEntityMemoryUsage() const
+    {
+        size_t bytes = VectorBytes(mEntities) + VectorBytes(mEntityToComponentIdx)
+            + VectorBytes(mMasks) + VectorBytes(mFreeList) + VectorBytes(mGenerations)
+            + VectorBytes(mPools);
+        for (const std::vector<EntityID>& pool : mPools) {
+            bytes += VectorBytes(pool);
+        }
+        return bytes;
+    }
+
+    /**
+     * @brief Writes the whole world: entity tables, names, pools and every component storage.
+     * @details Storages are written array by array, one memcpy each for trivially copyable
+     * components (see SnapshotTraits for the rest), so saving every frame is affordable.
+     * State kept outside the manager, like a level streamer's entity lists, is its owner's
+     * to save.
+     */
+    void SaveSnapshot(SnapshotWriter& writer) const
+    {
+        writer.WriteBytes(SNAPSHOT_MAGIC, sizeof(SNAPSHOT_MAGIC));
+        writer.WriteValue(SNAPSHOT_VERSION);
+        writer.WriteValue(SNAPSHOT_SIGNATURE);
+
+        writer.WriteValues(mEntities);
+        mNames.Save(writer);
+        writer.WriteValues(mEntityToComponentIdx);
+        writer.WriteValues(mMasks);
+        writer.WriteValues(mFreeList);
+        writer.WriteValues(mGenerations);
+        writer.WriteValue(static_cast<uint64_t>(mPools.size()));
+        for (const std::vector<EntityID>& pool : mPools) {
+            writer.WriteValues(pool);
+        }
+        writer.WriteValue(mSingletons);
+        writer.WriteValue(GetChangeTick());
+
+        std::apply([&writer](const auto&... registries) { (registries.save(writer), ...); },
+            mRegistries);
+    }
+
+    void SaveSnapshot(WorldSnapshot& snapshot) const
+    {
+        SnapshotWriter writer(snapshot.bytes);
+        SaveSnapshot(writer);
+    }
+
+    /**
+     * @brief Replaces the world with one written by SaveSnapshot(), keeping EntityIDs.
+     * @details The change tick never moves backwards, so change observers (Changed<>) see
+     * every restored component as written no later than now.
+     * @return false (after printing why) if the snapshot is from a different set of
+     * components, leaving the world untouched, or if it is cut short, leaving the world half
+     * loaded until a good snapshot is loaded over it. Past the header the sizes are checked
+     * but the contents are trusted.
+     */
+    bool LoadSnapshot(SnapshotReader& reader)
+    {
+        char magic[sizeof(SNAPSHOT_MAGIC)];
+        uint32_t version = 0;
+        uint64_t signature = 0;
+        if (!reader.ReadBytes(magic, sizeof(magic)) || !reader.ReadValue(version)
+            || !reader.ReadValue(signature)
+            || std::memcmp(magic, SNAPSHOT_MAGIC, sizeof(magic)) != 0
+            || version != SNAPSHOT_VERSION || signature != SNAPSHOT_SIGNATURE) {
+            std::cerr << "Error: Snapshot is from another version or component set" << std::endl;
+            return false;
+        }
+
+        uint64_t poolCount = 0;
+        bool loaded = reader.ReadValues(mEntities) && mNames.Load(reader)
+            && reader.ReadValues(mEntityToComponentIdx) && reader.ReadValues(mMasks)
+            && reader.ReadValues(mFreeList)
+            && reader.ReadValues(mGenerations) && reader.ReadValue(poolCount);
+        if (loaded) {
+            mPools.resize(static_cast<size_t>(poolCount));
+            for (std::vector<EntityID>& pool : mPools) {
+                loaded = loaded && reader.ReadValues(pool);
+            }
+        }
+
+        uint32_t changeTick = 0;
+        loaded = loaded && reader.ReadValue(mSingletons) && reader.ReadValue(changeTick);
+        mChangeTick.store(std::max(changeTick, GetChangeTick()), std::memory_order_relaxed);
+        // Not saved: every type counts as written until its consumers have looked again
+        for (std::atomic<uint32_t>& lastWrite : mLastWrites) {
+            lastWrite.store(GetChangeTick(), std::memory_order_relaxed);
+        }
+
+        loaded = loaded && std::apply([&reader](auto&... registries) {
+            return (registries.load(reader) && ...);
+        }, mRegistries);
+        if (!loaded) {
+            std::cerr << "Error: Snapshot is damaged or cut short" << std::endl;
+        }
+        return loaded;
+    }
+
+    bool LoadSnapshot(const WorldSnapshot& snapshot)
+    {
+        SnapshotReader reader(snapshot.bytes);
+        return LoadSnapshot(reader) && reader.AtEnd();
+    }
+
+    /**
+     * @class ComponentView
+     * @brief Iterable set of the entities that hold every component in Ts...
+     * @details Iteration is driven by the smallest of the requested storages, so the cost
+     * grows with the matching set rather than with the number of entities in the world.
+     * Dereferencing yields std::tuple<EntityID, Ts&...>, which works with structured bindings:
+     *
+     *   for (auto [id, location, movement] : entityManager.template View<LocationComponent, MovementComponent>())
+     *
+     * Entities holding any of the components in ExcludeList (an Exclude<...>) are skipped, and
+     * so are entities whose components in ChangedList (a Changed<...>) weren't written since
+     * its tick.
+     */
+    template <typename ExcludeList, typename ChangedList, typename... Ts> class FilteredView {
+    public:
+        class iterator {
+        public:
+            iterator(EntityManager* manager, const std::vector<size_t>* owners, size_t pos,
+                size_t end, uint32_t since)
+                : mManager(manager)
+                , mOwners(owners)
+                , mPos(pos)
+                , mEnd(end)
+                , mSince(since)
+            {
+                SkipToMatch();
+            }
+
+            // Owners are live slots, so the components are fetched without re-validating
+            std::tuple<EntityID, Ts&...> operator*() const
+            {
+                const size_t owner = (*mOwners)[mPos];
+                return { mManager->mEntities[owner].id,
+                    mManager->template GetComponentAt<Ts>(owner)... };
+            }
+
+            iterator& operator++()
+            {
+                ++mPos;
+                SkipToMatch();
+                return *this;
+            }
+
+            bool operator!=(const iterator& other) const { return mPos != other.mPos; }
+
+        private:
+            // Advance past free slots, inactive entities, entities missing any of the other
+            // components, entities holding an excluded one and unchanged entities
+            void SkipToMatch()
+            {
+                while (mPos < mEnd && (mPos >= mOwners->size() || !Matches((*mOwners)[mPos]))) {
+                    ++mPos;
+                }
+            }
+
+            // Membership is one AND per mask; only change filters read the index table
+            bool Matches(size_t owner) const
+            {
+                if (owner == INVALID_OWNER || !mManager->mEntities[owner].active) {
+                    return false;
+                }
+                const ComponentMask mask = mManager->mMasks[owner];
+                return (mask & REQUIRED) == REQUIRED && (mask & EXCLUDED) == 0
+                    && mManager->ChangedAt(ChangedList {}, owner, mSince);
+            }
+
+            static constexpr ComponentMask REQUIRED = MaskOf<Ts...>();
+            static constexpr ComponentMask EXCLUDED = MaskOf(ExcludeList {});
+
+            EntityManager* mManager;
+            const std::vector<size_t>* mOwners;
+            size_t mPos;
+            size_t mEnd;
+            uint32_t mSince;
+        };
+
+        // Size of the largest component visited, for sizing parallel chunks
+        static constexpr size_t LARGEST_COMPONENT = std::max({ sizeof(Ts)... });
+
+        explicit FilteredView(EntityManager* manager, uint32_t since = 0)
+            : mManager(manager)
+            , mSince(since)
+        {
+            // Drive iteration from the smallest requested storage
+            const std::array<const std::vector<size_t>*, sizeof...(Ts)> candidates {
+                &manager->template GetComponentStorage<Ts>().owners()...
+            };
+            mOwners = candidates[0];
+            for (const auto* owners : candidates) {
+                if (owners->size() < mOwners->size()) {
+                    mOwners = owners;
+                }
+            }
+            mEnd = mOwners->size();
+        }
+
+        iterator begin() const { return iterator(mManager, mOwners, mBegin, mEnd, mSince); }
+        iterator end() const { return iterator(mManager, mOwners, mEnd, mEnd, mSince); }
+
+        // Number of storage slots the view walks, matching or not
+        size_t SlotCount() const { return mEnd - mBegin; }
+
+        /**
+         * @brief A view over slots [first, last) of this one, for splitting work.
+         */
+        FilteredView Slice(size_t first, size_t last) const
+        {
+            FilteredView slice = *this;
+            slice.mBegin = std::min(mBegin + first, mEnd);
+            slice.mEnd = std::min(mBegin + last, mEnd);
+            return slice;
+        }
+
+    private:
+        EntityManager* mManager;
+        const std::vector<size_t>* mOwners;
+        size_t mBegin = 0;
+        size_t mEnd;
+        uint32_t mSince;
+    };
+
+    template <typename... Ts> using ComponentView = FilteredView<Exclude<>, Changed<>, Ts...>;
+
+    /**
+     * @brief Returns a view over the entities holding every component in Ts...
+     * @return ComponentView yielding (EntityID, Ts&...) tuples
+     */
+    template <typename... Ts> ComponentView<Ts...> View()
+    {
+        static_assert(sizeof...(Ts) > 0, "View needs at least one component type");
+        return ComponentView<Ts...>(this);
+    }
+
+    /**
+     * @brief Returns a view over the entities holding every component in Ts... and none
+     * of the components in Xs...
+     * @return FilteredView yielding (EntityID, Ts&...) tuples
+     */
+    template <typename... Ts, typename... Xs>
+    FilteredView<Exclude<Xs...>, Changed<>, Ts...> View(Exclude<Xs...>)
+    {
+        static_assert(sizeof...(Ts) > 0, "View needs at least one component type");
+        return FilteredView<Exclude<Xs...>, Changed<>, Ts...>(this);
+    }
+
+    /**
+     * @brief Returns a view over the entities holding every component in Ts... whose
+     * components in Cs... were all written after changed.since
+     * @return FilteredView yielding (EntityID, Ts&...) tuples
+     */
+    template <typename... Ts, typename... Cs>
+    FilteredView<Exclude<>, Changed<Cs...>, Ts...> View(Changed<Cs...> changed)
+    {
+        static_assert(sizeof...(Ts) > 0, "View needs at least one component type");
+        return FilteredView<Exclude<>, Changed<Cs...>, Ts...>(this, changed.since);
+    }
+
+    template <typename... Ts, typename... Xs, typename... Cs>
+    FilteredView<Exclude<Xs...>, Changed<Cs...>, Ts...> View(Exclude<Xs...>, Changed<Cs...> changed)
+    {
+        static_assert(sizeof...(Ts) > 0, "View needs at least one component type");
+        return FilteredView<Exclude<Xs...>, Changed<Cs...>, Ts...>(this, changed.since);
+    }
+
+    /**
+     * @brief The tick that writes are currently recorded with.
+     */
+    uint32_t GetChangeTick() const { return mChangeTick.load(std::memory_order_relaxed); }
+
+    /**
+     * @brief Starts a new change tick, so later writes are newer than everything so far.
+     * @details A consumer of derived data keeps the value returned by its previous call and
+     * asks for Changed<...> { previous } before calling again:
+     *
+     *   const uint32_t since = mLastTick;
+     *   mLastTick = entityManager.AdvanceChangeTick();
+     *   for (auto [id, box] : entityManager.template View<Box>(Changed<LocationComponent> { since }))
+     *
+     * Ticks are 32-bit and wrap after about four billion calls; nothing guards against that.
+     * @return The tick that was current until now
+     */
+    uint32_t AdvanceChangeTick() { return mChangeTick.fetch_add(1, std::memory_order_relaxed); }
+
+    /**
+     * @brief Records that an entity's T was written during the current change tick.
+     * @details AddComponent() does this by itself. Systems that write a component others
+     * derive data from (LocationComponent, for bounding boxes) call it after writing. Safe to
+     * call from ParallelForEach() for the entity being visited.
+     */
+    template <typename T> void MarkChanged(EntityID entity)
+    {
+        static constexpr size_t COMP_TYPE_ID = Pack<Components...>::template index<T>;
+        static_assert(COMP_TYPE_ID != -1);
+        assert(ValidEntity(entity) && HasComponent<T>(entity) && "MarkChanged");
+
+        const uint32_t index = EntityIndex(entity);
+        std::get<COMP_TYPE_ID>(mRegistries)
+            .touch(mEntityToComponentIdx[index][COMP_TYPE_ID], GetChangeTick());
+        RecordWrite(COMP_TYPE_ID, GetChangeTick());
+    }
+
+    /**
+     * @brief Checks whether any T was written after tick since.
+     * @details One compare, so consumers of rarely written types (TimeComponent) skip their
+     * Changed<T> view entirely on the steps where nothing changed.
+     */
+    template <typename T> bool AnyChangedSince(uint32_t since) const
+    {
+        static constexpr size_t COMP_TYPE_ID = Pack<Components...>::template index<T>;
+        static_assert(COMP_TYPE_ID != -1);
+        return mLastWrites[COMP_TYPE_ID].load(std::memory_order_relaxed) > since;
+    }
+
+    /**
+     * @brief Checks whether an entity's T was written after tick since.
+     */
+    template <typename T> bool ChangedSince(EntityID entity, uint32_t since) const
+    {
+        assert(ValidEntity(entity) && HasComponent<T>(entity) && "ChangedSince");
+        return ChangedAt(Changed<T> {}, EntityIndex(entity), since);
+    }
+
+    /**
+     * @brief Calls fn(EntityID, Ts&...) for every entity in View<Ts...>(), spread over a pool.
+     * @details The view's slots are split into chunks of about PARALLEL_CHUNK_BYTES of the
+     * largest component, one task each, and the call returns once all chunks are done. Small
+     * views, or a null pool, run serially on the calling thread.
+     *
+     * fn must only touch the entity it is given (plus read-only shared data), and must not
+     * add or remove entities or components.
+     *
+     * @param pool Pool to run on, or nullptr for serial iteration
+     * @param fn Per-entity callback
+     * @param serialThreshold Views with fewer slots than this run serially
+     */
+    template <typename... Ts, typename Fn>
+    void ParallelForEach(ThreadPool* pool, Fn&& fn, size_t serialThreshold = PARALLEL_THRESHOLD)
+    {
+        RunParallel(View<Ts...>(), pool, fn, serialThreshold);
+    }
+
+    /**
+     * @brief ParallelForEach() over View<Ts...>(Exclude<Xs...>), skipping entities that
+     * hold any of Xs...
+     */
+    template <typename... Ts, typename... Xs, typename Fn>
+    void ParallelForEach(
+        Exclude<Xs...> exclude, ThreadPool* pool, Fn&& fn, size_t serialThreshold = PARALLEL_THRESHOLD)
+    {
+        RunParallel(View<Ts...>(exclude), pool, fn, serialThreshold);
+    }
+
+    /**
+     * @brief ParallelForEach() over View<Ts...>(Exclude<Xs...>, Changed<Cs...>)
+     */
+    template <typename... Ts, typename... Xs, typename... Cs, typename Fn>
+    void ParallelForEach(Exclude<Xs...> exclude, Changed<Cs...> changed, ThreadPool* pool, Fn&& fn,
+        size_t serialThreshold = PARALLEL_THRESHOLD)
+    {
+        RunParallel(View<Ts...>(exclude, changed), pool, fn, serialThreshold);
+    }
+
+    // Below this many slots ParallelForEach doesn't bother with the pool
+    static constexpr size_t PARALLEL_THRESHOLD = 1024;
+    // Work per ParallelForEach task: about an L1 data cache of the largest component
+    static constexpr size_t PARALLEL_CHUNK_BYTES = 16 * 1024;
+    static constexpr size_t PARALLEL_MIN_CHUNK = 64;
+
     using tEntity = std::vector<Entity>;
     using const_iterator = tEntity::const_iterator;
     const_iterator cbegin() const { return mEntities.begin(); }
@@ -183,65 +917,204 @@ public:
 private:
     void RemoveComponentByIndex(size_t compTypeID, size_t compID);
 
-    std::vector<Entity> mEntities;
+    template <typename ViewType, typename Fn>
+    static void RunParallel(const ViewType& view, ThreadPool* pool, Fn& fn, size_t serialThreshold)
+    {
+        const size_t slots = view.SlotCount();
+
+        if (!pool || pool->GetThreadCount() == 0 || slots < serialThreshold) {
+            for (auto&& entry : view) {
+                std::apply(fn, entry);
+            }
+            return;
+        }
+
+        const size_t chunkSlots = std::max<size_t>(
+            PARALLEL_MIN_CHUNK, PARALLEL_CHUNK_BYTES / ViewType::LARGEST_COMPONENT);
+
+        TaskGroup group;
+        for (size_t first = 0; first < slots; first += chunkSlots) {
+            pool->Submit(
+                [&fn, slice = view.Slice(first, first + chunkSlots)] {
+                    for (auto&& entry : slice) {
+                        std::apply(fn, entry);
+                    }
+                },
+                &group);
+        }
+        pool->Wait(group);
+    }
+
+    // Re-arms a pooled entity, which normally holds T already
+    template <typename T> void AssignFromPrefab(const Prefab<Components...>& prefab, EntityID entity)
+    {
+        if (!prefab.template Has<T>()) {
+            return;
+        }
+        if (HasComponentAt<T>(EntityIndex(entity))) {
+            GetComponentAt<T>(EntityIndex(entity)) = prefab.template Get<T>();
+            MarkChanged<T>(entity);
+        } else {
+            AddComponent<T>(entity, prefab.template Get<T>());
+        }
+    }
+
+    template <typename T> void CopyFromPrefab(const Prefab<Components...>& prefab, EntityID entity)
+    {
+        if (prefab.template Has<T>()) {
+            AddComponent<T>(entity, prefab.template Get<T>());
+        }
+    }
+
+    // Storages reuse freed slots first, so size() + additional always covers the adds
+    template <typename Storage> static void ReserveStorage(Storage& storage, size_t additional)
+    {
+        storage.reserve(storage.size() + additional);
+    }
+
+    template <typename T> static constexpr ComponentMask BitOf()
+    {
+        if constexpr (Pack<Components...>::template contains<T>) {
+            return ComponentMask { 1 } << Pack<Components...>::template index<T>;
+        } else {
+            return 0;
+        }
+    }
+
+    // Slot-index accessors for views, which only visit live owners
+    template <typename T> bool HasComponentAt(size_t index) const
+    {
+        static_assert(Pack<Components...>::template index<T> != -1);
+        return (mMasks[index] & MaskOf<T>()) != 0;
+    }
+
+    // Entities without one of Cs... don't count as changed
+    template <typename... Cs>
+    bool ChangedAt(Changed<Cs...>, [[maybe_unused]] size_t index, [[maybe_unused]] uint32_t since) const
+    {
+        return ([&] {
+            static constexpr size_t COMP_TYPE_ID = Pack<Components...>::template index<Cs>;
+            static_assert(COMP_TYPE_ID != -1);
+            const size_t compID = mEntityToComponentIdx[index][COMP_TYPE_ID];
+            return compID != INVALID_COMPONENT_INDEX
+                && std::get<COMP_TYPE_ID>(mRegistries).version(compID) > since;
+        }() && ...);
+    }
+
+    // Raises a type's newest write tick; the relaxed load keeps repeated writes to a line
+    // shared by the worker threads cheap (ParallelForEach marking locations)
+    void RecordWrite(size_t type, uint32_t tick)
+    {
+        std::atomic<uint32_t>& lastWrite = mLastWrites[type];
+        uint32_t seen = lastWrite.load(std::memory_order_relaxed);
+        while (seen < tick
+            && !lastWrite.compare_exchange_weak(seen, tick, std::memory_order_relaxed)) { }
+    }
+
+    template <typename T> T& GetComponentAt(size_t index)
+    {
+        static constexpr size_t COMP_TYPE_ID = Pack<Components...>::template index<T>;
+        static_assert(COMP_TYPE_ID != -1);
+
+        auto& registry = std::get<COMP_TYPE_ID>(mRegistries);
+        const size_t compID = mEntityToComponentIdx[index][COMP_TYPE_ID];
+        assert(registry.valid(compID));
+        return registry[compID];
+    }
+
+    std::vector<Entity> mEntities; // [index], id is INVALID_ENTITY for free slots
+    NameTable mNames;
     static constexpr size_t INVALID_COMPONENT_INDEX = std::numeric_limits<size_t>::max();
     static constexpr size_t NUM_COMPONENTS = Pack<Components...>::size;
 
-    std::tuple<ComponentStorage<Components>...> mRegistries;
-    std::vector<std::array<EntityID, sizeof...(Components)>>
-        mEntityToComponentIdx; // [entID][compID]
-    std::vector<EntityID> mFreeList; // free ent ids
-    std::vector<bool> mValid; // valid ent ids
+    static constexpr char SNAPSHOT_MAGIC[4] = { 'E', 'C', 'S', 'W' };
+    static constexpr uint32_t SNAPSHOT_VERSION = 2;
+
+    // Changes with the component list, order, sizes or storage policies (FNV-1a)
+    static constexpr uint64_t SNAPSHOT_SIGNATURE = [] {
+        uint64_t hash = 14695981039346656037ull;
+        const uint64_t layouts[] = { sizeof(Components) * 4
+            + static_cast<uint64_t>(ComponentStoragePolicy<Components>::value)... };
+        for (uint64_t layout : layouts) {
+            hash = (hash ^ layout) * 1099511628211ull;
+        }
+        return hash;
+    }();
+
+    std::tuple<StorageFor<Components>...> mRegistries;
+    std::vector<std::array<size_t, sizeof...(Components)>>
+        mEntityToComponentIdx; // [index][compID], only read to reach a held component
+    std::vector<ComponentMask> mMasks; // [index], bit compID set while the entity holds it
+    std::vector<uint32_t> mFreeList; // free slot indices
+    std::atomic<uint32_t> mChangeTick { 1 }; // Tick 0 is older than every write
+    std::array<std::atomic<uint32_t>, sizeof...(Components)> mLastWrites {}; // Newest per type
+    std::vector<uint32_t> mGenerations; // [index], generation of the next entity in the slot
+    std::vector<std::vector<EntityID>> mPools; // [PrefabID], released entities awaiting reuse
+
+    // Registered singleton entity per component type (INVALID_ENTITY if none)
+    std::array<EntityID, sizeof...(Components)> mSingletons = MakeSingletons();
+
+    static constexpr std::array<EntityID, sizeof...(Components)> MakeSingletons()
+    {
+        std::array<EntityID, sizeof...(Components)> singletons {};
+        singletons.fill(INVALID_ENTITY);
+        return singletons;
+    }
 };
 
 // Template implementations (must be in header for templates)
 
 template <typename... Components>
-EntityID EntityManager<Components...>::CreateEntity(const std::string& name)
+EntityID EntityManager<Components...>::CreateEntity(NameID name)
 {
-    EntityID ret;
+    uint32_t index;
 
-    // Check if there are any free entity IDs from previously removed entities
+    // Check if there are any free slots from previously removed entities
     if (!mFreeList.empty()) {
 
-        // Reuse a free entity ID
-        ret = mFreeList.back();
+        // Reuse a free slot; its generation was bumped when the old entity was removed
+        index = mFreeList.back();
         mFreeList.pop_back();
-        mValid[ret] = true;
-
-        // Update the entity ID and name in the existing entity slot
-        mEntities[ret].id = ret;
-        mEntities[ret].name = name;
 
     } else {
 
-        // No free IDs available, create a new entity at the end
-        ret = mEntityToComponentIdx.size();
-        mValid.push_back(true);
+        // No free slots available, create a new entity at the end
+        assert(mEntities.size() < std::numeric_limits<uint32_t>::max() && "Out of entity slots!");
+        index = static_cast<uint32_t>(mEntities.size());
+        mGenerations.push_back(0);
 
         // Initialize component index mapping for this entity
         mEntityToComponentIdx.push_back({});
         for (size_t compTypeID = 0; compTypeID < NUM_COMPONENTS; compTypeID++) {
             mEntityToComponentIdx.back()[compTypeID] = INVALID_COMPONENT_INDEX;
         }
+        mMasks.push_back(0);
 
-        // Add entity to the vector for iteration with its ID and name
-        mEntities.push_back(Entity { ret, name });
+        mEntities.emplace_back();
     }
 
+    // Update the entity ID and name in the slot
+    const EntityID ret = MakeEntityID(index, mGenerations[index]);
+    mEntities[index].id = ret;
+    mEntities[index].name = name;
+    mEntities[index].pool = INVALID_PREFAB;
+    mEntities[index].active = true;
+
     return ret;
 }
 
 template <typename... Components> bool EntityManager<Components...>::ValidEntity(EntityID id) const
 {
-    return id < mValid.size() && mValid[id];
+    // Stale IDs carry an old generation; INVALID_ENTITY's index is never in range
+    const uint32_t index = EntityIndex(id);
+    return index < mEntities.size() && mEntities[index].id == id;
 }
 
 template <typename... Components>
 const std::string& EntityManager<Components...>::GetEntityName(EntityID id)
 {
     assert(ValidEntity(id) && "GetName");
-    return mEntities[id].name;
+    return mNames.GetName(mEntities[EntityIndex(id)].name);
 }
 
 template <typename... Components>
@@ -279,26 +1152,26 @@ template <typename... Components> void EntityManager<Components...>::RemoveEntit
     if (!ValidEntity(entity) && "Remove")
         return;
 
-    // Remove all components from this entity
-    for (size_t compTypeID = 0; compTypeID < NUM_COMPONENTS; compTypeID++) {
-        const size_t compID = mEntityToComponentIdx[entity][compTypeID];
+    // Remove all components from this entity, visiting only the held ones
+    const uint32_t index = EntityIndex(entity);
+    for (ComponentMask held = mMasks[index]; held != 0; held &= held - 1) {
+        const size_t compTypeID = static_cast<size_t>(std::countr_zero(held));
 
-        if (compID != INVALID_COMPONENT_INDEX) {
-            // Remove the component from its storage
-            RemoveComponentByIndex(compTypeID, compID);
-            mEntityToComponentIdx[entity][compTypeID] = INVALID_COMPONENT_INDEX;
-        }
+        // Remove the component from its storage
+        RemoveComponentByIndex(compTypeID, mEntityToComponentIdx[index][compTypeID]);
+        mEntityToComponentIdx[index][compTypeID] = INVALID_COMPONENT_INDEX;
     }
+    mMasks[index] = 0;
 
     // Clear data so iterators see an invalid slot
-    mEntities[entity].name.clear();
-    mEntities[entity].id = 0;
+    mEntities[index].name = NameTable::EMPTY_NAME;
+    mEntities[index].id = INVALID_ENTITY;
 
-    // Mark entity as invalid
-    mValid[entity] = false;
+    // Every handle to the old entity is now stale (wraps after 2^32 reuses of one slot)
+    ++mGenerations[index];
 
     // Add to free list for reuse
-    mFreeList.push_back(entity);
+    mFreeList.push_back(index);
 }
 
 }
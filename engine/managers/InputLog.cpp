@@ -0,0 +1,187 @@
+/**
+ * @file InputLog.cpp
+ * @brief Implementation of input recording and replay.
+ */
+
+#include "InputLog.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <iostream>
+
+namespace ECSEngine {
+
+namespace {
+
+constexpr char MAGIC[4] = { 'E', 'C', 'S', 'I' };
+constexpr uint32_t VERSION = 1;
+
+struct InputLogHeader {
+    char magic[4];
+    uint32_t version;
+    uint32_t randomSeed;
+    float fixedTimestep;
+    uint32_t maxStepsPerFrame;
+    uint32_t padding;
+};
+
+static_assert(sizeof(InputLogHeader) == 24, "Input log header must not contain implicit padding");
+
+// Frames store their key count in a uint8_t and scancodes in the top 14 bits of a uint16_t
+static_assert(sf::Keyboard::ScancodeCount <= UINT8_MAX);
+
+template <typename T> void Append(std::vector<uint8_t>& buffer, const T& value)
+{
+    const auto* bytes = reinterpret_cast<const uint8_t*>(&value);
+    buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+template <typename T> bool ReadValue(std::ifstream& file, T& value)
+{
+    return static_cast<bool>(file.read(reinterpret_cast<char*>(&value), sizeof(T)));
+}
+
+}
+
+void InputLogFrame::Apply(InputManager& input) const
+{
+    for (const Key& key : keys) {
+        // A tap leaves the state where it was but produces both edges
+        if (key.tapped) {
+            input.SetKey(key.key, !input.IsKeyDown(key.key));
+            input.SetKey(key.key, !input.IsKeyDown(key.key));
+        }
+        input.SetKey(key.key, key.down);
+    }
+}
+
+InputRecorder::~InputRecorder()
+{
+    if (IsOpen()) {
+        Close();
+    }
+}
+
+bool InputRecorder::Open(const std::string& logPath, const InputLogSettings& settings)
+{
+    mFile.open(logPath, std::ios::binary | std::ios::trunc);
+    if (!mFile.is_open()) {
+        std::cerr << "Error: Could not create input log: " << logPath << std::endl;
+        return false;
+    }
+    mPath = logPath;
+
+    InputLogHeader header {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.randomSeed = settings.randomSeed;
+    header.fixedTimestep = settings.fixedTimestep;
+    header.maxStepsPerFrame = settings.maxStepsPerFrame;
+    mFile.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+    return true;
+}
+
+void InputRecorder::Record(float deltaTime, const InputManager& input)
+{
+    assert(IsOpen() && "Input recorder is not open!");
+
+    const InputManager::KeyBits edges = input.GetKeysPressed() | input.GetKeysReleased();
+
+    std::vector<const WindowEvent*> resizes;
+    for (const WindowEvent& event : input.GetWindowEvents()) {
+        if (event.type == WindowEvent::Type::Resized && resizes.size() < UINT8_MAX) {
+            resizes.push_back(&event);
+        }
+    }
+
+    // Frames are packed, so they are encoded field by field rather than as a struct
+    mBuffer.clear();
+    Append(mBuffer, deltaTime);
+    Append(mBuffer, static_cast<uint8_t>(edges.count()));
+    Append(mBuffer, static_cast<uint8_t>(resizes.size()));
+
+    for (size_t slot = 0; slot < edges.size(); ++slot) {
+        if (!edges.test(slot)) {
+            continue;
+        }
+        const bool down = input.GetKeysDown().test(slot);
+        const bool tapped = input.GetKeysPressed().test(slot) && input.GetKeysReleased().test(slot);
+        Append(mBuffer, static_cast<uint16_t>(slot << 2 | (down ? 2u : 0u) | (tapped ? 1u : 0u)));
+    }
+
+    for (const WindowEvent* resize : resizes) {
+        Append(mBuffer, static_cast<uint32_t>(resize->width));
+        Append(mBuffer, static_cast<uint32_t>(resize->height));
+    }
+
+    mFile.write(reinterpret_cast<const char*>(mBuffer.data()),
+        static_cast<std::streamsize>(mBuffer.size()));
+}
+
+bool InputRecorder::Close()
+{
+    mFile.close();
+    if (!mFile) {
+        std::cerr << "Error: Could not write input log: " << mPath << std::endl;
+        return false;
+    }
+    return true;
+}
+
+bool InputReplay::Open(const std::string& logPath)
+{
+    mFile.open(logPath, std::ios::binary);
+    if (!mFile.is_open()) {
+        std::cerr << "Error: Could not open input log: " << logPath << std::endl;
+        return false;
+    }
+
+    InputLogHeader header;
+    if (!ReadValue(mFile, header) || std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0
+        || header.version != VERSION) {
+        std::cerr << "Error: Not an input log (or an older version): " << logPath << std::endl;
+        mFile.close();
+        return false;
+    }
+
+    mSettings.randomSeed = header.randomSeed;
+    mSettings.fixedTimestep = header.fixedTimestep;
+    mSettings.maxStepsPerFrame = std::max(header.maxStepsPerFrame, 1u);
+    return true;
+}
+
+bool InputReplay::Read(InputLogFrame& frame)
+{
+    uint8_t keyCount;
+    uint8_t resizeCount;
+    if (!IsOpen() || !ReadValue(mFile, frame.deltaTime) || !ReadValue(mFile, keyCount)
+        || !ReadValue(mFile, resizeCount)) {
+        return false;
+    }
+
+    frame.keys.clear();
+    frame.resizes.clear();
+
+    for (uint8_t i = 0; i < keyCount; ++i) {
+        uint16_t packed;
+        if (!ReadValue(mFile, packed)) {
+            return false;
+        }
+        frame.keys.push_back(InputLogFrame::Key { static_cast<sf::Keyboard::Scancode>(packed >> 2),
+            (packed & 2) != 0, (packed & 1) != 0 });
+    }
+
+    for (uint8_t i = 0; i < resizeCount; ++i) {
+        sf::Vector2u size;
+        if (!ReadValue(mFile, size.x) || !ReadValue(mFile, size.y)) {
+            return false;
+        }
+        frame.resizes.push_back(size);
+    }
+
+    return true;
+}
+
+} // namespace ECSEngine
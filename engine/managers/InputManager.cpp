@@ -0,0 +1,82 @@
+/**
+ * @file InputManager.cpp
+ * @brief Implementation of the input event decoder.
+ */
+
+#include "InputManager.h"
+
+namespace ECSEngine {
+
+namespace {
+
+// Scancode::Unknown (and anything newer than the bitset) has no slot
+bool HasSlot(sf::Keyboard::Scancode key)
+{
+    const int code = static_cast<int>(key);
+    return code >= 0 && code < static_cast<int>(sf::Keyboard::ScancodeCount);
+}
+
+} // namespace
+
+void InputManager::BeginFrame()
+{
+    mPressed.reset();
+    mReleased.reset();
+    mWindowEvents.clear();
+}
+
+void InputManager::HandleEvent(const sf::Event& event)
+{
+    if (const auto* keyPressed = event.getIf<sf::Event::KeyPressed>()) {
+        SetKey(keyPressed->scancode, true);
+    } else if (const auto* keyReleased = event.getIf<sf::Event::KeyReleased>()) {
+        SetKey(keyReleased->scancode, false);
+    } else if (event.is<sf::Event::Closed>()) {
+        mWindowEvents.push_back({ WindowEvent::Type::Closed });
+    } else if (const auto* resized = event.getIf<sf::Event::Resized>()) {
+        mWindowEvents.push_back({ WindowEvent::Type::Resized, resized->size.x, resized->size.y });
+    } else if (event.is<sf::Event::FocusLost>()) {
+        ReleaseAll();
+        mWindowEvents.push_back({ WindowEvent::Type::FocusLost });
+    } else if (event.is<sf::Event::FocusGained>()) {
+        mWindowEvents.push_back({ WindowEvent::Type::FocusGained });
+    }
+}
+
+bool InputManager::IsKeyDown(sf::Keyboard::Scancode key) const
+{
+    return HasSlot(key) && mDown.test(static_cast<size_t>(key));
+}
+
+bool InputManager::WasKeyPressed(sf::Keyboard::Scancode key) const
+{
+    return HasSlot(key) && mPressed.test(static_cast<size_t>(key));
+}
+
+bool InputManager::WasKeyReleased(sf::Keyboard::Scancode key) const
+{
+    return HasSlot(key) && mReleased.test(static_cast<size_t>(key));
+}
+
+void InputManager::SetKey(sf::Keyboard::Scancode key, bool down)
+{
+    if (!HasSlot(key))
+        return;
+
+    const size_t slot = static_cast<size_t>(key);
+
+    // Key repeat sends more presses for a held key; only the first one is an edge
+    if (mDown.test(slot) == down)
+        return;
+
+    mDown.set(slot, down);
+    (down ? mPressed : mReleased).set(slot);
+}
+
+void InputManager::ReleaseAll()
+{
+    mReleased |= mDown;
+    mDown.reset();
+}
+
+} // namespace ECSEngine
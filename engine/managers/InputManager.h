@@ -0,0 +1,92 @@
+/**
+ * @file InputManager.h
+ * @brief Frame-level keyboard state and window event queue.
+ */
+#pragma once
+
+#include <bitset>
+#include <vector>
+
+#include <SFML/Window.hpp>
+
+namespace ECSEngine {
+
+/**
+ * @struct WindowEvent
+ * @brief A window-level event (not keyboard input) from this frame's poll.
+ */
+struct WindowEvent {
+    enum class Type { Closed, Resized, FocusLost, FocusGained };
+
+    Type type;
+    unsigned int width = 0; // New size in pixels, for Resized
+    unsigned int height = 0;
+};
+
+/**
+ * @class InputManager
+ * @brief Decodes each SFML event once into key state and a window event queue.
+ * @details ProcessEvents feeds every polled event to HandleEvent() and then copies the key
+ * state to the InputComponents once, so the cost of an event storm (key repeat, mouse
+ * movement) no longer scales with the number of entities.
+ *
+ * Besides which keys are down, the manager keeps the edges of the current frame: keys that
+ * went down or up since BeginFrame(). Losing focus releases every held key, since the
+ * window won't see the key-up events.
+ *
+ * A headless engine has no events; its input script drives the same state through SetKey().
+ *
+ * RESOURCE LIFETIME:
+ * - The edges and GetWindowEvents() are valid until the next BeginFrame(), i.e. for the
+ *   rest of the frame.
+ */
+class InputManager {
+public:
+    using KeyBits = std::bitset<sf::Keyboard::ScancodeCount>;
+
+    InputManager() = default;
+    ~InputManager() = default;
+
+    /**
+     * @brief Forgets the previous frame's edges and window events. Key state is kept.
+     */
+    void BeginFrame();
+
+    /**
+     * @brief Decodes one polled event. Events the manager doesn't track are ignored.
+     */
+    void HandleEvent(const sf::Event& event);
+
+    /**
+     * @brief Presses or releases a key directly, for scripted or recorded input.
+     * @details Same as a key event: changing the state records this frame's edge, setting
+     * the state a key already has does nothing.
+     */
+    void SetKey(sf::Keyboard::Scancode key, bool down);
+
+    // Held this frame
+    bool IsKeyDown(sf::Keyboard::Scancode key) const;
+
+    // Went down / up this frame
+    bool WasKeyPressed(sf::Keyboard::Scancode key) const;
+    bool WasKeyReleased(sf::Keyboard::Scancode key) const;
+
+    const KeyBits& GetKeysDown() const { return mDown; }
+    const KeyBits& GetKeysPressed() const { return mPressed; }
+    const KeyBits& GetKeysReleased() const { return mReleased; }
+
+    /**
+     * @brief Window events since BeginFrame(), in the order they were polled.
+     */
+    const std::vector<WindowEvent>& GetWindowEvents() const { return mWindowEvents; }
+
+private:
+    void ReleaseAll();
+
+    KeyBits mDown;
+    KeyBits mPressed;
+    KeyBits mReleased;
+    std::vector<WindowEvent> mWindowEvents; // Capacity is kept between frames
+};
+
+} // namespace ECSEngine
@@ -0,0 +1,155 @@
+/**
+ * @file RenderManager.cpp
+ * @brief Implementation of sprite batching.
+ */
+
+#include "RenderManager.h"
+
+namespace ECSEngine {
+
+RenderManager::RenderManager()
+    : mChunkIndex(STATIC_CHUNK_SIZE)
+{
+}
+
+void RenderManager::BeginStatic()
+{
+    mStaticChunks.clear();
+    mChunkLookup.clear();
+    mChunkIndex.Clear();
+}
+
+void RenderManager::AddStatic(const sf::Sprite& sprite, const Point2D& worldPos)
+{
+    // Sprites belong to the chunk holding their top-left corner
+    const int64_t key = SpatialGrid::CellKey(
+        mChunkIndex.CellCoord(worldPos.x), mChunkIndex.CellCoord(worldPos.y));
+
+    const sf::IntRect& rect = sprite.getTextureRect();
+    const Rect spriteBounds(worldPos, rect.size.x, rect.size.y);
+
+    auto [it, inserted] = mChunkLookup.try_emplace(key, mStaticChunks.size());
+    if (inserted) {
+        mStaticChunks.emplace_back();
+        mStaticChunks.back().bounds = spriteBounds;
+    }
+
+    StaticChunk& chunk = mStaticChunks[it->second];
+    chunk.bounds |= spriteBounds; // Sprites may hang over the chunk's edge
+    AppendQuad(chunk.batches, chunk.count, sprite, worldPos);
+}
+
+void RenderManager::EndStatic()
+{
+    for (size_t i = 0; i < mStaticChunks.size(); ++i) {
+        StaticChunk& chunk = mStaticChunks[i];
+        mChunkIndex.Insert(i, chunk.bounds);
+
+        // Static geometry is uploaded once; fall back to drawing the vertex array if the
+        // driver has no vertex buffer support
+        for (Batch& batch : chunk.batches) {
+            batch.buffer.reset();
+
+            if (!sf::VertexBuffer::isAvailable()) {
+                continue;
+            }
+
+            const size_t count = batch.vertices.getVertexCount();
+            sf::VertexBuffer buffer(
+                sf::PrimitiveType::Triangles, sf::VertexBuffer::Usage::Static);
+
+            if (buffer.create(count) && buffer.update(&batch.vertices[0], count, 0)) {
+                batch.buffer.emplace(std::move(buffer));
+            }
+        }
+    }
+
+    mStaticDirty = false;
+}
+
+void RenderManager::DrawStatic(
+    sf::RenderWindow& window, const sf::Transform& worldToWindow, const Rect& visibleWorld)
+{
+    mStaticDrawCount = 0;
+
+    // Chunks come back in build order, which keeps overlapping layers drawn back to front
+    mChunkIndex.Query(visibleWorld, mVisibleChunks);
+
+    for (size_t chunkIndex : mVisibleChunks) {
+        const StaticChunk& chunk = mStaticChunks[chunkIndex];
+
+        if (!chunk.bounds.RectIntersect(visibleWorld)) {
+            continue;
+        }
+
+        for (const Batch& batch : chunk.batches) {
+            sf::RenderStates states(worldToWindow);
+            states.texture = batch.texture;
+
+            if (batch.buffer) {
+                window.draw(*batch.buffer, states);
+            } else {
+                window.draw(batch.vertices, states);
+            }
+        }
+
+        mStaticDrawCount += chunk.batches.size();
+    }
+}
+
+void RenderManager::BeginDynamic()
+{
+    mDynamicCount = 0;
+}
+
+void RenderManager::AddDynamic(const sf::Sprite& sprite, const Point2D& windowPos)
+{
+    AppendQuad(mDynamicBatches, mDynamicCount, sprite, windowPos);
+}
+
+void RenderManager::DrawDynamic(sf::RenderWindow& window) const
+{
+    for (size_t i = 0; i < mDynamicCount; ++i) {
+        const Batch& batch = mDynamicBatches[i];
+        window.draw(batch.vertices, sf::RenderStates(batch.texture));
+    }
+}
+
+void RenderManager::AppendQuad(
+    std::vector<Batch>& batches, size_t& count, const sf::Sprite& sprite, const Point2D& topLeft)
+{
+    const sf::Texture* texture = &sprite.getTexture();
+
+    // Only consecutive sprites can share a batch, otherwise draw order would change
+    if (count == 0 || batches[count - 1].texture != texture) {
+        if (count == batches.size()) {
+            batches.emplace_back();
+        }
+
+        batches[count].texture = texture;
+        batches[count].vertices.clear();
+        ++count;
+    }
+
+    const sf::IntRect& rect = sprite.getTextureRect();
+    const float w = static_cast<float>(rect.size.x);
+    const float h = static_cast<float>(rect.size.y);
+    const float u = static_cast<float>(rect.position.x);
+    const float v = static_cast<float>(rect.position.y);
+
+    const sf::Vertex topLeftVertex { { topLeft.x, topLeft.y }, sf::Color::White, { u, v } };
+    const sf::Vertex topRight { { topLeft.x + w, topLeft.y }, sf::Color::White, { u + w, v } };
+    const sf::Vertex bottomLeft { { topLeft.x, topLeft.y + h }, sf::Color::White, { u, v + h } };
+    const sf::Vertex bottomRight { { topLeft.x + w, topLeft.y + h }, sf::Color::White,
+        { u + w, v + h } };
+
+    sf::VertexArray& vertices = batches[count - 1].vertices;
+    vertices.append(topLeftVertex);
+    vertices.append(topRight);
+    vertices.append(bottomLeft);
+    vertices.append(topRight);
+    vertices.append(bottomRight);
+    vertices.append(bottomLeft);
+}
+
+} // namespace ECSEngine
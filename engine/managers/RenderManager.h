@@ -0,0 +1,130 @@
+/**
+ * @file RenderManager.h
+ * @brief Batches sprites into vertex arrays so each texture costs a single draw call.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "../core/MathUtil.h"
+#include "../core/SpatialGrid.h"
+
+#include <SFML/Graphics.hpp>
+
+namespace ECSEngine {
+
+/**
+ * @class RenderManager
+ * @brief Turns sprites into textured triangles grouped by texture.
+ * @details Sprites are collected into batches: a new batch starts whenever the texture changes
+ * from the previous sprite, so draw order is preserved exactly while a run of sprites sharing a
+ * sheet collapses into one draw call.
+ *
+ * Two kinds of batches are kept:
+ * - Static batches hold world-space geometry that never moves (map layers). They are built
+ *   once, uploaded to a GPU vertex buffer when available, and drawn every frame with the camera
+ *   transform. Rebuild them by calling MarkStaticDirty() after changing a static sprite.
+ *   The geometry is split into square chunks of STATIC_CHUNK_SIZE world units, indexed by a
+ *   SpatialGrid, so only the chunks overlapping the visible world rect are drawn.
+ * - Dynamic batches are rebuilt every frame from window-space positions and drawn on top.
+ *
+ * RESOURCE LIFETIME:
+ * - Batches keep pointers to the textures owned by SpriteManager, so the SpriteManager must
+ *   outlive the RenderManager (or the static batches must be rebuilt).
+ */
+class RenderManager {
+public:
+    // Side length of a static geometry chunk in world units
+    static constexpr float STATIC_CHUNK_SIZE = 512.0f;
+
+    RenderManager();
+    ~RenderManager() = default;
+
+    /**
+     * @brief Requests a rebuild of the static batches on the next frame.
+     */
+    void MarkStaticDirty() { mStaticDirty = true; }
+
+    bool IsStaticDirty() const { return mStaticDirty; }
+
+    /**
+     * @brief Discards the cached static geometry and starts collecting new static sprites.
+     */
+    void BeginStatic();
+
+    /**
+     * @brief Appends a static sprite to the cached geometry.
+     * @param sprite Sprite providing the texture and texture rect
+     * @param worldPos World position of the sprite's top-left corner
+     */
+    void AddStatic(const sf::Sprite& sprite, const Point2D& worldPos);
+
+    /**
+     * @brief Finishes the static build and uploads the geometry.
+     */
+    void EndStatic();
+
+    /**
+     * @brief Draws the cached static chunks that overlap the visible region.
+     * @param window Window to draw into
+     * @param worldToWindow Camera transform from world to window coordinates
+     * @param visibleWorld World-space region covered by the window
+     */
+    void DrawStatic(sf::RenderWindow& window, const sf::Transform& worldToWindow,
+        const Rect& visibleWorld);
+
+    /**
+     * @brief Starts collecting this frame's dynamic sprites.
+     */
+    void BeginDynamic();
+
+    /**
+     * @brief Appends a sprite to this frame's dynamic batches.
+     * @param sprite Sprite providing the texture and texture rect
+     * @param windowPos Window position of the sprite's top-left corner
+     */
+    void AddDynamic(const sf::Sprite& sprite, const Point2D& windowPos);
+
+    /**
+     * @brief Draws the dynamic batches collected since BeginDynamic().
+     */
+    void DrawDynamic(sf::RenderWindow& window) const;
+
+    // Draw calls issued by the last DrawStatic() and DrawDynamic() respectively
+    size_t GetStaticDrawCount() const { return mStaticDrawCount; }
+    size_t GetDynamicDrawCount() const { return mDynamicCount; }
+
+private:
+    struct Batch {
+        const sf::Texture* texture = nullptr;
+        sf::VertexArray vertices { sf::PrimitiveType::Triangles };
+        std::optional<sf::VertexBuffer> buffer; // GPU copy for static batches
+    };
+
+    // Appends the two triangles of a sprite quad, starting a new batch on texture change
+    static void AppendQuad(std::vector<Batch>& batches, size_t& count, const sf::Sprite& sprite,
+        const Point2D& topLeft);
+
+    struct StaticChunk {
+        Rect bounds; // Union of the sprites in the chunk
+        std::vector<Batch> batches;
+        size_t count = 0;
+    };
+
+    std::vector<StaticChunk> mStaticChunks;
+    std::unordered_map<int64_t, size_t> mChunkLookup; // Grid cell key -> mStaticChunks index
+    SpatialGrid mChunkIndex; // Chunk bounds, queried with the visible rect
+    std::vector<size_t> mVisibleChunks; // Scratch space for DrawStatic()
+    size_t mStaticDrawCount = 0;
+    bool mStaticDirty = true;
+
+    // Reused across frames; only the first mDynamicCount batches are live
+    std::vector<Batch> mDynamicBatches;
+    size_t mDynamicCount = 0;
+};
+
+} // namespace ECSEngine
@@ -3,33 +3,184 @@
  * @brief Implementation of sound effect management.
  */
 
+#include <algorithm>
+
+#include "AssetCache.h"
 #include "SoundManager.h"
 
 namespace ECSEngine {
 
-void SoundManager::RegisterSound(const std::string& soundPath, const std::string& soundName)
+SoundID SoundManager::RegisterSound(
+    const std::string& soundPath, const std::string& soundName, SoundSettings settings)
 {
+    assert(settings.maxVoices > 0 && "A sound needs at least one voice!");
+
+    auto existing = mSoundNames.find(soundName);
+    if (existing != mSoundNames.end()) {
+        return existing->second;
+    }
+
     // Load A Soundbuffer From a File
-    if (mSoundBuffers.find(soundName) == mSoundBuffers.end()) { // !exist.
+    SoundEntry entry;
+    const bool loaded = mHeadless
+        || (mAssetCache ? mAssetCache->LoadSound(soundPath, entry.buffer)
+                        : entry.buffer.loadFromFile(soundPath));
+    if (!loaded) {
+        std::cerr << "Error: Could not load sound." << std::endl;
+    }
+    entry.settings = settings;
 
-        sf::SoundBuffer soundBuffer;
-        if (!soundBuffer.loadFromFile(soundPath)) {
-            std::cerr << "Error: Could not load sound." << std::endl;
-        }
+    const SoundID id = mSounds.size();
+    mSounds.push_back(std::move(entry));
+    mSoundNames.emplace(soundName, id);
+    return id;
+}
+
+SoundID SoundManager::RegisterSoundAsync(const std::string& soundPath,
+    const std::string& soundName, SoundSettings settings, AssetLoader& loader)
+{
+    assert(settings.maxVoices > 0 && "A sound needs at least one voice!");
+
+    auto existing = mSoundNames.find(soundName);
+    if (existing != mSoundNames.end()) {
+        return existing->second;
+    }
+
+    SoundEntry entry;
+    entry.settings = settings;
+    entry.loading = !mHeadless;
+
+    const SoundID id = mSounds.size();
+    mSounds.push_back(std::move(entry));
+    mSoundNames.emplace(soundName, id);
 
-        mSoundBuffers.emplace(soundName, std::move(soundBuffer));
+    if (mHeadless) {
+        return id;
     }
 
-    // Creating and Store the Sound
-    sf::Sound sound(mSoundBuffers[soundName]);
-    mSounds.emplace(soundName, std::move(sound));
+    // Decoded into a buffer of its own; the entry is only touched on the main thread
+    auto decoded = std::make_shared<sf::SoundBuffer>();
+    auto loaded = std::make_shared<bool>(false);
+
+    loader.Submit(
+        [decoded, loaded, soundPath, cache = mAssetCache] {
+            *loaded = cache ? cache->LoadSound(soundPath, *decoded)
+                            : decoded->loadFromFile(soundPath);
+        },
+        [this, decoded, loaded, id] {
+            SoundEntry& target = mSounds[id];
+            target.loading = false;
+            if (!*loaded) {
+                std::cerr << "Error: Could not load sound." << std::endl;
+                return;
+            }
+            target.buffer = std::move(*decoded);
+        });
+
+    return id;
+}
+
+SoundID SoundManager::FindSound(const std::string& soundName) const
+{
+    auto it = mSoundNames.find(soundName);
+    return it == mSoundNames.end() ? INVALID_SOUND : it->second;
+}
+
+void SoundManager::QueueSound(SoundID sound)
+{
+    if (sound == INVALID_SOUND || mHeadless)
+        return;
+
+    assert(sound < mSounds.size() && "Unknown SoundID!");
+    mQueue.push_back(sound);
 }
 
 void SoundManager::PlaySound(const std::string& soundName)
 {
-    auto theSound = mSounds.find(soundName);
-    assert(theSound != mSounds.end() && "Sound not found!");
-    theSound->second.play();
+    const SoundID sound = FindSound(soundName);
+    assert(sound != INVALID_SOUND && "Sound not found!");
+    QueueSound(sound);
+}
+
+void SoundManager::Flush()
+{
+    // Same sound queued twice this frame only starts once
+    std::sort(mQueue.begin(), mQueue.end());
+    mQueue.erase(std::unique(mQueue.begin(), mQueue.end()), mQueue.end());
+
+    for (SoundID sound : mQueue) {
+        if (mSounds[sound].loading)
+            continue;
+
+        Voice* voice = PickVoice(sound);
+        if (!voice)
+            continue;
+
+        const SoundEntry& entry = mSounds[sound];
+        if (voice->sound) {
+            voice->sound->stop();
+            voice->sound->setBuffer(entry.buffer);
+        } else {
+            voice->sound.emplace(entry.buffer);
+        }
+        voice->sound->setVolume(entry.settings.volume);
+        voice->sound->play();
+
+        voice->playing = sound;
+        voice->started = ++mStartCount;
+    }
+
+    mQueue.clear();
+}
+
+bool SoundManager::IsPlaying(const Voice& voice) const
+{
+    return voice.sound && voice.sound->getStatus() == sf::SoundSource::Status::Playing;
+}
+
+SoundManager::Voice* SoundManager::PickVoice(SoundID sound)
+{
+    const SoundSettings& settings = mSounds[sound].settings;
+
+    Voice* idle = nullptr;
+    Voice* oldestSame = nullptr;
+    Voice* victim = nullptr; // Oldest voice of the lowest priority that may be stolen
+    int sameCount = 0;
+
+    for (Voice& voice : mVoices) {
+        if (!IsPlaying(voice)) {
+            idle = idle ? idle : &voice;
+            continue;
+        }
+
+        if (voice.playing == sound) {
+            ++sameCount;
+            if (!oldestSame || voice.started < oldestSame->started) {
+                oldestSame = &voice;
+            }
+        }
+
+        const int priority = mSounds[voice.playing].settings.priority;
+        if (priority > settings.priority) {
+            continue;
+        }
+
+        if (!victim) {
+            victim = &voice;
+            continue;
+        }
+        const int victimPriority = mSounds[victim->playing].settings.priority;
+        if (priority < victimPriority
+            || (priority == victimPriority && voice.started < victim->started)) {
+            victim = &voice;
+        }
+    }
+
+    // At its cap: restart its oldest instance rather than taking another voice
+    if (sameCount >= settings.maxVoices) {
+        return oldestSame;
+    }
+    return idle ? idle : victim;
 }
 
-} // namespace ECSEngine
\ No newline at end of file
+} // namespace ECSEngine
@@ -4,50 +4,154 @@
  */
 #pragma once
 
+#include <array>
 #include <cassert>
+#include <cstdint>
+#include <deque>
 #include <iostream>
+#include <limits>
+#include <memory>
+#include <optional>
+#include <string>
 #include <unordered_map>
+#include <vector>
 
 #include <SFML/Audio.hpp>
 
+#include "AssetLoader.h"
+
 namespace ECSEngine {
 
+class AssetCache;
+
+// Handle to a registered sound effect, the index of its buffer
+using SoundID = size_t;
+inline constexpr SoundID INVALID_SOUND = std::numeric_limits<SoundID>::max();
+
+/**
+ * @struct SoundSettings
+ * @brief How a sound effect competes for voices.
+ */
+struct SoundSettings {
+    int maxVoices = 4; // Playing at once; the oldest one is restarted beyond that
+    int priority = 0; // A full pool steals the oldest voice of the lowest priority <= this
+    float volume = 100.0f; // 0 to 100
+};
+
 /**
  * @class SoundManager
  * @brief Manages sound effects and music playback.
- * @details Handles sound loading, caching, and playback. Sounds are registered by
- * name and can be played multiple times. SoundBuffers are cached to avoid reloading.
+ * @details Handles sound loading, caching, and playback. Sounds are registered once, by
+ * name, and played through the SoundID that RegisterSound() returns, so playing a sound
+ * costs no string lookup.
+ *
+ * Playback is queued with QueueSound() and started by Flush(), once per frame. Flush() plays
+ * the queued sounds on a fixed pool of MAX_VOICES voices. Each sound may hold at most
+ * SoundSettings::maxVoices of them (rapid pickups overlap instead of cutting each other
+ * off), and when the pool is full a sound steals the oldest voice of equal or lower
+ * priority, or is dropped.
+ *
+ * RegisterSoundAsync() decodes the file on an AssetLoader instead. Its SoundID is valid at
+ * once; queueing it before the buffer arrives plays nothing. With an AssetCache set, both
+ * register paths decode through it.
  *
  * RESOURCE LIFETIME:
- * - Sounds and SoundBuffers are stored internally and remain valid for the lifetime
- *   of the SoundManager.
+ * - SoundBuffers are stored internally and remain valid for the lifetime of the
+ *   SoundManager. SoundIDs never change.
  *
- * - Sound names must be unique. Registering a sound with an existing name will
- *   reuse the cached SoundBuffer but create a new Sound instance.
+ * - Sound names must be unique. Registering a sound with an existing name returns the
+ *   existing SoundID and keeps its buffer and settings.
  *
- * - Sounds can be played concurrently by calling PlaySound() multiple times.
+ * - Not thread safe. Systems that queue sounds declare Writes<SoundManager>, which the
+ *   Scheduler runs one at a time.
  */
 class SoundManager {
 public:
+    static constexpr size_t MAX_VOICES = 16;
+
     SoundManager() = default;
     ~SoundManager() = default;
 
     /**
      * @brief Registers a sound effect with a given name.
      * @param soundPath Path to the sound file to load
-     * @param soundName Name to use when playing this sound
+     * @param soundName Name to use when looking this sound up
+     * @param settings Voice limits and priority for this sound
+     * @return SoundID to pass to QueueSound()
+     */
+    SoundID RegisterSound(
+        const std::string& soundPath, const std::string& soundName, SoundSettings settings = {});
+
+    /**
+     * @brief Registers a sound effect whose file is decoded on the loader's thread.
+     * @details Like RegisterSound(), but the sound is silent until loader completes the job.
+     * @param loader Loader decoding the file
+     * @return SoundID to pass to QueueSound(), usable immediately
+     */
+    SoundID RegisterSoundAsync(const std::string& soundPath, const std::string& soundName,
+        SoundSettings settings, AssetLoader& loader);
+
+    /**
+     * @brief Looks up a registered sound.
+     * @return Its SoundID, or INVALID_SOUND if no sound has that name
      */
-    void RegisterSound(const std::string& soundPath, const std::string& soundName);
+    SoundID FindSound(const std::string& soundName) const;
 
     /**
-     * @brief Plays a sound effect by name.
+     * @brief Decodes sounds registered from now on through a cache (nullptr to stop).
+     * @param cache Must outlive this SoundManager and its pending loads
+     */
+    void SetAssetCache(const AssetCache* cache) { mAssetCache = cache; }
+
+    /**
+     * @brief Turns audio off for a headless engine.
+     * @details Sounds registered from now on get SoundIDs but are never decoded, and
+     * QueueSound() drops everything, so no audio device is ever opened.
+     */
+    void SetHeadless(bool headless) { mHeadless = headless; }
+
+    /**
+     * @brief Queues a sound to start at the next Flush(). INVALID_SOUND is ignored.
+     */
+    void QueueSound(SoundID sound);
+
+    /**
+     * @brief Queues a sound effect by name.
      * @param soundName Name of the sound (must be registered first)
      */
     void PlaySound(const std::string& soundName);
 
+    /**
+     * @brief Starts this frame's queued sounds on the voice pool.
+     * @details A sound queued several times in one frame starts once.
+     */
+    void Flush();
+
 private:
-    std::unordered_map<std::string, sf::SoundBuffer> mSoundBuffers;
-    std::unordered_map<std::string, sf::Sound> mSounds;
+    struct SoundEntry {
+        sf::SoundBuffer buffer;
+        SoundSettings settings;
+        bool loading = false; // Waiting for an AssetLoader job; Flush() skips it
+    };
+
+    struct Voice {
+        std::optional<sf::Sound> sound; // Created on first use (sf::Sound needs a buffer)
+        SoundID playing = INVALID_SOUND;
+        uint64_t started = 0; // Flush order, to find the oldest voice
+    };
+
+    bool IsPlaying(const Voice& voice) const;
+
+    // The voice a new instance of sound should take over, or nullptr to drop it
+    Voice* PickVoice(SoundID sound);
+
+    std::deque<SoundEntry> mSounds; // [SoundID], a deque never moves the buffers voices point at
+    std::unordered_map<std::string, SoundID> mSoundNames;
+    std::array<Voice, MAX_VOICES> mVoices;
+    std::vector<SoundID> mQueue;
+    uint64_t mStartCount = 0;
+    const AssetCache* mAssetCache = nullptr;
+    bool mHeadless = false;
 };
 
-} // namespace ECSEngine
\ No newline at end of file
+} // namespace ECSEngine
@@ -8,33 +8,261 @@
  */
 
 #include "SpriteManager.h"
+
+#include "AssetCache.h"
+
+#include <algorithm>
 #include <iostream>
+#include <numeric>
+
+#include <SFML/Graphics.hpp>
 
 namespace ECSEngine {
 
+namespace {
+
+    // Gap between packed sheets so filtering never samples a neighbour
+    constexpr unsigned int ATLAS_PADDING = 2;
+
+}
+
 [[nodiscard]] SpriteID SpriteManager::RegisterTexture(
     const std::string& texturePath, const Rect& sourceRect)
 {
+    return RegisterSprite(LoadTexture(texturePath), sourceRect);
+}
+
+[[nodiscard]] TextureID SpriteManager::LoadTexture(const std::string& texturePath)
+{
+    auto it = mTextureLookup.find(texturePath);
+    if (it != mTextureLookup.end()) {
+        return it->second;
+    }
+
     // Load a texture from a file
-    if (mTextures.find(texturePath) == mTextures.end()) { // !exist.
-        sf::Texture texture(texturePath);
-        if (!texture.loadFromFile(texturePath)) {
-            std::cerr << "Error: Could not load texture: " << texturePath << std::endl;
-            assert(false && "Failed to load texture!");
-        }
+    auto texture = std::make_unique<sf::Texture>();
+    sf::Image image;
+    const bool loaded = mHeadless
+        || (mAssetCache
+                ? mAssetCache->LoadImage(texturePath, image) && texture->loadFromImage(image)
+                : texture->loadFromFile(texturePath));
+    if (!loaded) {
+        std::cerr << "Error: Could not load texture: " << texturePath << std::endl;
+        assert(false && "Failed to load texture!");
+    }
+
+    const TextureID id = mEntries.size();
+    mEntries.push_back(TextureEntry { texturePath, mTextures.size(), { 0, 0 }, false });
+    mTextures.push_back(std::move(texture));
+    mTextureLookup.emplace(texturePath, id);
+
+    return id;
+}
+
+[[nodiscard]] TextureID SpriteManager::LoadTextureAsync(
+    const std::string& texturePath, AssetLoader& loader)
+{
+    auto it = mTextureLookup.find(texturePath);
+    if (it != mTextureLookup.end()) {
+        return it->second;
+    }
 
-        mTextures.emplace(texturePath, std::move(texture));
+    // Sprites point at this texture from now on; the upload fills it in place
+    const TextureID id = mEntries.size();
+    const size_t slot = mTextures.size();
+    mEntries.push_back(TextureEntry { texturePath, slot, { 0, 0 }, false, !mHeadless });
+    mTextures.push_back(std::make_unique<sf::Texture>());
+    mTextureLookup.emplace(texturePath, id);
+
+    if (mHeadless) {
+        return id;
+    }
+
+    struct Decoded {
+        sf::Image image;
+        bool loaded = false;
+    };
+    auto decoded = std::make_shared<Decoded>();
+
+    loader.Submit(
+        [decoded, texturePath, cache = mAssetCache] {
+            decoded->loaded = cache ? cache->LoadImage(texturePath, decoded->image)
+                                    : decoded->image.loadFromFile(texturePath);
+        },
+        [this, decoded, id, slot] {
+            mEntries[id].loading = false;
+            if (!decoded->loaded || !mTextures[slot]->loadFromImage(decoded->image)) {
+                std::cerr << "Error: Could not load texture: " << mEntries[id].path << std::endl;
+            }
+        });
+
+    return id;
+}
+
+bool SpriteManager::IsLoading(TextureID texture) const
+{
+    assert(texture < mEntries.size() && "Unknown texture!");
+    return mEntries[texture].loading;
+}
+
+[[nodiscard]] SpriteID SpriteManager::RegisterSprite(TextureID texture, const Rect& sourceRect)
+{
+    assert(texture < mEntries.size() && "Unknown texture!");
+    const TextureEntry& entry = mEntries[texture];
+
+    const SpriteKey key { entry.slot, static_cast<int>(sourceRect.topLeft.x) + entry.offset.x,
+        static_cast<int>(sourceRect.topLeft.y) + entry.offset.y, sourceRect.width,
+        sourceRect.height };
+
+    auto it = mSpriteLookup.find(key);
+    if (it != mSpriteLookup.end()) {
+        return it->second;
     }
 
+    return CreateSprite(key);
+}
+
+SpriteID SpriteManager::CreateSprite(const SpriteKey& key)
+{
     // Creating the Sprite
-    sf::Sprite sprite(mTextures[texturePath]);
+    sf::Sprite sprite(*mTextures[key.slot]);
 
-    sprite.setTextureRect(sf::IntRect(sf::Vector2i(sourceRect.topLeft.x, sourceRect.topLeft.y),
-        sf::Vector2i(sourceRect.width, sourceRect.height)));
+    sprite.setTextureRect(sf::IntRect(
+        sf::Vector2i(key.left, key.top), sf::Vector2i(key.width, key.height)));
 
+    const SpriteID id = mSprites.size();
     mSprites.emplace_back(std::move(sprite));
+    mSpriteKeys.push_back(key);
+    mSpriteLookup.emplace(key, id);
+
+    return id;
+}
+
+bool SpriteManager::BuildAtlas(const std::vector<std::string>& texturePaths)
+{
+    if (mHeadless) {
+        return false; // Nothing was uploaded to pack
+    }
+
+    // Gather the distinct sheets to pack
+    std::vector<TextureID> sheets;
+    for (const std::string& path : texturePaths) {
+        const TextureID id = LoadTexture(path);
+
+        if (mEntries[id].inAtlas) {
+            std::cerr << "Error: Texture is already in an atlas: " << path << std::endl;
+            return false;
+        }
+
+        if (mEntries[id].loading) {
+            std::cerr << "Error: Texture is still loading: " << path << std::endl;
+            return false;
+        }
+
+        if (std::find(sheets.begin(), sheets.end(), id) == sheets.end()) {
+            sheets.push_back(id);
+        }
+    }
+
+    if (sheets.size() < 2) {
+        return false; // Nothing to gain
+    }
+
+    // Shelf packing: tallest sheets first, each shelf as wide as the GPU allows
+    std::vector<sf::Vector2u> sizes;
+    for (TextureID id : sheets) {
+        sizes.push_back(mTextures[mEntries[id].slot]->getSize());
+    }
+
+    std::vector<size_t> order(sheets.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(),
+        [&](size_t a, size_t b) { return sizes[a].y > sizes[b].y; });
+
+    const unsigned int maxSize = sf::Texture::getMaximumSize();
+    std::vector<sf::Vector2u> positions(sheets.size());
+    unsigned int x = 0, y = 0, shelfHeight = 0;
+    sf::Vector2u atlasSize(0, 0);
+
+    for (size_t i : order) {
+        const sf::Vector2u size = sizes[i];
+
+        if (x > 0 && x + size.x > maxSize) {
+            y += shelfHeight + ATLAS_PADDING;
+            x = 0;
+            shelfHeight = 0;
+        }
+
+        if (x + size.x > maxSize || y + size.y > maxSize) {
+            std::cerr << "Error: Sprite sheets do not fit in a " << maxSize << "x" << maxSize
+                      << " atlas" << std::endl;
+            return false;
+        }
+
+        positions[i] = sf::Vector2u(x, y);
+        atlasSize.x = std::max(atlasSize.x, x + size.x);
+        atlasSize.y = std::max(atlasSize.y, y + size.y);
+        shelfHeight = std::max(shelfHeight, size.y);
+        x += size.x + ATLAS_PADDING;
+    }
+
+    // Copy every sheet into the atlas image and upload it
+    sf::Image atlasImage(atlasSize, sf::Color::Transparent);
+    for (size_t i = 0; i < sheets.size(); ++i) {
+        const sf::Image sheet = mTextures[mEntries[sheets[i]].slot]->copyToImage();
+
+        if (!atlasImage.copy(sheet, positions[i])) {
+            std::cerr << "Error: Could not copy " << mEntries[sheets[i]].path << " into atlas"
+                      << std::endl;
+            return false;
+        }
+    }
+
+    auto atlas = std::make_unique<sf::Texture>();
+    if (!atlas->loadFromImage(atlasImage)) {
+        std::cerr << "Error: Could not create atlas texture" << std::endl;
+        return false;
+    }
+
+    // Point the packed paths at the atlas and drop their own textures
+    const size_t atlasSlot = mTextures.size();
+    std::unordered_map<size_t, sf::Vector2i> movedSlots; // Old slot -> offset in atlas
+
+    for (size_t i = 0; i < sheets.size(); ++i) {
+        TextureEntry& entry = mEntries[sheets[i]];
+        const sf::Vector2i offset(positions[i]);
+
+        movedSlots.emplace(entry.slot, offset);
+        mTextures[entry.slot].reset();
+
+        entry.slot = atlasSlot;
+        entry.offset = offset;
+        entry.inAtlas = true;
+    }
+
+    mTextures.push_back(std::move(atlas));
+
+    // Rebind existing sprites, keeping their IDs
+    for (SpriteID id = 0; id < mSprites.size(); ++id) {
+        SpriteKey& key = mSpriteKeys[id];
+
+        auto moved = movedSlots.find(key.slot);
+        if (moved == movedSlots.end()) {
+            continue;
+        }
+
+        mSpriteLookup.erase(key);
+        key.slot = atlasSlot;
+        key.left += moved->second.x;
+        key.top += moved->second.y;
+        mSpriteLookup.emplace(key, id);
+
+        mSprites[id].setTexture(*mTextures[atlasSlot]);
+        mSprites[id].setTextureRect(sf::IntRect(
+            sf::Vector2i(key.left, key.top), sf::Vector2i(key.width, key.height)));
+    }
 
-    return mSprites.size() - 1;
+    return true;
 }
 
 sf::Sprite& SpriteManager::GetSprite(SpriteID id)
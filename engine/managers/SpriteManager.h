@@ -9,24 +9,41 @@
 #pragma once
 
 #include <cassert>
+#include <cstdint>
+#include <memory>
+#include <string>
 #include <unordered_map>
 #include <vector>
 
 #include "../core/MathUtil.h"
+#include "AssetLoader.h"
 
 #include <SFML/Graphics/Sprite.hpp>
 #include <SFML/Graphics/Texture.hpp>
 
 namespace ECSEngine {
 
+class AssetCache;
+
 using SpriteID = size_t;
+using TextureID = size_t;
 
 /**
  * @class SpriteManager
  * @brief Manages sprites and their associated textures.
  * @details Handles texture loading, caching, and sprite creation. Textures are
- * stored in an unordered_map to ensure stable memory addresses (required by SFML).
- * Sprites are stored in a vector and accessed by SpriteID (the vector index).
+ * heap-allocated to ensure stable memory addresses (required by SFML) and looked up by
+ * path once per texture. Sprites are stored in a vector and accessed by SpriteID (the
+ * vector index); registering the same (texture, rect) pair again returns the same SpriteID.
+ *
+ * LoadTextureAsync() hands out the TextureID at once and decodes the file on an
+ * AssetLoader. Sprites of a loading texture can be registered and drawn right away; they
+ * show nothing until the upload, which fills in the same sf::Texture object. With an
+ * AssetCache set, both load paths decode through it.
+ *
+ * BuildAtlas() can pack several sprite sheets into a single texture so the RenderManager
+ * batches them together. Sprites of packed sheets are rebound to the atlas, and later
+ * registrations against a packed path resolve to the atlas as well.
  *
  * RESOURCE LIFETIME:
  * - sf::Sprite references (from GetSprite()) are valid until the SpriteManager
@@ -36,6 +53,9 @@ using SpriteID = size_t;
  *   times reuses the existing texture.
  *
  * - SpriteIDs remain stable and valid for the lifetime of the SpriteManager.
+ *
+ * - BuildAtlas() releases the packed source textures. Anything caching texture pointers
+ *   (the RenderManager's static batches) must be rebuilt afterwards.
  */
 class SpriteManager {
 public:
@@ -50,6 +70,60 @@ public:
      */
     [[nodiscard]] SpriteID RegisterTexture(const std::string& texturePath, const Rect& sourceRect);
 
+    /**
+     * @brief Loads a texture (or finds the cached one) without creating a sprite.
+     * @param texturePath Path to the texture file to load
+     * @return TextureID to pass to RegisterSprite()
+     */
+    [[nodiscard]] TextureID LoadTexture(const std::string& texturePath);
+
+    /**
+     * @brief Starts loading a texture on the loader's thread, or finds the cached one.
+     * @details The texture is empty until loader completes the job (AssetLoader::Update()).
+     * @param texturePath Path to the texture file to load
+     * @param loader Loader decoding the image
+     * @return TextureID to pass to RegisterSprite(), usable immediately
+     */
+    [[nodiscard]] TextureID LoadTextureAsync(const std::string& texturePath, AssetLoader& loader);
+
+    /**
+     * @brief Checks whether a texture still waits for its asynchronous upload.
+     */
+    bool IsLoading(TextureID texture) const;
+
+    /**
+     * @brief Decodes textures loaded from now on through a cache (nullptr to stop).
+     * @param cache Must outlive this SpriteManager and its pending loads
+     */
+    void SetAssetCache(const AssetCache* cache) { mAssetCache = cache; }
+
+    /**
+     * @brief Stops decoding and uploading textures, for a headless engine.
+     * @details Textures loaded from now on keep their TextureIDs but stay empty, so sprites
+     * still register (with the rects simulation code reads) without a GL context.
+     * BuildAtlas() does nothing while headless.
+     */
+    void SetHeadless(bool headless) { mHeadless = headless; }
+
+    /**
+     * @brief Creates a sprite from an already loaded texture, reusing an identical one.
+     * @details Avoids hashing the texture path when registering many sprites of one sheet.
+     * @param texture TextureID returned from LoadTexture()
+     * @param sourceRect The portion of the texture to use for this sprite
+     * @return SpriteID that can be used with GetSprite()
+     */
+    [[nodiscard]] SpriteID RegisterSprite(TextureID texture, const Rect& sourceRect);
+
+    /**
+     * @brief Packs the given sprite sheets into one atlas texture.
+     * @details Sheets are placed on shelves sorted by height, limited by the maximum texture
+     * size. Sheets that are not loaded yet are loaded first; sheets still loading
+     * asynchronously make it fail (AssetLoader::Finish() first). On failure nothing changes.
+     * @param texturePaths Paths of the sheets to pack
+     * @return True if the atlas was built and all affected sprites were rebound
+     */
+    bool BuildAtlas(const std::vector<std::string>& texturePaths);
+
     /**
      * @brief Gets a reference to a sprite by its ID.
      * @param id The SpriteID returned from RegisterTexture()
@@ -57,9 +131,47 @@ public:
      */
     sf::Sprite& GetSprite(SpriteID id);
 
+    size_t GetSpriteCount() const { return mSprites.size(); }
+
 private:
-    std::unordered_map<std::string, sf::Texture> mTextures;
+    // Where a path's pixels live: its own texture, or a region of an atlas
+    struct TextureEntry {
+        std::string path;
+        size_t slot; // Index into mTextures
+        sf::Vector2i offset; // Top-left of the sheet within that texture
+        bool inAtlas;
+        bool loading = false; // Waiting for an AssetLoader upload
+    };
+
+    // Identifies a sprite by the texture slot it samples and its source rect in texels
+    struct SpriteKey {
+        size_t slot;
+        int left, top, width, height;
+
+        bool operator==(const SpriteKey&) const = default;
+    };
+
+    struct SpriteKeyHash {
+        size_t operator()(const SpriteKey& key) const
+        {
+            uint64_t hash = key.slot;
+            for (int value : { key.left, key.top, key.width, key.height }) {
+                hash = hash * 1099511628211ULL ^ static_cast<uint32_t>(value);
+            }
+            return static_cast<size_t>(hash);
+        }
+    };
+
+    SpriteID CreateSprite(const SpriteKey& key);
+
+    std::vector<std::unique_ptr<sf::Texture>> mTextures; // Null once packed into an atlas
+    std::vector<TextureEntry> mEntries; // Indexed by TextureID
+    std::unordered_map<std::string, TextureID> mTextureLookup;
     std::vector<sf::Sprite> mSprites;
+    std::vector<SpriteKey> mSpriteKeys; // Parallel to mSprites
+    std::unordered_map<SpriteKey, SpriteID, SpriteKeyHash> mSpriteLookup;
+    const AssetCache* mAssetCache = nullptr;
+    bool mHeadless = false;
 };
 
 } // namespace ECSEngine
\ No newline at end of file
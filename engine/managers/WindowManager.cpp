@@ -4,6 +4,7 @@
  */
 
 #include <cassert>
+#include <cmath>
 #include "WindowManager.h"
 
 namespace ECSEngine
@@ -26,6 +27,20 @@ WindowManager::WindowManager(unsigned int width, unsigned int height, const std:
 	mWorldUnitsPerPixel = 1.0f;
 }
 
+WindowManager::WindowManager(unsigned int width, unsigned int height)
+{
+	assert(width > 0 && height > 0 && "View dimensions must be positive!");
+
+	// No window: only the camera math runs
+	mWindow = nullptr;
+
+	mWindowWidth = width;
+	mWindowHeight = height;
+
+	mWindowCenterWorld = {0.0f, 0.0f};
+	mWorldUnitsPerPixel = 1.0f;
+}
+
 WindowManager::~WindowManager()
 {
 	delete mWindow;
@@ -73,6 +88,19 @@ void WindowManager::SetWorldScale(float worldUnitsPerPixel)
 	mWorldUnitsPerPixel = worldUnitsPerPixel;
 }
 
+void WindowManager::SetWindowSize(unsigned int width, unsigned int height)
+{
+	assert(width > 0 && height > 0 && "Window dimensions must be positive!");
+
+	mWindowWidth = width;
+	mWindowHeight = height;
+
+	// SFML otherwise keeps mapping the original size onto the whole window
+	if (mWindow)
+		mWindow->setView(sf::View(sf::FloatRect({0.0f, 0.0f},
+			{static_cast<float>(width), static_cast<float>(height)})));
+}
+
 
 // Conversion functions
 float WindowManager::WindowToWorldX(float x) const
@@ -135,5 +163,25 @@ Point2D WindowManager::WindowToWorld(const Point2D &pt) const
 	return {WindowToWorldX(pt.x), WindowToWorldY(pt.y)};
 }
 
+sf::Transform WindowManager::GetWorldToWindowTransform() const
+{
+	// Applied right to left: move the window center to the origin, scale to pixels,
+	// then move the origin to the middle of the window
+	sf::Transform transform;
+	transform.translate({mWindowWidth / 2.0f, mWindowHeight / 2.0f});
+	transform.scale({1.0f / mWorldUnitsPerPixel, 1.0f / mWorldUnitsPerPixel});
+	transform.translate({-mWindowCenterWorld.x, -mWindowCenterWorld.y});
+	return transform;
+}
+
+Rect WindowManager::GetVisibleWorldRect() const
+{
+	// Rect sizes are integral, so round up to never clip the last column of pixels
+	const Point2D topLeft = WindowToWorld(Point2D(0.0f, 0.0f));
+	return Rect(Point2D(std::floor(topLeft.x), std::floor(topLeft.y)),
+		static_cast<int>(std::ceil(mWindowWidth * mWorldUnitsPerPixel)) + 1,
+		static_cast<int>(std::ceil(mWindowHeight * mWorldUnitsPerPixel)) + 1);
+}
+
 
 }
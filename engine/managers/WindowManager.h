@@ -20,9 +20,12 @@ namespace ECSEngine
  * through world-to-window coordinate conversions. The window is created on construction
  * and destroyed on destruction.
  *
+ * A headless WindowManager has no window, only a view size. The camera and the coordinate
+ * conversions work the same, so simulation and streaming code never needs to know.
+ *
  * RESOURCE LIFETIME:
  * - The sf::RenderWindow pointer returned by GetWindow() is valid for the lifetime
- *   of the WindowManager object.
+ *   of the WindowManager object. It is nullptr when headless.
  * - Do NOT delete the returned pointer - it is managed internally.
  * - The pointer becomes invalid when the WindowManager is destroyed.
  */
@@ -37,6 +40,13 @@ public:
 	 */
 	WindowManager(unsigned int width, unsigned int height, const std::string &title);
 
+	/**
+	 * @brief Constructs a headless window manager, without creating a window.
+	 * @param width View width in pixels (must be > 0)
+	 * @param height View height in pixels (must be > 0)
+	 */
+	WindowManager(unsigned int width, unsigned int height);
+
 	/**
 	 * @brief Destroys the window manager and cleans up the SFML window.
 	 */
@@ -44,10 +54,17 @@ public:
 
 	/**
 	 * @brief Gets a pointer to the SFML render window.
-	 * @return Pointer to sf::RenderWindow (valid for lifetime of this WindowManager)
+	 * @return Pointer to sf::RenderWindow (valid for lifetime of this WindowManager),
+	 * or nullptr when headless
 	 */
 	sf::RenderWindow *GetWindow() const;
 
+	bool IsHeadless() const { return mWindow == nullptr; }
+
+	// Current window (or headless view) size in pixels
+	unsigned int GetWindowWidth() const { return mWindowWidth; }
+	unsigned int GetWindowHeight() const { return mWindowHeight; }
+
 
 	/**
 	 * @brief Sets the camera position by mapping a world point to a screen point.
@@ -69,6 +86,14 @@ public:
 	 */
 	void SetWorldScale(float worldUnitsPerPixel);
 
+	/**
+	 * @brief Adopts a new window size after the user resized the window.
+	 * @details Keeps one pixel per window pixel instead of stretching the original view.
+	 * @param width New window width in pixels (must be > 0)
+	 * @param height New window height in pixels (must be > 0)
+	 */
+	void SetWindowSize(unsigned int width, unsigned int height);
+
 	// Conversion functions
 	float WindowToWorldX(float x) const;
 	float WorldToWindowX(float x) const;
@@ -78,6 +103,19 @@ public:
 	Rect WorldToWindow(const Rect &rect) const;
 	Point2D WorldToWindow(const Point2D &pt) const;
 	Point2D WindowToWorld(const Point2D &pt) const;
+
+	/**
+	 * @brief Gets the world-to-window mapping as a transform for batched geometry.
+	 * @details Equivalent to WorldToWindow() applied to every vertex, so world-space
+	 * vertex arrays can be drawn without rebuilding them when the camera moves.
+	 */
+	sf::Transform GetWorldToWindowTransform() const;
+
+	/**
+	 * @brief Gets the region of the world currently covered by the window.
+	 * @return World-space rectangle, rounded outwards to whole world units
+	 */
+	Rect GetVisibleWorldRect() const;
 private:
 	sf::RenderWindow *mWindow;
 
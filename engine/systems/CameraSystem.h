@@ -12,7 +12,9 @@
 #include "../managers/WindowManager.h"
 #include "../components/CameraComponent.h"
 #include "../components/LocationComponent.h"
+#include "../components/TagComponents.h"
 #include "../components/TimeComponent.h"
+#include "../core/TimerWheel.h"
 
 namespace ECSEngine
 {
@@ -22,8 +24,11 @@ namespace ECSEngine
  * @details Implements smooth camera following with deadzone behavior similar to lab 8.
  * Following is configurable per-axis via CameraFollower.followX and followY flags.
  *
+ * The camera is the MainCameraTag singleton, which must hold a CameraComponent.
+ *
  * Camera shake is applied if the camera entity has both CameraShake and TimeComponent.
- * The shake effect is active while TimeComponent.isRunning is true.
+ * The shake effect is active while TimeComponent.isRunning is true. Triggering a shake
+ * starts the timer again, which TimeSystem schedules on the next simulation step.
  *
  * Camera zones (applied per axis if following is enabled):
  * - Outer 10%: Direct follow (entity at edge)
@@ -33,29 +38,23 @@ namespace ECSEngine
  * @tparam Components The component types in the EntityManager
  * @param entityManager Reference to the entity manager
  * @param windowManager Reference to the window manager
+ * @param timers Wheel running the TimeComponents, for the shake's remaining time
  * @param deltaTime Time elapsed since last frame (in seconds)
+ * @param alpha Blend between the target's previous and current location, matching SpriteSystem
  */
 template <typename... Components>
 void CameraSystem(EntityManager<Components...>& entityManager,
                   WindowManager& windowManager,
-                  float deltaTime)
+                  const TimerWheel& timers,
+                  float deltaTime,
+                  float alpha = 1.0f)
 {
-    // Find the camera entity
-    EntityID cameraEntity = 0;
-    bool foundCamera = false;
-
-    for (const auto& entity : entityManager)
-    {
-        if (entity.id && entityManager.template HasComponent<CameraComponent>(entity.id))
-        {
-            cameraEntity = entity.id;
-            foundCamera = true;
-            break;
-        }
-    }
+    // Fetch the registered camera entity
+    const EntityID cameraEntity = entityManager.template GetSingleton<MainCameraTag>();
 
     // If no camera exists, nothing to do
-    if (!foundCamera)
+    if (cameraEntity == INVALID_ENTITY
+        || !entityManager.template HasComponent<CameraComponent>(cameraEntity))
         return;
 
     auto& camera = entityManager.template GetComponent<CameraComponent>(cameraEntity);
@@ -75,8 +74,8 @@ void CameraSystem(EntityManager<Components...>& entityManager,
         if (shake.isShaking)
         {
             // Restart the shake timer
-            timer.isRunning = true;
-            timer.timeRemaining = timer.totalDuration;
+            timer.Start();
+            entityManager.template MarkChanged<TimeComponent>(cameraEntity);
             shake.elapsedTime = 0.0f;
 
             // Clear the trigger flag
@@ -84,13 +83,14 @@ void CameraSystem(EntityManager<Components...>& entityManager,
         }
 
         // Apply shake while timer is running
-        if (timer.isRunning && timer.timeRemaining > 0.0f)
+        const float timeLeft = timer.TimeLeft(timers);
+        if (timer.isRunning && timeLeft > 0.0f)
         {
             // Update elapsed time for oscillation
             shake.elapsedTime += deltaTime;
 
             // Fade shake intensity based on remaining time
-            float intensity = timer.timeRemaining / timer.totalDuration;
+            float intensity = timeLeft / timer.totalDuration;
 
             // Apply shake based on direction
             if (shake.horizontal)
@@ -138,10 +138,9 @@ void CameraSystem(EntityManager<Components...>& entityManager,
 
     const auto& targetLocation = entityManager.template GetComponent<LocationComponent>(follower.entityToTrack);
 
-    // Get window dimensions to calculate zones
-    sf::RenderWindow* window = windowManager.GetWindow();
-    unsigned int windowWidth = window->getSize().x;
-    unsigned int windowHeight = window->getSize().y;
+    // Get window dimensions to calculate zones (kept by the manager, so headless works too)
+    unsigned int windowWidth = windowManager.GetWindowWidth();
+    unsigned int windowHeight = windowManager.GetWindowHeight();
 
     // Camera following parameters
     float outerEdgePercent = 0.10f;      // 10% outer edge - direct follow
@@ -149,7 +148,7 @@ void CameraSystem(EntityManager<Components...>& entityManager,
     float tweenSpeed = 0.05f;            // Smooth tracking speed
 
     // Convert target world position to window coordinates
-    Point2D targetWindowPos = windowManager.WorldToWindow(targetLocation.position);
+    Point2D targetWindowPos = windowManager.WorldToWindow(targetLocation.Interpolated(alpha));
 
     Point2D cameraAdjust(0.0f, 0.0f);
 
@@ -5,15 +5,20 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
 #include <cmath>
+#include <limits>
+#include <utility>
 #include <vector>
 
 #include "../components/CollisionComponent.h"
-#include "../components/InputComponent.h"
 #include "../components/LocationComponent.h"
 #include "../components/MovementComponent.h"
+#include "../components/TagComponents.h"
+#include "../core/AABBBatch.h"
 #include "../core/MathUtil.h"
+#include "../managers/CollisionManager.h"
 #include "../managers/EntityManager.h"
 
 namespace ECSEngine {
@@ -53,270 +58,334 @@ inline Overlap CalculateOverlap(const Rect& rect1, const Rect& rect2)
     return overlap;
 }
 
+/**
+ * @brief Builds the contact record for two overlapping boxes.
+ * @details Separation happens on the axis with the smallest overlap. The normal points
+ * away from the second body, i.e. the way the first one has to move.
+ */
+inline Contact MakeContact(EntityID entity1, EntityID entity2, const CollisionComponent& col1,
+    const CollisionComponent& col2, const Overlap& overlap)
+{
+    Contact contact { entity1, entity2, Point2D(0.0f, 0.0f), 0.0f, false };
+
+    if (overlap.horizontal < overlap.vertical) {
+        const bool entity1IsLeft
+            = col1.currentBoundingBox.topLeft.x < col2.currentBoundingBox.topLeft.x;
+        contact.normal.x = entity1IsLeft ? -1.0f : 1.0f;
+        contact.penetration = overlap.horizontal;
+    } else {
+        const bool entity1IsAbove
+            = col1.currentBoundingBox.topLeft.y < col2.currentBoundingBox.topLeft.y;
+        contact.normal.y = entity1IsAbove ? -1.0f : 1.0f;
+        contact.penetration = overlap.vertical;
+    }
+
+    // Each body must be on a layer the other one is blocked by
+    contact.resolved = (col1.layer & col2.mask) != 0 && (col2.layer & col1.mask) != 0;
+    return contact;
+}
+
+/**
+ * @brief Sets the side flag of a body pushed along normal (pushed right = hit on the left).
+ */
+inline void SetContactFlags(CollisionComponent& col, const Point2D& normal)
+{
+    col.collidedLeft |= normal.x > 0.0f;
+    col.collidedRight |= normal.x < 0.0f;
+    col.collidedTop |= normal.y > 0.0f;
+    col.collidedBottom |= normal.y < 0.0f;
+}
+
+/**
+ * @brief Moves a body by offset, keeping its bounding box in step.
+ */
+template <typename... Components>
+inline void MoveBody(EntityID entity, CollisionComponent& col, const Point2D& offset,
+    EntityManager<Components...>& entityManager)
+{
+    auto& location = entityManager.template GetComponent<LocationComponent>(entity);
+    location.position += offset;
+    col.currentBoundingBox.topLeft += offset;
+    entityManager.template MarkChanged<LocationComponent>(entity);
+}
+
+/**
+ * @brief Velocity response of a dynamic body stopped by a static one.
+ * @param movement The dynamic body's movement
+ * @param col The dynamic body's collision component
+ * @param normal Direction the dynamic body was pushed
+ */
+inline void BounceOffStatic(MovementComponent& movement, const CollisionComponent& col,
+    const Point2D& normal)
+{
+    const bool horizontal = normal.x != 0.0f;
+    float& velocity = horizontal ? movement.velocity.x : movement.velocity.y;
+    const float normalSign = horizontal ? normal.x : normal.y;
+
+    // Reverse velocity if moving toward the static body
+    if (velocity * normalSign < 0.0f) {
+        velocity = -velocity * col.restitution;
+    }
+
+    // Stop horizontal movement when settled on ground (landing from above)
+    if (normal.y < 0.0f && col.restitution > 0.0f && std::abs(movement.velocity.y) < 10.0f) {
+        movement.velocity.x = 0.0f;
+    }
+}
+
 /**
  * @brief Resolves collision between two entities by separating them.
- * @details Determines collision direction from previous positions, then pushes
- * dynamic entities out of static entities. Sets appropriate collision flags.
+ * @details Pushes the bodies apart along the contact normal, sets their collision flags
+ * and bounces them according to their restitution. Two dynamic bodies split the
+ * separation and exchange their velocity along the normal; a dynamic body hitting a static
+ * one takes the whole separation and reverses its velocity if it was moving into it.
+ * Bouncy bodies (restitution > 0) stop sliding once their bounce has died out.
+ *
+ * Gameplay reactions (pickups, camera shake, player wall slides) are not handled here;
+ * they read the contact buffer after the collision step.
  *
  * @tparam Components The component types in the EntityManager
- * @param entity1 First entity ID
- * @param entity2 Second entity ID
- * @param col1 Collision component of first entity
- * @param col2 Collision component of second entity
- * @param overlap Overlap information between the two entities
+ * @param contact Contact between the two entities (see MakeContact())
+ * @param col1 Collision component of contact.a
+ * @param col2 Collision component of contact.b
  * @param entityManager Reference to the entity manager
  */
 template <typename... Components>
-inline void ResolveCollision(EntityID entity1, EntityID entity2, CollisionComponent& col1,
-    CollisionComponent& col2, const Overlap& overlap, EntityManager<Components...>& entityManager,
-    EntityID theCamera, EntityID thePlayer)
+inline void ResolveCollision(const Contact& contact, CollisionComponent& col1,
+    CollisionComponent& col2, EntityManager<Components...>& entityManager)
 {
-    // Check once at the top - used throughout function
-    bool entity1IsPlayer = (entity1 == thePlayer);
-    bool entity2IsPlayer = (entity2 == thePlayer);
-
     // Dynamic entities must have LocationComponent to be moved
     // note: Static-static pairs are filtered out before this function is called
     if (!col1.isStatic) {
-        assert(entityManager.template HasComponent<LocationComponent>(entity1)
+        assert(entityManager.template HasComponent<LocationComponent>(contact.a)
             && "Dynamic entity must have LocationComponent!");
     }
     if (!col2.isStatic) {
-        assert(entityManager.template HasComponent<LocationComponent>(entity2)
+        assert(entityManager.template HasComponent<LocationComponent>(contact.b)
             && "Dynamic entity must have LocationComponent!");
     }
     // note: we keep the HasComponent checks below for when compiling without debug
 
-    const float bounceDamping = 0.7f; // TODO: should be in a component?
-
-    // Resolve on axis with smallest overlap
-    bool separateHorizontally = overlap.horizontal < overlap.vertical;
+    const bool horizontal = contact.normal.x != 0.0f;
 
     // Handle dynamic-dynamic collisions
     if (!col1.isStatic && !col2.isStatic) {
         // Both entities dynamic - push both apart by half overlap
-        if (!entityManager.template HasComponent<LocationComponent>(entity1)
-            || !entityManager.template HasComponent<LocationComponent>(entity2))
+        if (!entityManager.template HasComponent<LocationComponent>(contact.a)
+            || !entityManager.template HasComponent<LocationComponent>(contact.b))
             return;
 
-        auto& location1 = entityManager.template GetComponent<LocationComponent>(entity1);
-        auto& location2 = entityManager.template GetComponent<LocationComponent>(entity2);
-
-        if (separateHorizontally) {
-            float halfOverlap = overlap.horizontal / 2.0f;
-            bool entity1IsLeft
-                = col1.currentBoundingBox.topLeft.x < col2.currentBoundingBox.topLeft.x;
-
-            if (entity1IsLeft) {
-                location1.position.x -= halfOverlap;
-                col1.currentBoundingBox.topLeft.x -= halfOverlap;
-                location2.position.x += halfOverlap;
-                col2.currentBoundingBox.topLeft.x += halfOverlap;
-                col1.collidedRight = true;
-                col2.collidedLeft = true;
-            } else {
-                location1.position.x += halfOverlap;
-                col1.currentBoundingBox.topLeft.x += halfOverlap;
-                location2.position.x -= halfOverlap;
-                col2.currentBoundingBox.topLeft.x -= halfOverlap;
-                col1.collidedLeft = true;
-                col2.collidedRight = true;
-            }
+        const Point2D halfSeparation = contact.normal * (contact.penetration / 2.0f);
+        MoveBody(contact.a, col1, halfSeparation, entityManager);
+        MoveBody(contact.b, col2, halfSeparation * -1.0f, entityManager);
+        SetContactFlags(col1, contact.normal);
+        SetContactFlags(col2, contact.normal * -1.0f);
 
-            // Exchange horizontal velocities with damping (non-player entities only)
-            if (entityManager.template HasComponent<MovementComponent>(entity1)
-                && entityManager.template HasComponent<MovementComponent>(entity2)) {
-                auto& movement1 = entityManager.template GetComponent<MovementComponent>(entity1);
-                auto& movement2 = entityManager.template GetComponent<MovementComponent>(entity2);
-
-                // If both are non-players (e.g., two stars), exchange velocities
-                if (!entity1IsPlayer && !entity2IsPlayer) {
-                    float temp = movement1.velocity.x;
-                    movement1.velocity.x = movement2.velocity.x * bounceDamping;
-                    movement2.velocity.x = temp * bounceDamping;
-                }
-                // If only entity1 is a star, bounce it off the player
-                else if (!entity1IsPlayer && entity2IsPlayer) {
-                    movement1.velocity.x = -movement1.velocity.x * bounceDamping;
-                }
-                // If only entity2 is a star, bounce it off the player
-                else if (entity1IsPlayer && !entity2IsPlayer) {
-                    movement2.velocity.x = -movement2.velocity.x * bounceDamping;
-                }
-                // If both are players (shouldn't happen), don't bounce either
-            }
-        } else {
-            float halfOverlap = overlap.vertical / 2.0f;
-            bool entity1IsAbove
-                = col1.currentBoundingBox.topLeft.y < col2.currentBoundingBox.topLeft.y;
-
-            if (entity1IsAbove) {
-                location1.position.y -= halfOverlap;
-                col1.currentBoundingBox.topLeft.y -= halfOverlap;
-                location2.position.y += halfOverlap;
-                col2.currentBoundingBox.topLeft.y += halfOverlap;
-                col1.collidedBottom = true;
-                col2.collidedTop = true;
-            } else {
-                location1.position.y += halfOverlap;
-                col1.currentBoundingBox.topLeft.y += halfOverlap;
-                location2.position.y -= halfOverlap;
-                col2.currentBoundingBox.topLeft.y -= halfOverlap;
-                col1.collidedTop = true;
-                col2.collidedBottom = true;
-            }
+        if (!entityManager.template HasComponent<MovementComponent>(contact.a)
+            || !entityManager.template HasComponent<MovementComponent>(contact.b))
+            return;
 
-            // Exchange vertical velocities with damping only for non-player entities
-            bool entity1IsPlayer = entityManager.template HasComponent<InputComponent>(entity1);
-            bool entity2IsPlayer = entityManager.template HasComponent<InputComponent>(entity2);
-
-            if (entityManager.template HasComponent<MovementComponent>(entity1)
-                && entityManager.template HasComponent<MovementComponent>(entity2)) {
-                auto& movement1 = entityManager.template GetComponent<MovementComponent>(entity1);
-                auto& movement2 = entityManager.template GetComponent<MovementComponent>(entity2);
-
-                // If both are non-players (e.g., two stars), exchange velocities
-                if (!entity1IsPlayer && !entity2IsPlayer) {
-                    float temp = movement1.velocity.y;
-                    movement1.velocity.y = movement2.velocity.y * bounceDamping;
-                    movement2.velocity.y = temp * bounceDamping;
-
-                    // Stop horizontal movement when both have settled
-                    if (std::abs(movement1.velocity.y) < 10.0f
-                        && std::abs(movement2.velocity.y) < 10.0f) {
-                        movement1.velocity.x = 0.0f;
-                        movement2.velocity.x = 0.0f;
-                    }
-                }
-            }
+        auto& movement1 = entityManager.template GetComponent<MovementComponent>(contact.a);
+        auto& movement2 = entityManager.template GetComponent<MovementComponent>(contact.b);
+        const float restitution = std::min(col1.restitution, col2.restitution);
+
+        // Exchange velocities along the normal with damping
+        float& velocity1 = horizontal ? movement1.velocity.x : movement1.velocity.y;
+        float& velocity2 = horizontal ? movement2.velocity.x : movement2.velocity.y;
+        const float temp = velocity1;
+        velocity1 = velocity2 * restitution;
+        velocity2 = temp * restitution;
+
+        // Stop horizontal movement when both have settled
+        if (!horizontal && restitution > 0.0f && std::abs(movement1.velocity.y) < 10.0f
+            && std::abs(movement2.velocity.y) < 10.0f) {
+            movement1.velocity.x = 0.0f;
+            movement2.velocity.x = 0.0f;
         }
         return; // Early return after handling dynamic-dynamic
     }
 
-    // Handle static-dynamic collisions (horizontal)
-    if (separateHorizontally) {
-        // Determine which entity is dynamic
-        EntityID dynamicEntity = !col1.isStatic ? entity1 : entity2;
-        CollisionComponent& dynamicCol = !col1.isStatic ? col1 : col2;
-        CollisionComponent& staticCol = !col1.isStatic ? col2 : col1;
-
-        // Determine direction: is the dynamic entity to the right of static?
-        bool dynamicIsRight
-            = dynamicCol.currentBoundingBox.topLeft.x > staticCol.currentBoundingBox.topLeft.x;
-
-        // Set collision flags
-        if (dynamicIsRight) {
-            // Dynamic entity is to the right - push it right (away from static)
-            dynamicCol.collidedLeft = true;
-            staticCol.collidedRight = true;
-        } else {
-            // Dynamic entity is to the left - push it left (away from static)
-            dynamicCol.collidedRight = true;
-            staticCol.collidedLeft = true;
-        }
+    // Handle static-dynamic collisions: everything from the dynamic body's point of view
+    const bool firstIsDynamic = !col1.isStatic;
+    const EntityID dynamicEntity = firstIsDynamic ? contact.a : contact.b;
+    CollisionComponent& dynamicCol = firstIsDynamic ? col1 : col2;
+    CollisionComponent& staticCol = firstIsDynamic ? col2 : col1;
+    const Point2D normal = firstIsDynamic ? contact.normal : contact.normal * -1.0f;
 
-        // Apply separation to dynamic entity
-        if (entityManager.template HasComponent<LocationComponent>(dynamicEntity)) {
-            auto& location = entityManager.template GetComponent<LocationComponent>(dynamicEntity);
-            float separation = dynamicIsRight ? overlap.horizontal : -overlap.horizontal;
+    SetContactFlags(dynamicCol, normal);
+    SetContactFlags(staticCol, normal * -1.0f);
 
-            location.position.x += separation;
-            dynamicCol.currentBoundingBox.topLeft.x += separation;
+    // Apply separation to dynamic entity
+    if (!entityManager.template HasComponent<LocationComponent>(dynamicEntity))
+        return;
 
-            if (entityManager.template HasComponent<MovementComponent>(dynamicEntity)) {
-                auto& movement
-                    = entityManager.template GetComponent<MovementComponent>(dynamicEntity);
+    MoveBody(dynamicEntity, dynamicCol, normal * contact.penetration, entityManager);
 
-                if (dynamicEntity != thePlayer) {
-                    // Reverse velocity if moving toward the wall
-                    if ((dynamicIsRight && movement.velocity.x < 0)
-                        || (!dynamicIsRight && movement.velocity.x > 0)) {
-                        movement.velocity.x = -movement.velocity.x * bounceDamping;
-                    }
-                } else {
-                    // Player-specific wall collision handling
-                    // Stop accumulating horizontal velocity when shoving into walls
-                    movement.velocity.x = 0.0f;
-
-                    // Clamp downward speed for wall-slide behavior when pushing into wall
-                    if (movement.velocity.y > 150.0f) {
-                        movement.velocity.y = 150.0f;
-                    }
+    if (!entityManager.template HasComponent<MovementComponent>(dynamicEntity))
+        return;
 
-                    // Trigger horizontal camera shake only on first contact
-                    if (!dynamicCol.wasTouchingWallLast) {
-                        auto& shake = entityManager.template GetComponent<CameraShake>(theCamera);
-                        shake.isShaking = true;
-                        shake.horizontal = true;
-                    }
-                }
+    BounceOffStatic(
+        entityManager.template GetComponent<MovementComponent>(dynamicEntity), dynamicCol, normal);
+}
+
+/**
+ * @brief Finds when a moving box first touches a stationary one.
+ * @details Casts box.topLeft along displacement against target grown by box's size
+ * (slab test on each axis). Boxes that already overlap at the start report no hit; the
+ * discrete pass separates those.
+ * @param box The moving box at the start of the step
+ * @param displacement How far box moves during the step
+ * @param target The stationary box
+ * @param toi Set to the fraction of the displacement travelled before touching, in [0, 1)
+ * @param normal Set to the axis-aligned direction that pushes box away from target
+ * @return Whether the box touches target during the step
+ */
+inline bool SweepAABB(const Rect& box, const Point2D& displacement, const Rect& target, float& toi,
+    Point2D& normal)
+{
+    const float inf = std::numeric_limits<float>::infinity();
+    float enter = -inf;
+    float exit = inf;
+    Point2D enterNormal(0.0f, 0.0f);
+
+    auto slab = [&](float start, float delta, float targetMin, float targetMax, bool xAxis) {
+        // Grown target: any box position in (minPos, maxPos) overlaps on this axis
+        const float minPos = targetMin - (xAxis ? box.width : box.height);
+        const float maxPos = targetMax;
+
+        if (delta == 0.0f) {
+            if (start <= minPos || start >= maxPos) {
+                exit = -inf; // Never overlaps on this axis
             }
+            return;
         }
-    }
-    // Handle static-dynamic collisions (vertical)
-    else {
-        // Determine which entity is dynamic
-        EntityID dynamicEntity = !col1.isStatic ? entity1 : entity2;
-        CollisionComponent& dynamicCol = !col1.isStatic ? col1 : col2;
-        CollisionComponent& staticCol = !col1.isStatic ? col2 : col1;
-
-        // Determine direction: is the dynamic entity positioned below the static?
-        bool dynamicIsBelow
-            = dynamicCol.currentBoundingBox.topLeft.y > staticCol.currentBoundingBox.topLeft.y;
-
-        // Set collision flags
-        if (dynamicIsBelow) {
-            // Dynamic entity is below - push it down (away from static)
-            dynamicCol.collidedTop = true;
-            staticCol.collidedBottom = true;
-        } else {
-            // Dynamic entity is above - push it up (away from static, landing on platform)
-            dynamicCol.collidedBottom = true;
-            staticCol.collidedTop = true;
+
+        float t1 = (minPos - start) / delta;
+        float t2 = (maxPos - start) / delta;
+        if (t1 > t2) {
+            std::swap(t1, t2);
         }
+        if (t1 > enter) {
+            enter = t1;
+            enterNormal = xAxis ? Point2D(delta > 0.0f ? -1.0f : 1.0f, 0.0f)
+                                : Point2D(0.0f, delta > 0.0f ? -1.0f : 1.0f);
+        }
+        exit = std::min(exit, t2);
+    };
 
-        // Apply separation to dynamic entity
-        if (entityManager.template HasComponent<LocationComponent>(dynamicEntity)) {
-            auto& location = entityManager.template GetComponent<LocationComponent>(dynamicEntity);
-            float separation = dynamicIsBelow ? overlap.vertical : -overlap.vertical;
+    slab(box.topLeft.x, displacement.x, target.topLeft.x, target.topLeft.x + target.width, true);
+    slab(box.topLeft.y, displacement.y, target.topLeft.y, target.topLeft.y + target.height, false);
 
-            location.position.y += separation;
-            dynamicCol.currentBoundingBox.topLeft.y += separation;
+    if (enter >= exit || enter < 0.0f || enter >= 1.0f) {
+        return false;
+    }
 
-            if (entityManager.template HasComponent<MovementComponent>(dynamicEntity)) {
-                auto& movement
-                    = entityManager.template GetComponent<MovementComponent>(dynamicEntity);
+    toi = enter;
+    normal = enterNormal;
+    return true;
+}
 
-                if (dynamicEntity != thePlayer) {
-                    // Reverse velocity if moving toward the platform
-                    if ((dynamicIsBelow && movement.velocity.y < 0)
-                        || (!dynamicIsBelow && movement.velocity.y > 0)) {
-                        movement.velocity.y = -movement.velocity.y * bounceDamping;
-                    }
+/**
+ * @brief Moves a fast body from its previous to its current box without tunnelling.
+ * @details Sweeps the body against tile layers and static bodies it is blocked by. At the
+ * earliest impact it stops, records a Contact, bounces like ResolveCollision() does, and
+ * slides along the surface with what is left of the step (up to MAX_SWEEPS impacts).
+ * The body ends the sweep touching whatever it hit, and the discrete pass then handles
+ * resting contact as usual.
+ *
+ * Only static geometry is swept; fast dynamic-dynamic pairs can still pass through each
+ * other.
+ *
+ * @tparam Components The component types in the EntityManager
+ * @param entity The dynamic body, its bounding box already moved to the end of the step
+ * @param col Collision component of entity
+ * @param entityManager Reference to the entity manager
+ * @param collisionManager Broadphase to sweep against, receives the contacts
+ * @param candidates Scratch buffer for broadphase queries
+ */
+template <typename... Components>
+void SweepAgainstStatic(EntityID entity, CollisionComponent& col,
+    EntityManager<Components...>& entityManager, CollisionManager& collisionManager,
+    std::vector<size_t>& candidates)
+{
+    static constexpr int MAX_SWEEPS = 4;
 
-                    // Stop horizontal movement when settled on ground (landing from above)
-                    if (!dynamicIsBelow && std::abs(movement.velocity.y) < 10.0f) {
-                        movement.velocity.x = 0.0f;
-                    }
-                } else {
-                    // Player landing or hitting ceiling – zero vertical velocity
-                    if (!dynamicIsBelow && movement.velocity.y > 0.0f) {
-                        movement.velocity.y = 0.0f;
-                    } else if (dynamicIsBelow && movement.velocity.y < 0.0f) {
-                        movement.velocity.y = 0.0f;
-                    }
+    Rect box = col.currentBoundingBox;
+    box.topLeft = col.previousBoundingBox.topLeft;
+    Point2D remaining = col.currentBoundingBox.topLeft - box.topLeft;
 
-                    if (!dynamicCol.wasStandingLast) {
-                        // Trigger vertical camera shake
-                        auto& shake = entityManager.template GetComponent<CameraShake>(theCamera);
-                        shake.isShaking = true;
-                        shake.horizontal = false;
-                    }
-                }
+    for (int sweep = 0; sweep < MAX_SWEEPS; ++sweep) {
+        if (remaining.x == 0.0f && remaining.y == 0.0f) {
+            break;
+        }
+
+        // Everything the box passes over this sweep (widths are whole units, so round up)
+        const float left = std::min(box.topLeft.x, box.topLeft.x + remaining.x);
+        const float top = std::min(box.topLeft.y, box.topLeft.y + remaining.y);
+        const Rect swept(left, top, std::ceil(box.width + std::abs(remaining.x)) + 1.0f,
+            std::ceil(box.height + std::abs(remaining.y)) + 1.0f);
+
+        float firstHit = 1.0f;
+        Point2D hitNormal(0.0f, 0.0f);
+        EntityID hitBody = INVALID_ENTITY;
+        auto consider = [&](const Rect& target, EntityID body) {
+            float toi;
+            Point2D normal;
+            if (SweepAABB(box, remaining, target, toi, normal) && toi < firstHit) {
+                firstHit = toi;
+                hitNormal = normal;
+                hitBody = body;
+            }
+        };
+
+        // Tile cells are on the default layer and block everything
+        if ((col.mask & COLLISION_LAYER_DEFAULT) != 0) {
+            for (const auto& layer : collisionManager.GetTileLayers()) {
+                layer.ForEachSolidCell(
+                    swept, [&](int c, int r) { consider(layer.CellBox(c, r), TILE_BODY); });
+            }
+        }
+
+        collisionManager.QueryStatic(swept, candidates);
+        for (size_t other : candidates) {
+            // Released bodies stay valid and keep their grid entries while pooled
+            if (!entityManager.ValidEntity(other) || !entityManager.IsActive(other)
+                || !entityManager.template HasComponent<CollisionComponent>(other))
+                continue;
+
+            const auto& otherCol = entityManager.template GetComponent<CollisionComponent>(other);
+            if ((col.layer & otherCol.mask) != 0 && (otherCol.layer & col.mask) != 0) {
+                consider(otherCol.currentBoundingBox, other);
             }
         }
 
+        if (hitBody == INVALID_ENTITY) {
+            box.topLeft += remaining;
+            break;
+        }
+
+        // Stop at the surface and keep only the motion along it
+        box.topLeft += remaining * firstHit;
+        remaining = remaining * (1.0f - firstHit);
+        if (hitNormal.x != 0.0f) {
+            remaining.x = 0.0f;
+        } else {
+            remaining.y = 0.0f;
+        }
+
+        collisionManager.AddContact(Contact { entity, hitBody, hitNormal, 0.0f, true });
+        SetContactFlags(col, hitNormal);
+        if (hitBody != TILE_BODY) {
+            SetContactFlags(
+                entityManager.template GetComponent<CollisionComponent>(hitBody), hitNormal * -1.0f);
+        }
+        if (entityManager.template HasComponent<MovementComponent>(entity)) {
+            BounceOffStatic(
+                entityManager.template GetComponent<MovementComponent>(entity), col, hitNormal);
+        }
     }
+
+    MoveBody(entity, col, box.topLeft - col.currentBoundingBox.topLeft, entityManager);
 }
 
 /**
@@ -326,114 +395,191 @@ inline void ResolveCollision(EntityID entity1, EntityID entity2, CollisionCompon
  * pushing dynamic entities out of static entities. Sets appropriate collision
  * flags (collidedTop, collidedBottom, collidedLeft, collidedRight).
  *
+ * Candidate pairs come from the CollisionManager broadphase: static bodies live in a
+ * persistent grid, dynamic bodies are re-inserted every frame, and only pairs involving
+ * at least one dynamic body are ever tested. Tile layers registered with the manager are
+ * resolved first, by looking up the solid cells under each dynamic body.
+ *
+ * Continuous bodies (CollisionComponent::continuous) that moved more than half their size
+ * this step are first swept from their previous box (see SweepAgainstStatic()), so they
+ * can't skip over thin walls.
+ *
+ * Sleeping bodies are skipped entirely, but awake bodies are still tested against them
+ * so that SleepSystem can wake them on contact.
+ *
+ * Bounding boxes are only recomputed for bodies whose LocationComponent was written since
+ * the previous step (EntityManager::MarkChanged()); anything that moves a body must mark it.
+ *
+ * Every overlap is appended to the manager's contact buffer, whether or not the layer
+ * masks let it be resolved. Systems scheduled after this one react to the contacts.
+ *
  * @tparam Components The component types in the EntityManager
  * @param entityManager Reference to the entity manager
+ * @param collisionManager Reference to the collision broadphase and contact buffer
  */
 template <typename... Components>
-void CollisionSystem(EntityManager<Components...>& entityManager, SoundManager& soundManager)
+void CollisionSystem(EntityManager<Components...>& entityManager, CollisionManager& collisionManager)
 {
-    // Clears flags, updates bounding boxes, collects entities, finds camera/player
-    EntityID theCamera = 0;
-    EntityID thePlayer = 0;
-    std::vector<EntityID> entities;
-
-    for (const auto& entity : entityManager) {
-        if (!entity.id)
-            continue;
-
-        // Process entities with collision components
-        if (entityManager.template HasComponent<CollisionComponent>(entity.id)) {
-            auto& collision = entityManager.template GetComponent<CollisionComponent>(entity.id);
-
-            // Clear collision flags from previous frame
-            // Must happen AFTER GravitySystem has read them (timing fix)
-            collision.clearCollisions();
-
-            // Update bounding box if entity has location
-            if (entityManager.template HasComponent<LocationComponent>(entity.id)) {
-                // Skip bounding box update for static entities that are already initialized
-                if (!collision.isStatic || !collision.boundingBoxInitialized) {
-                    const auto& location = entityManager.template GetComponent<LocationComponent>(entity.id);
-                    // Update bounding box position based on entity location + offset
-                    collision.currentBoundingBox.topLeft = location.position + collision.boundingBoxOffset;
-                    collision.boundingBoxInitialized = true;
+    // Clears flags, updates bounding boxes, fills the broadphase
+    std::vector<EntityID> dynamicEntities;
+
+    collisionManager.BeginFrame();
+
+    // Locations written since the last step (see EntityManager::MarkChanged())
+    const uint32_t locationsSince = collisionManager.GetLocationTick();
+    collisionManager.SetLocationTick(entityManager.AdvanceChangeTick());
+
+    // Sleeping bodies keep their flags and boxes, and sit in the manager's sleeping grid
+    for (auto [id, collision] :
+        entityManager.template View<CollisionComponent>(Exclude<Sleeping> {})) {
+        // Clear collision flags from previous frame
+        // Must happen AFTER GravitySystem has read them (timing fix)
+        collision.clearCollisions();
+
+        // Update bounding box if entity has location
+        if (entityManager.template HasComponent<LocationComponent>(id)) {
+            // Skip bounding box update for static entities that are already initialized, and
+            // for dynamic ones that haven't moved
+            if (!collision.boundingBoxInitialized
+                || (!collision.isStatic
+                    && entityManager.template ChangedSince<LocationComponent>(id, locationsSince))) {
+                const auto& location = entityManager.template GetComponent<LocationComponent>(id);
+                // Update bounding box position based on entity location + offset
+                collision.currentBoundingBox.topLeft = location.position + collision.boundingBoxOffset;
+
+                // Static bodies enter the persistent grid once, when first placed. A body
+                // placed for the first time hasn't moved yet, and CollisionSystemUpdate
+                // only copies the boxes of bodies that move afterwards
+                if (!collision.boundingBoxInitialized) {
+                    if (collision.isStatic) {
+                        collisionManager.InsertStatic(id, collision.currentBoundingBox);
+                    }
+                    collision.previousBoundingBox = collision.currentBoundingBox;
+                    collision.previousBoundingBoxValid = true;
                 }
-            } else {
-                assert(false && "Entity with CollisionComponent must have LocationComponent!");
+                collision.boundingBoxInitialized = true;
             }
-
-            // Add to collision entities list
-            entities.push_back(entity.id);
+        } else {
+            assert(false && "Entity with CollisionComponent must have LocationComponent!");
         }
 
-        // Find camera entity (by name)
-        if (entityManager.template GetEntityName(entity.id) == "main_camera") {
-            theCamera = entity.id;
+        if (!collision.isStatic) {
+            dynamicEntities.push_back(id);
         }
+    }
 
-        // Find player entity (by InputComponent)
-        if (entityManager.template HasComponent<InputComponent>(entity.id)) {
-            thePlayer = entity.id;
+    // Fast continuous bodies travel the step before anything is tested against them
+    std::vector<size_t> candidates;
+    for (EntityID dynamicEntity : dynamicEntities) {
+        auto& collision = entityManager.template GetComponent<CollisionComponent>(dynamicEntity);
+        const Point2D moved
+            = collision.currentBoundingBox.topLeft - collision.previousBoundingBox.topLeft;
+
+        if (collision.continuous && collision.previousBoundingBoxValid
+            && (std::abs(moved.x) * 2.0f > collision.currentBoundingBox.width
+                || std::abs(moved.y) * 2.0f > collision.currentBoundingBox.height)) {
+            SweepAgainstStatic(dynamicEntity, collision, entityManager, collisionManager, candidates);
         }
-    }
 
-    // Check each pair for collisions
-    for (size_t i = 0; i < entities.size(); ++i) {
-        for (size_t j = i + 1; j < entities.size(); ++j) {
-            EntityID entity1 = entities[i];
-            EntityID entity2 = entities[j];
+        // Dynamic bodies are re-inserted every frame
+        collisionManager.InsertDynamic(dynamicEntity, collision.currentBoundingBox);
+    }
 
-            // Only check for collisions against valid entities
-            if (!entityManager.ValidEntity(entity1) || !entityManager.ValidEntity(entity2))
+    // Narrowphase for a single candidate pair. batched holds the depths the batch test
+    // found, or nullptr once a resolution may have moved the boxes since.
+    // Returns whether the pair was resolved (and so moved)
+    auto processPair = [&](EntityID entity1, EntityID entity2, const Overlap* batched) {
+        auto& collision1 = entityManager.template GetComponent<CollisionComponent>(entity1);
+        auto& collision2 = entityManager.template GetComponent<CollisionComponent>(entity2);
+
+        // Boxes may have moved while resolving earlier pairs
+        if (batched == nullptr
+            && !collision1.currentBoundingBox.RectIntersect(collision2.currentBoundingBox))
+            return false;
+
+        // Collision detected!
+        const Contact contact = MakeContact(entity1, entity2, collision1, collision2,
+            batched != nullptr
+                ? *batched
+                : CalculateOverlap(collision1.currentBoundingBox, collision2.currentBoundingBox));
+        collisionManager.AddContact(contact);
+
+        if (contact.resolved) {
+            ResolveCollision(contact, collision1, collision2, entityManager);
+        }
+        return contact.resolved;
+    };
+
+    // Candidate boxes are gathered into SoA form and tested several at a time; only the
+    // hits go through the narrowphase
+    AABBBatch candidateBoxes;
+    AABBHits hits;
+    std::vector<EntityID> candidateIDs;
+    auto processCandidates = [&](EntityID dynamicEntity, const std::vector<size_t>& ids,
+                                 bool higherIDsOnly) {
+        candidateBoxes.Clear();
+        candidateIDs.clear();
+        for (size_t other : ids) {
+            // Broadphase IDs can outlive the body they were inserted for, and released bodies
+            // stay valid with their static and sleeping entries in place while pooled
+            if ((higherIDsOnly && other <= dynamicEntity) || !entityManager.ValidEntity(other)
+                || !entityManager.IsActive(other)
+                || !entityManager.template HasComponent<CollisionComponent>(other))
                 continue;
 
-            auto& collision1 = entityManager.template GetComponent<CollisionComponent>(entity1);
-            auto& collision2 = entityManager.template GetComponent<CollisionComponent>(entity2);
+            candidateBoxes.Add(
+                entityManager.template GetComponent<CollisionComponent>(other).currentBoundingBox);
+            candidateIDs.push_back(other);
+        }
 
-            // Skip static-static pairs (they never interact)
-            if (collision1.isStatic && collision2.isStatic)
-                continue;
+        const CollisionComponent& dynamicCol
+            = entityManager.template GetComponent<CollisionComponent>(dynamicEntity);
+        candidateBoxes.Overlaps(dynamicCol.currentBoundingBox, hits);
+
+        // The kernel's depths hold until the first resolution moves a box
+        bool moved = false;
+        for (size_t hit = 0; hit < hits.Size(); ++hit) {
+            const Overlap batched { hits.horizontal[hit], hits.vertical[hit] };
+            moved = processPair(dynamicEntity, candidateIDs[hits.index[hit]],
+                        moved ? nullptr : &batched)
+                || moved;
+        }
+    };
 
-            // Check if bounding boxes intersect
-            if (!collision1.currentBoundingBox.RectIntersect(collision2.currentBoundingBox))
-                continue;
+    // Test each dynamic body against its broadphase neighbours
+    for (EntityID dynamicEntity : dynamicEntities) {
+        auto& dynamicCol = entityManager.template GetComponent<CollisionComponent>(dynamicEntity);
 
-            // Collision detected!
+        // Against static tile layers (no entities involved)
+        for (const auto& layer : collisionManager.GetTileLayers()) {
+            layer.ForEachSolidCell(dynamicCol.currentBoundingBox, [&](int col, int row) {
+                CollisionComponent tileCol(layer.CellBox(col, row), true);
 
-            // Check for player-star collision (star collection)
-            EntityID star = 0;
-            if (entity1 == thePlayer && entityManager.template GetEntityName(entity2) == "star") {
-                star = entity2;
-            } else if (entity2 == thePlayer && entityManager.template GetEntityName(entity1) == "star") {
-                star = entity1;
-            }
+                // Box may have moved while resolving earlier cells
+                if (!dynamicCol.currentBoundingBox.RectIntersect(tileCol.currentBoundingBox))
+                    return;
 
-            if (star != 0) {
-                // Player collected a star
-                auto& score = entityManager.template GetComponent<ScoreComponent>(thePlayer);
-                auto& sprite = entityManager.template GetComponent<SpriteComponent>(star);
+                const Contact contact = MakeContact(dynamicEntity, TILE_BODY, dynamicCol, tileCol,
+                    CalculateOverlap(dynamicCol.currentBoundingBox, tileCol.currentBoundingBox));
+                collisionManager.AddContact(contact);
 
-                score.score += 10;
-                sprite.isAlive = false;
-                entityManager.RemoveEntity(star);
-                soundManager.PlaySound("sparkle");
-                continue;
-            }
+                if (contact.resolved) {
+                    ResolveCollision(contact, dynamicCol, tileCol, entityManager);
+                }
+            });
+        }
 
-            // Calculate overlap and resolve
-            Overlap overlap
-                = CalculateOverlap(collision1.currentBoundingBox, collision2.currentBoundingBox);
+        // Against static bodies
+        collisionManager.QueryStatic(dynamicCol.currentBoundingBox, candidates);
+        processCandidates(dynamicEntity, candidates, false);
 
-            ResolveCollision(
-                entity1, entity2, collision1, collision2, overlap, entityManager, theCamera, thePlayer);
-        }
-    }
+        // Against other dynamic bodies, each pair once (lower ID first)
+        collisionManager.QueryDynamic(dynamicCol.currentBoundingBox, candidates);
+        processCandidates(dynamicEntity, candidates, true);
 
-    // Update contact state for player after all collisions processed
-    if (thePlayer && entityManager.template HasComponent<CollisionComponent>(thePlayer)) {
-        auto& collision = entityManager.template GetComponent<CollisionComponent>(thePlayer);
-        collision.wasTouchingWallLast = (collision.collidedLeft || collision.collidedRight);
-        collision.wasStandingLast = collision.collidedBottom;
+        // Against sleeping bodies, which never query anything themselves
+        collisionManager.QuerySleeping(dynamicCol.currentBoundingBox, candidates);
+        processCandidates(dynamicEntity, candidates, false);
     }
 }
 
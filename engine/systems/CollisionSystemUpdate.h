@@ -8,8 +8,11 @@
  */
 #pragma once
 
+#include "../managers/CollisionManager.h"
 #include "../managers/EntityManager.h"
 #include "../components/CollisionComponent.h"
+#include "../components/LocationComponent.h"
+#include "../components/TagComponents.h"
 
 namespace ECSEngine {
 
@@ -20,28 +23,39 @@ namespace ECSEngine {
  * the pre-movement state stored. Collision flags are NOT cleared here
  * so GravitySystem can read them.
  *
+ * Only bodies whose location changed since the last call are visited: everything else
+ * already holds previousBoundingBox == currentBoundingBox, since CollisionSystem only
+ * moves a box when its location changes, and sets both when it first places a body.
+ *
  * @tparam Components The components for an entity.
  * @param entityManager Reference to the entity manager.
+ * @param collisionManager Keeps the change tick of the last call
+ * @param pool Optional pool to spread entities over (each entity is independent)
  */
 template <typename... Components>
-void CollisionSystemUpdate(EntityManager<Components...>& entityManager)
+void CollisionSystemUpdate(EntityManager<Components...>& entityManager,
+    CollisionManager& collisionManager, ThreadPool* pool = nullptr)
 {
-    for (const auto& entity : entityManager) {
-
-        if (!entity.id || !entityManager.template HasComponent<CollisionComponent>(entity.id)) {
-            continue;
-        }
-
-        auto& collision = entityManager.template GetComponent<CollisionComponent>(entity.id);
-
-        // Store previous bounding box (skip for static entities after first frame)
-        if (!collision.isStatic || !collision.boundingBoxInitialized) {
-            collision.previousBoundingBox = collision.currentBoundingBox;
-        }
-
-        // NOTE: Collision flags are cleared in CollisionSystem AFTER GravitySystem
-        // has had a chance to read them
+    const uint32_t since = collisionManager.GetPreviousBoxTick();
+    if (!entityManager.template AnyChangedSince<LocationComponent>(since)) {
+        return;
     }
+    collisionManager.SetPreviousBoxTick(entityManager.AdvanceChangeTick());
+
+    // Sleeping bodies keep the boxes they fell asleep with
+    entityManager.template ParallelForEach<CollisionComponent>(Exclude<Sleeping> {},
+        Changed<LocationComponent> { since }, pool, [](EntityID, CollisionComponent& collision) {
+
+            // Store previous bounding box (skip for static entities after first frame)
+            if (!collision.isStatic || !collision.boundingBoxInitialized) {
+                collision.previousBoundingBox = collision.currentBoundingBox;
+                // Until the body is placed, its current box is still the local offset
+                collision.previousBoundingBoxValid = collision.boundingBoxInitialized;
+            }
+
+            // NOTE: Collision flags are cleared in CollisionSystem AFTER GravitySystem
+            // has had a chance to read them
+        });
 }
 
 } // namespace ECSEngine
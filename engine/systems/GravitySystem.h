@@ -13,6 +13,7 @@
 #include "../components/MovementComponent.h"
 #include "../components/CollisionComponent.h"
 #include "../components/InputComponent.h"
+#include "../components/TagComponents.h"
 #include <SFML/Window/Keyboard.hpp>
 
 namespace ECSEngine {
@@ -30,50 +31,48 @@ constexpr float WALL_SLIDE_GRAVITY_MULTIPLIER = 0.3f;  // Reduce gravity to 30%
  * @tparam Components Components The components for an entity.
  * @param entityManager Reference to Entity Manager.
  * @param deltaTime Time elapsed since last frame (in seconds).
+ * @param pool Optional pool to spread entities over (each entity is independent)
  */
 template <typename... Components>
-void GravitySystem(EntityManager<Components...>& entityManager, float deltaTime)
+void GravitySystem(
+    EntityManager<Components...>& entityManager, float deltaTime, ThreadPool* pool = nullptr)
 {
-    for (const auto& entity : entityManager) {
+    // Entity needs MovementComponent for velocity
+    // Sleeping bodies are resting, so they are skipped
+    entityManager.template ParallelForEach<MovementComponent>(Exclude<Sleeping> {},
+        pool, [&](EntityID id, MovementComponent& movement) {
 
-        // Entity needs MovementComponent for velocity
-        if (!entity.id || !entityManager.template HasComponent<MovementComponent>(entity.id)) {
-            continue;
-        }
+            // Check if entity has collision component to detect ground and walls
+            bool isGrounded = false;
+            bool isWallSliding = false;
 
-        auto& movement = entityManager.template GetComponent<MovementComponent>(entity.id);
+            if (entityManager.template HasComponent<CollisionComponent>(id)) {
+                const auto& collision = entityManager.template GetComponent<CollisionComponent>(id);
 
-        // Check if entity has collision component to detect ground and walls
-        bool isGrounded = false;
-        bool isWallSliding = false;
+                // Check if on the ground
+                isGrounded = collision.collidedBottom;
 
-        if (entityManager.template HasComponent<CollisionComponent>(entity.id)) {
-            const auto& collision = entityManager.template GetComponent<CollisionComponent>(entity.id);
+                // Check for wall slide: against wall + falling + pushing into wall
+                if (!isGrounded && movement.velocity.y > 0 &&
+                    entityManager.template HasComponent<InputComponent>(id)) {
 
-            // Check if on the ground
-            isGrounded = collision.collidedBottom;
+                    const auto& input = entityManager.template GetComponent<InputComponent>(id);
 
-            // Check for wall slide: against wall + falling + pushing into wall
-            if (!isGrounded && movement.velocity.y > 0 &&
-                entityManager.template HasComponent<InputComponent>(entity.id)) {
-
-                const auto& input = entityManager.template GetComponent<InputComponent>(entity.id);
-
-                // Wall slide if pushing left into left wall OR pushing right into right wall
-                isWallSliding = (collision.collidedLeft && input.keydown.test(static_cast<size_t>(sf::Keyboard::Scan::A)))
-                             || (collision.collidedRight && input.keydown.test(static_cast<size_t>(sf::Keyboard::Scan::D)));
+                    // Wall slide if pushing left into left wall OR pushing right into right wall
+                    isWallSliding = (collision.collidedLeft && input.keydown.test(static_cast<size_t>(sf::Keyboard::Scan::A)))
+                                 || (collision.collidedRight && input.keydown.test(static_cast<size_t>(sf::Keyboard::Scan::D)));
+                }
             }
-        }
 
-        // Skip gravity if on ground
-        if (isGrounded) {
-            continue;
-        }
+            // Skip gravity if on ground
+            if (isGrounded) {
+                return;
+            }
 
-        // Apply gravity (reduced if wall sliding)
-        float gravityMultiplier = isWallSliding ? WALL_SLIDE_GRAVITY_MULTIPLIER : 1.0f;
-        movement.velocity.y += GRAVITY * gravityMultiplier * deltaTime;
-    }
+            // Apply gravity (reduced if wall sliding)
+            float gravityMultiplier = isWallSliding ? WALL_SLIDE_GRAVITY_MULTIPLIER : 1.0f;
+            movement.velocity.y += GRAVITY * gravityMultiplier * deltaTime;
+        });
 }
 
 } // namespace ECSEngine
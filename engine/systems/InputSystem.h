@@ -8,10 +8,12 @@
  */
 #pragma once
 
+#include "../components/AccelerationComponent.h"
 #include "../components/CollisionComponent.h"
 #include "../components/InputComponent.h"
 #include "../components/MovementComponent.h"
 #include "../managers/EntityManager.h"
+#include "../managers/SoundManager.h"
 #include <SFML/Window/Keyboard.hpp>
 
 #include <iostream>
@@ -35,23 +37,19 @@ constexpr float WALL_SLIDE_GRAVITY_SCALE = 0.3f; // Gravity reduction when slidi
  *
  * @tparam Components The components for an entity.
  * @param entityManager Reference to the Entity Manager.
+ * @param soundManager Queues the jump sound.
+ * @param jumpSound Sound played on every jump (INVALID_SOUND for none).
  * @param deltaTime Time elapsed since last frame (in seconds).
  */
 template <typename... Components>
 void InputSystem(
-    EntityManager<Components...>& entityManager, SoundManager& soundManager, float deltaTime)
+    EntityManager<Components...>& entityManager, SoundManager& soundManager, SoundID jumpSound,
+    float deltaTime)
 {
-    for (auto entity : entityManager) {
+    for (auto [id, input, movement, accelerationComp] : entityManager.template View<InputComponent,
+             MovementComponent, AccelerationComponent>()) {
 
-        if (!entity.id || !entityManager.template HasComponent<InputComponent>(entity.id)
-            || !entityManager.template HasComponent<MovementComponent>(entity.id)) {
-            continue;
-        }
-
-        auto& input = entityManager.template GetComponent<InputComponent>(entity.id);
-        auto& movement = entityManager.template GetComponent<MovementComponent>(entity.id);
-        auto& acceleration
-            = entityManager.template GetComponent<AccelerationComponent>(entity.id).acceleration;
+        const auto& acceleration = accelerationComp.acceleration;
 
         // Get collision state for platformer mechanics
         bool isGrounded = false;
@@ -59,8 +57,8 @@ void InputSystem(
         bool againstRightWall = false;
         bool isFalling = movement.velocity.y > 0;
 
-        if (entityManager.template HasComponent<CollisionComponent>(entity.id)) {
-            auto& collision = entityManager.template GetComponent<CollisionComponent>(entity.id);
+        if (entityManager.template HasComponent<CollisionComponent>(id)) {
+            auto& collision = entityManager.template GetComponent<CollisionComponent>(id);
             isGrounded = collision.collidedBottom;
             againstLeftWall = collision.collidedLeft;
             againstRightWall = collision.collidedRight;
@@ -124,12 +122,12 @@ void InputSystem(
             if (isGrounded) {
                 // Ground jump
                 movement.velocity.y = JUMP_VELOCITY;
-                soundManager.PlaySound("jump");
+                soundManager.QueueSound(jumpSound);
 
             } else if (isWallSliding) {
                 // Wall jump - push away from wall
                 movement.velocity.y = WALL_JUMP_VELOCITY_Y;
-                soundManager.PlaySound("jump");
+                soundManager.QueueSound(jumpSound);
 
                 if (againstLeftWall) {
                     movement.velocity.x = WALL_JUMP_VELOCITY_X; // Push right
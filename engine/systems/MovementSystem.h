@@ -12,6 +12,7 @@
 #include "../managers/EntityManager.h"
 #include "../components/LocationComponent.h"
 #include "../components/MovementComponent.h"
+#include "../components/TagComponents.h"
 
 namespace ECSEngine {
 
@@ -22,24 +23,26 @@ namespace ECSEngine {
  * @tparam Components The component types in the EntityManager
  * @param entityManager Reference to the entity manager
  * @param deltaTime Time elapsed since last frame (in seconds)
+ * @param pool Optional pool to spread entities over (each entity is independent)
  */
 template <typename... Components>
-void MovementSystem(EntityManager<Components...>& entityManager, float deltaTime)
+void MovementSystem(
+    EntityManager<Components...>& entityManager, float deltaTime, ThreadPool* pool = nullptr)
 {
-    for (const auto& entity : entityManager) {
+    entityManager.template ParallelForEach<LocationComponent, MovementComponent>(
+        Exclude<Sleeping> {}, pool,
+        [&entityManager, deltaTime](
+            EntityID id, LocationComponent& location, const MovementComponent& movement) {
+            // Bodies at rest keep their location, and everything derived from it, unchanged
+            if (movement.velocity.x == 0.0f && movement.velocity.y == 0.0f) {
+                return;
+            }
 
-        if (!entity.id || !entityManager.template HasComponent<LocationComponent>(entity.id)
-            || !entityManager.template HasComponent<MovementComponent>(entity.id)) {
-            continue;
-        }
-
-        auto& location = entityManager.template GetComponent<LocationComponent>(entity.id);
-        const auto& movement = entityManager.template GetComponent<MovementComponent>(entity.id);
-
-        // Update position based on velocity
-        location.position.x += movement.velocity.x * deltaTime;
-        location.position.y += movement.velocity.y * deltaTime;
-    }
+            // Update position based on velocity
+            location.position.x += movement.velocity.x * deltaTime;
+            location.position.y += movement.velocity.y * deltaTime;
+            entityManager.template MarkChanged<LocationComponent>(id);
+        });
 }
 
 } // namespace ECSEngine
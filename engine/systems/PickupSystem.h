@@ -0,0 +1,70 @@
+/**
+ * @file PickupSystem.h
+ * @brief Collects stars the player touched during the collision step.
+ */
+
+#pragma once
+
+#include "../components/InputComponent.h"
+#include "../components/ScoreComponent.h"
+#include "../components/SpriteComponent.h"
+#include "../components/TagComponents.h"
+#include "../managers/CollisionManager.h"
+#include "../managers/EntityCommandBuffer.h"
+#include "../managers/EntityManager.h"
+#include "../managers/SoundManager.h"
+
+namespace ECSEngine {
+
+/**
+ * @brief Scores and releases every star in contact with the player.
+ * @details Reads the contact buffer filled by CollisionSystem. Stars sit on
+ * COLLISION_LAYER_PICKUP, which the player's mask excludes, so these contacts are reported
+ * without the bodies being pushed apart. A star can touch the player through more than one
+ * contact; it is hidden on the first one and ignored afterwards.
+ *
+ * Collected stars are released through the command buffer (back to their spawner's pool,
+ * or removed if they weren't pooled).
+ *
+ * @tparam Components The component types in the EntityManager
+ * @param entityManager Reference to the entity manager
+ * @param soundManager Queues the pickup sound
+ * @param pickupSound Sound played for every star collected (INVALID_SOUND for none)
+ * @param collisionManager Holds this step's contacts
+ * @param commands Buffer receiving the releases
+ */
+template <typename... Components>
+void PickupSystem(EntityManager<Components...>& entityManager, SoundManager& soundManager,
+    SoundID pickupSound, const CollisionManager& collisionManager,
+    EntityCommandBuffer<Components...>& commands)
+{
+    const EntityID thePlayer = entityManager.template GetSingleton<InputComponent>();
+    if (thePlayer == INVALID_ENTITY
+        || !entityManager.template HasComponent<ScoreComponent>(thePlayer))
+        return;
+
+    auto& score = entityManager.template GetComponent<ScoreComponent>(thePlayer);
+
+    for (const Contact& contact : collisionManager.GetContacts()) {
+        const EntityID star = contact.a == thePlayer ? contact.b
+            : contact.b == thePlayer                 ? contact.a
+                                                     : INVALID_ENTITY;
+
+        // Tile cells are never valid entities
+        if (!entityManager.ValidEntity(star) || !entityManager.template HasComponent<StarTag>(star)
+            || !entityManager.template HasComponent<SpriteComponent>(star))
+            continue;
+
+        auto& sprite = entityManager.template GetComponent<SpriteComponent>(star);
+        if (!sprite.isAlive)
+            continue;
+
+        // Player collected a star
+        score.score += 10;
+        sprite.isAlive = false;
+        commands.Release(star);
+        soundManager.QueueSound(pickupSound);
+    }
+}
+
+} // namespace ECSEngine
@@ -0,0 +1,89 @@
+/**
+ * @file PlayerContactSystem.h
+ * @brief Player reactions to hitting walls, floors and ceilings.
+ */
+
+#pragma once
+
+#include "../components/CameraShakeComponent.h"
+#include "../components/CollisionComponent.h"
+#include "../components/InputComponent.h"
+#include "../components/MovementComponent.h"
+#include "../components/TagComponents.h"
+#include "../managers/CollisionManager.h"
+#include "../managers/EntityManager.h"
+
+namespace ECSEngine {
+
+/**
+ * @brief Applies the player-specific side of this step's static contacts.
+ * @details Reads the contact buffer filled by CollisionSystem and, for the player only:
+ * - clamps the fall speed while pushing into a wall (wall slide),
+ * - shakes the main camera on the first frame of touching a wall, or of hitting a floor
+ *   or ceiling after being airborne,
+ * - records whether the player was touching a wall / standing, for the next step.
+ *
+ * @tparam Components The component types in the EntityManager
+ * @param entityManager Reference to the entity manager
+ * @param collisionManager Holds this step's contacts
+ */
+template <typename... Components>
+void PlayerContactSystem(EntityManager<Components...>& entityManager,
+    const CollisionManager& collisionManager)
+{
+    const EntityID thePlayer = entityManager.template GetSingleton<InputComponent>();
+    if (thePlayer == INVALID_ENTITY
+        || !entityManager.template HasComponent<CollisionComponent>(thePlayer))
+        return;
+
+    // Only contacts that stopped the player against something static count
+    bool hitWall = false;
+    bool hitFloorOrCeiling = false;
+    for (const Contact& contact : collisionManager.GetContacts()) {
+        if (!contact.resolved || (contact.a != thePlayer && contact.b != thePlayer))
+            continue;
+
+        const EntityID other = contact.a == thePlayer ? contact.b : contact.a;
+        const bool otherIsStatic = other == TILE_BODY
+            || (entityManager.ValidEntity(other)
+                && entityManager.template HasComponent<CollisionComponent>(other)
+                && entityManager.template GetComponent<CollisionComponent>(other).isStatic);
+        if (!otherIsStatic)
+            continue;
+
+        if (contact.normal.x != 0.0f) {
+            hitWall = true;
+        } else {
+            hitFloorOrCeiling = true;
+        }
+    }
+
+    auto& collision = entityManager.template GetComponent<CollisionComponent>(thePlayer);
+
+    // Clamp downward speed for wall-slide behavior when pushing into wall
+    if (hitWall && entityManager.template HasComponent<MovementComponent>(thePlayer)) {
+        auto& movement = entityManager.template GetComponent<MovementComponent>(thePlayer);
+        if (movement.velocity.y > 150.0f) {
+            movement.velocity.y = 150.0f;
+        }
+    }
+
+    // Shake only on first contact
+    const EntityID theCamera = entityManager.template GetSingleton<MainCameraTag>();
+    if (theCamera != INVALID_ENTITY && entityManager.template HasComponent<CameraShake>(theCamera)) {
+        auto& shake = entityManager.template GetComponent<CameraShake>(theCamera);
+        if (hitWall && !collision.wasTouchingWallLast) {
+            shake.isShaking = true;
+            shake.horizontal = true;
+        } else if (hitFloorOrCeiling && !collision.wasStandingLast) {
+            shake.isShaking = true;
+            shake.horizontal = false;
+        }
+    }
+
+    // Update contact state for player after all collisions processed
+    collision.wasTouchingWallLast = (collision.collidedLeft || collision.collidedRight);
+    collision.wasStandingLast = collision.collidedBottom;
+}
+
+} // namespace ECSEngine
@@ -8,8 +8,8 @@
  */
 #pragma once
 
-#include <cassert>
 #include "../managers/EntityManager.h"
+#include "../managers/InputManager.h"
 #include "../managers/WindowManager.h"
 #include "../components/InputComponent.h"
 #include <SFML/Window.hpp>
@@ -17,44 +17,57 @@
 namespace ECSEngine {
 
 /**
- * @brief This system reads SFML keyboard events and updates the map of
- * what keys are currently down (T/F) on any entities with the input component.
+ * @brief Copies the input manager's key state to every entity with InputComponent.
+ */
+template <typename... Components>
+void PublishInput(EntityManager<Components...>& entityManager, const InputManager& inputManager)
+{
+    for (auto [id, input] : entityManager.template View<InputComponent>()) {
+        input.keydown = inputManager.GetKeysDown();
+    }
+}
+
+/**
+ * @brief This system polls the SFML events, decodes them once into the input manager and
+ * then updates the map of what keys are currently down (T/F) on any entities with the input
+ * component.
+ *
+ * @details No entity is touched while polling; the key state is copied to the
+ * InputComponents once per frame, after the last event. Window events are handled from the
+ * input manager's queue: closing closes the window and resizing resizes the view. Losing
+ * focus releases every key (see InputManager).
  *
  * @tparam Components The components for an entity.
- * @param window Reference to the window.
  * @param entityManager Reference to the entity manager.
+ * @param windowManager Reference to the window manager.
+ * @param inputManager Reference to the input manager receiving the events.
  */
 template <typename... Components>
-void ProcessEvents(EntityManager<Components...>& entityManager, WindowManager& windowManager)
+void ProcessEvents(
+    EntityManager<Components...>& entityManager, WindowManager& windowManager, InputManager& inputManager)
 {
     sf::RenderWindow* window = windowManager.GetWindow();
 
+    inputManager.BeginFrame();
     while (auto event = window->pollEvent()) {
+        inputManager.HandleEvent(*event);
+    }
 
-        // Check for window close event
-        if (event->is<sf::Event::Closed>()) {
+    for (const WindowEvent& windowEvent : inputManager.GetWindowEvents()) {
+        switch (windowEvent.type) {
+        case WindowEvent::Type::Closed:
             window->close();
-        }
-
-        // Process keyboard events for all entities with InputComponent
-        for (const auto& entity : entityManager) {
-
-            if (!entity.id || !entityManager.template HasComponent<InputComponent>(entity.id)) {
-                continue;
-            }
-
-            auto& input = entityManager.template GetComponent<InputComponent>(entity.id);
-
-            // Handle key pressed event
-            if (const auto* keyPressed = event->getIf<sf::Event::KeyPressed>()) {
-                input.keydown.set(static_cast<size_t>(keyPressed->scancode), true);
-            }
-            // Handle key released event
-            else if (const auto* keyReleased = event->getIf<sf::Event::KeyReleased>()) {
-                input.keydown.set(static_cast<size_t>(keyReleased->scancode), false);
-            }
+            break;
+        case WindowEvent::Type::Resized:
+            windowManager.SetWindowSize(windowEvent.width, windowEvent.height);
+            break;
+        default:
+            break;
         }
     }
+
+    // Publish the frame's key state to every entity with InputComponent
+    PublishInput(entityManager, inputManager);
 }
 
 } // namespace ECSEngine
@@ -0,0 +1,204 @@
+/**
+ * @file ProfilerOverlaySystem.h
+ * @brief Draws the profiler's per-system timings over the game.
+ */
+
+#pragma once
+
+#ifdef ECS_ENABLE_PROFILER
+
+#include <algorithm>
+#include <cctype>
+#include <cstdint>
+#include <cstdio>
+#include <iostream>
+#include <string_view>
+#include <vector>
+
+#include "../core/Profiler.h"
+#include "../managers/InputManager.h"
+#include "../managers/WindowManager.h"
+
+#include <SFML/Graphics.hpp>
+
+namespace ECSEngine {
+
+/**
+ * @struct ProfilerOverlay
+ * @brief State of the timing overlay between frames.
+ */
+struct ProfilerOverlay {
+    static constexpr int REFRESH_FRAMES = 15; // Rebuild the text four times a second at 60 Hz
+    static constexpr float PIXEL_SIZE = 2.0f; // Screen pixels per font pixel
+
+    bool visible = false;
+    int framesUntilRefresh = 0;
+    sf::VertexArray vertices { sf::PrimitiveType::Triangles };
+};
+
+namespace ProfilerFont {
+
+// 3x5 glyphs, rows top to bottom, 3 bits per row with the leftmost pixel highest.
+// There is no font asset, and this keeps the overlay free of any file loading.
+inline uint16_t Glyph(char c)
+{
+    switch (static_cast<char>(std::toupper(static_cast<unsigned char>(c)))) {
+    // clang-format off
+    case '0': return 0b111'101'101'101'111; case '1': return 0b010'110'010'010'111;
+    case '2': return 0b111'001'111'100'111; case '3': return 0b111'001'111'001'111;
+    case '4': return 0b101'101'111'001'001; case '5': return 0b111'100'111'001'111;
+    case '6': return 0b111'100'111'101'111; case '7': return 0b111'001'001'001'001;
+    case '8': return 0b111'101'111'101'111; case '9': return 0b111'101'111'001'111;
+    case 'A': return 0b010'101'111'101'101; case 'B': return 0b110'101'110'101'110;
+    case 'C': return 0b011'100'100'100'011; case 'D': return 0b110'101'101'101'110;
+    case 'E': return 0b111'100'110'100'111; case 'F': return 0b111'100'110'100'100;
+    case 'G': return 0b011'100'101'101'011; case 'H': return 0b101'101'111'101'101;
+    case 'I': return 0b111'010'010'010'111; case 'J': return 0b001'001'001'101'010;
+    case 'K': return 0b101'101'110'101'101; case 'L': return 0b100'100'100'100'111;
+    case 'M': return 0b101'111'111'101'101; case 'N': return 0b110'101'101'101'101;
+    case 'O': return 0b010'101'101'101'010; case 'P': return 0b110'101'110'100'100;
+    case 'Q': return 0b010'101'101'110'011; case 'R': return 0b110'101'110'101'101;
+    case 'S': return 0b011'100'010'001'110; case 'T': return 0b111'010'010'010'010;
+    case 'U': return 0b101'101'101'101'111; case 'V': return 0b101'101'101'101'010;
+    case 'W': return 0b101'101'111'111'101; case 'X': return 0b101'101'010'101'101;
+    case 'Y': return 0b101'101'010'010'010; case 'Z': return 0b111'001'010'100'111;
+    case '.': return 0b000'000'000'000'010; case ':': return 0b000'010'000'010'000;
+    case '/': return 0b001'001'010'100'100; case '-': return 0b000'000'111'000'000;
+    case '_': return 0b000'000'000'000'111; case '%': return 0b101'001'010'100'101;
+    case '(': return 0b001'010'010'010'001; case ')': return 0b100'010'010'010'100;
+    default: return 0; // Space and anything unknown
+    // clang-format on
+    }
+}
+
+inline void AddQuad(
+    sf::VertexArray& vertices, sf::Vector2f topLeft, sf::Vector2f size, sf::Color color)
+{
+    const sf::Vector2f topRight(topLeft.x + size.x, topLeft.y);
+    const sf::Vector2f bottomLeft(topLeft.x, topLeft.y + size.y);
+    const sf::Vector2f bottomRight(topLeft.x + size.x, topLeft.y + size.y);
+
+    for (sf::Vector2f corner :
+        { topLeft, topRight, bottomLeft, topRight, bottomRight, bottomLeft }) {
+        vertices.append(sf::Vertex { corner, color, {} });
+    }
+}
+
+// Appends text at a screen position; each glyph is 3 font pixels wide plus 1 of spacing
+inline void AddText(sf::VertexArray& vertices, std::string_view text, sf::Vector2f position,
+    float pixelSize, sf::Color color)
+{
+    for (char c : text) {
+        const uint16_t glyph = Glyph(c);
+        for (int row = 0; row < 5; ++row) {
+            for (int col = 0; col < 3; ++col) {
+                if (glyph & (1u << ((4 - row) * 3 + (2 - col)))) {
+                    AddQuad(vertices,
+                        sf::Vector2f(position.x + col * pixelSize, position.y + row * pixelSize),
+                        sf::Vector2f(pixelSize, pixelSize), color);
+                }
+            }
+        }
+        position.x += 4 * pixelSize;
+    }
+}
+
+} // namespace ProfilerFont
+
+/**
+ * @brief Toggles and draws the profiler overlay; F3 shows it, F4 starts and stops a trace.
+ * @details Lists min, average and 99th percentile milliseconds per frame for every profiled
+ * scope (each system, each stage, the whole frame) with a bar for the average. The text is
+ * rebuilt every REFRESH_FRAMES frames and drawn in screen space on top of the game, so it
+ * must run after the sprites are drawn and before the window is displayed.
+ *
+ * A stopped trace is written to ecs_trace.json in the working directory; open it in
+ * chrome://tracing or Perfetto.
+ *
+ * @param windowManager Window to draw into
+ * @param inputManager Keys pressed this frame
+ * @param profiler Source of the statistics
+ * @param overlay Overlay state, kept between frames
+ */
+inline void ProfilerOverlaySystem(WindowManager& windowManager, const InputManager& inputManager,
+    Profiler& profiler, ProfilerOverlay& overlay)
+{
+    if (inputManager.WasKeyPressed(sf::Keyboard::Scancode::F3)) {
+        overlay.visible = !overlay.visible;
+        overlay.framesUntilRefresh = 0;
+    }
+
+    if (inputManager.WasKeyPressed(sf::Keyboard::Scancode::F4)) {
+        if (profiler.IsCapturing()) {
+            if (profiler.StopCapture("ecs_trace.json")) {
+                std::cout << "Wrote profiler trace to ecs_trace.json\n";
+            }
+        } else {
+            profiler.StartCapture();
+        }
+    }
+
+    if (!overlay.visible) {
+        return;
+    }
+
+    if (--overlay.framesUntilRefresh <= 0) {
+        overlay.framesUntilRefresh = ProfilerOverlay::REFRESH_FRAMES;
+
+        const float pixel = ProfilerOverlay::PIXEL_SIZE;
+        const float lineHeight = 7 * pixel;
+        const float nameWidth = 24 * 4 * pixel; // Columns for names, then three numbers
+        const float numberWidth = 9 * 4 * pixel;
+        const float barLeft = nameWidth + 3 * numberWidth;
+        const float barScale = 40.0f; // Screen pixels per millisecond
+
+        const std::vector<Profiler::Stats> stats = profiler.GetStats();
+        overlay.vertices.clear();
+
+        const sf::Vector2f origin(8.0f, 8.0f);
+        const float height = (stats.size() + 1) * lineHeight + 2 * pixel;
+        ProfilerFont::AddQuad(overlay.vertices, origin - sf::Vector2f(4.0f, 4.0f),
+            sf::Vector2f(barLeft + 17 * barScale + 8.0f, height + 8.0f),
+            sf::Color(0, 0, 0, 170));
+
+        const sf::Color header(255, 220, 120);
+        ProfilerFont::AddText(overlay.vertices,
+            profiler.IsCapturing() ? "SCOPE (TRACING)" : "SCOPE", origin, pixel, header);
+        ProfilerFont::AddText(overlay.vertices, "MIN MS", origin + sf::Vector2f(nameWidth, 0.0f),
+            pixel, header);
+        ProfilerFont::AddText(overlay.vertices, "AVG MS",
+            origin + sf::Vector2f(nameWidth + numberWidth, 0.0f), pixel, header);
+        ProfilerFont::AddText(overlay.vertices, "P99 MS",
+            origin + sf::Vector2f(nameWidth + 2 * numberWidth, 0.0f), pixel, header);
+
+        char number[16];
+        sf::Vector2f line = origin;
+        for (const Profiler::Stats& entry : stats) {
+            line.y += lineHeight;
+            ProfilerFont::AddText(
+                overlay.vertices, entry.name.substr(0, 23), line, pixel, sf::Color::White);
+
+            const float values[3] = { entry.minMs, entry.avgMs, entry.p99Ms };
+            for (int i = 0; i < 3; ++i) {
+                std::snprintf(number, sizeof(number), "%7.3f", values[i]);
+                ProfilerFont::AddText(overlay.vertices, number,
+                    line + sf::Vector2f(nameWidth + i * numberWidth, 0.0f), pixel,
+                    sf::Color::White);
+            }
+
+            // Average bar; anything past a 60 Hz frame (16.7 ms) is clipped and drawn red
+            const float barWidth = std::min(entry.avgMs, 16.7f) * barScale;
+            const sf::Color barColor
+                = entry.avgMs < 16.7f ? sf::Color(90, 200, 120) : sf::Color::Red;
+            ProfilerFont::AddQuad(overlay.vertices, line + sf::Vector2f(barLeft, 0.0f),
+                sf::Vector2f(std::max(barWidth, 1.0f), 5 * pixel), barColor);
+        }
+    }
+
+    // The window's view is one unit per pixel (see WindowManager), like the screen-space sprites
+    windowManager.GetWindow()->draw(overlay.vertices);
+}
+
+} // namespace ECSEngine
+
+#endif
@@ -0,0 +1,133 @@
+/**
+ * @file SleepSystem.h
+ * @brief Puts resting dynamic bodies to sleep and wakes them when disturbed.
+ */
+
+#pragma once
+
+#include <cmath>
+#include <vector>
+
+#include "../components/CollisionComponent.h"
+#include "../components/LocationComponent.h"
+#include "../components/MovementComponent.h"
+#include "../components/TagComponents.h"
+#include "../managers/CollisionManager.h"
+#include "../managers/EntityCommandBuffer.h"
+#include "../managers/EntityManager.h"
+
+namespace ECSEngine {
+
+// A body slower than this on both axes counts as resting (world units per second). Bodies
+// settling on the floor jitter by about one step of gravity between gravity and bounce steps.
+constexpr float SLEEP_SPEED = 30.0f;
+
+// Consecutive resting steps before a body falls asleep
+constexpr int SLEEP_STEPS = 30;
+
+/**
+ * @brief Wakes sleeping bodies that were touched or lost their support, then puts bodies
+ * that have been resting long enough to sleep.
+ * @details Sleeping bodies carry the Sleeping tag, which GravitySystem, MovementSystem,
+ * CollisionSystemUpdate and CollisionSystem exclude, and move from the dynamic broadphase
+ * grid to the collision manager's sleeping grid. Only bodies with
+ * CollisionComponent::canSleep ever sleep.
+ *
+ * A sleeping body wakes when:
+ * - this step's contacts pair it with a body that is not resting itself (something ran
+ *   into it, or the player touched it), so settled neighbours don't keep each other awake,
+ * - the geometry around it changed (CollisionManager::MarkGeometryChanged(), which static
+ *   bodies being inserted or removed trigger), or
+ * - a body it was resting on woke up.
+ *
+ * Adding and removing the tag is recorded in the command buffer; the sleeping grid is
+ * updated immediately.
+ *
+ * @tparam Components The component types in the EntityManager (must include Sleeping)
+ * @param entityManager Reference to the entity manager
+ * @param collisionManager Holds this step's contacts and the sleeping grid
+ * @param commands Buffer receiving the tag changes
+ */
+template <typename... Components>
+void SleepSystem(EntityManager<Components...>& entityManager, CollisionManager& collisionManager,
+    EntityCommandBuffer<Components...>& commands)
+{
+    auto wake = [&](EntityID entity) {
+        // Tile cells are never valid entities
+        if (!entityManager.ValidEntity(entity)
+            || !entityManager.template HasComponent<Sleeping>(entity))
+            return;
+
+        auto& collision = entityManager.template GetComponent<CollisionComponent>(entity);
+        if (collision.restingSteps == 0)
+            return; // Already woken this step
+
+        collision.restingSteps = 0;
+        collisionManager.RemoveSleeping(entity);
+        commands.template RemoveComponent<Sleeping>(entity);
+
+        // Whatever was resting on top loses its support (a unit-high strip above the box)
+        const Rect& box = collision.currentBoundingBox;
+        collisionManager.MarkGeometryChanged(
+            Rect(box.topLeft.x + 1.0f, box.topLeft.y - 1.0f, box.width - 2.0f, 1.0f));
+    };
+
+    // Bodies that never sleep (the player) always count as moving
+    auto disturbs = [&](EntityID entity) {
+        return entityManager.ValidEntity(entity)
+            && entityManager.template HasComponent<CollisionComponent>(entity)
+            && !entityManager.template HasComponent<Sleeping>(entity)
+            && entityManager.template GetComponent<CollisionComponent>(entity).restingSteps == 0;
+    };
+
+    for (const Contact& contact : collisionManager.GetContacts()) {
+        if (disturbs(contact.b)) {
+            wake(contact.a);
+        }
+        if (disturbs(contact.a)) {
+            wake(contact.b);
+        }
+    }
+
+    // Waking adds regions, so this also walks up stacks of sleeping bodies
+    std::vector<size_t> candidates;
+    const auto& changes = collisionManager.GetGeometryChanges();
+    for (size_t i = 0; i < changes.size(); ++i) {
+        const Rect region = changes[i];
+        collisionManager.QuerySleeping(region, candidates);
+        for (size_t other : candidates) {
+            if (entityManager.ValidEntity(other)
+                && entityManager.template HasComponent<CollisionComponent>(other)
+                && entityManager.template GetComponent<CollisionComponent>(other)
+                       .currentBoundingBox.RectIntersect(region)) {
+                wake(other);
+            }
+        }
+    }
+    collisionManager.ClearGeometryChanges();
+
+    for (auto [id, collision, movement] :
+        entityManager.template View<CollisionComponent, MovementComponent>(Exclude<Sleeping> {})) {
+        if (!collision.canSleep || collision.isStatic)
+            continue;
+
+        const bool resting = std::abs(movement.velocity.x) < SLEEP_SPEED
+            && std::abs(movement.velocity.y) < SLEEP_SPEED;
+        collision.restingSteps = resting ? collision.restingSteps + 1 : 0;
+
+        if (collision.restingSteps >= SLEEP_STEPS) {
+            movement.velocity = Point2D(0.0f, 0.0f);
+            // SavePreviousLocations() and CollisionSystemUpdate skip sleepers, so leave
+            // nothing to interpolate or sweep
+            if (entityManager.template HasComponent<LocationComponent>(id)) {
+                auto& location = entityManager.template GetComponent<LocationComponent>(id);
+                location.previousPosition = location.position;
+            }
+            collision.previousBoundingBox = collision.currentBoundingBox;
+            collisionManager.InsertSleeping(id, collision.currentBoundingBox);
+            commands.AddComponent(id, Sleeping {});
+        }
+    }
+}
+
+} // namespace ECSEngine
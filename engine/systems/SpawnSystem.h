@@ -12,97 +12,104 @@
 #include <cassert>
 #include <random>
 
-#include "../components/CollisionComponent.h"
 #include "../components/LocationComponent.h"
 #include "../components/MovementComponent.h"
 #include "../components/SpawnComponent.h"
-#include "../components/SpriteComponent.h"
+#include "../core/Prefab.h"
+#include "../core/TimerWheel.h"
+#include "../managers/EntityCommandBuffer.h"
 #include "../managers/EntityManager.h"
-#include "../managers/SpriteManager.h"
-
-#include <SFML/Graphics/Sprite.hpp>
 
 namespace ECSEngine {
 
 /**
  * @brief Processes spawn components and creates new entities when needed.
- * @details Checks each spawner's timer, creates new entities when time is up,
- * and resets timers. Spawned entities get random velocity.
+ * @details Spawners wait in a timer wheel, so only the ones due this step are visited: each
+ * creates an entity and is scheduled again one interval later, until it reaches maxSpawns.
+ * Spawners added (or marked changed) since the last step are scheduled first. Each spawn
+ * is an instance of the spawner's prefab, placed at the spawner and given a random
+ * velocity. Instances are pooled, so steady spawning reuses the entities that were
+ * collected instead of creating new ones.
+ *
+ * New entities are recorded in the command buffer and appear when it is played back,
+ * so the spawners are never modified while they are being visited.
+ *
+ * Velocities come from the given generator only, and spawners due together are visited in
+ * a fixed order (TimerWheel::Advance()), so a run with the same seed spawns the same
+ * entities (ECSEngine::SetRandomSeed(), input replay).
  *
  * @tparam Components The component types in the EntityManager
  * @param entityManager Reference to the entity manager
- * @param spriteManager Reference to the sprite manager
+ * @param prefabs Registry holding the spawners' prefabs
+ * @param commands Buffer receiving the new entities
+ * @param random Generator for the spawned velocities
+ * @param timers Wheel holding the spawners' next spawn, used by no other system
  * @param deltaTime Time elapsed since last frame (in seconds)
  */
 template <typename... Components>
-void SpawnSystem(
-    EntityManager<Components...>& entityManager, SpriteManager& spriteManager, float deltaTime)
+void SpawnSystem(EntityManager<Components...>& entityManager,
+    const PrefabRegistry<Components...>& prefabs, EntityCommandBuffer<Components...>& commands,
+    std::mt19937& random, TimerWheel& timers, float deltaTime)
 {
-    // Random number generator for spawned entity velocities
-    // see: https://stackoverflow.com/questions/13445688/how-to-generate-a-random-number-in-c
-    static std::random_device rd;
-    static std::mt19937 gen(rd());
-    static std::uniform_real_distribution<float> velDist(-50.0f, 50.0f);
+    // Random velocities for spawned entities
+    std::uniform_real_distribution<float> velDist(-50.0f, 50.0f);
     float maxStarVelocity = 50.0f;
 
-    // Iterate through all entities
-    for (const auto& entity : entityManager) {
-        if (!entity.id || !entityManager.template HasComponent<SpawnComponent>(entity.id))
-            continue;
-
-        auto& spawn = entityManager.template GetComponent<SpawnComponent>(entity.id);
-
-        // Update spawn timer
-        spawn.timeToNextSpawn -= deltaTime;
-
-        // Check if it's time to spawn
-        if (spawn.timeToNextSpawn <= 0.0f) {
-            // Check if we've reached max spawns
-            if (spawn.maxSpawns != -1 && spawn.spawnCount >= spawn.maxSpawns)
-                continue;
-
-            // Get spawner location (spawners must have LocationComponent)
-            assert(entityManager.template HasComponent<LocationComponent>(entity.id)
-                && "Spawner entity must have LocationComponent!");
-
-            const auto& spawnerLoc
-                = entityManager.template GetComponent<LocationComponent>(entity.id);
-
-            // Create new entity
-            EntityID newEntity = entityManager.CreateEntity(spawn.entityType);
-
-            // Add location component (at spawner position)
-            entityManager.template AddComponent<LocationComponent>(
-                newEntity, LocationComponent(spawnerLoc.position));
-
-            // Add movement component with random velocity
-            Point2D randomVelocity(velDist(gen), velDist(gen));
-            entityManager.template AddComponent<MovementComponent>(
-                newEntity, MovementComponent(randomVelocity, maxStarVelocity));
-
-            // Get actual sprite dimensions from the registered sprite
-            sf::Sprite& sprite = spriteManager.GetSprite(spawn.spriteID);
-            sf::IntRect textureRect = sprite.getTextureRect();
+    // Spawners added since the last step, or changed after reaching maxSpawns
+    const uint32_t since = timers.GetSyncTick();
+    timers.SetSyncTick(entityManager.AdvanceChangeTick());
+    if (entityManager.template AnyChangedSince<SpawnComponent>(since)) {
+        for (auto [id, spawn] :
+            entityManager.template View<SpawnComponent>(Changed<SpawnComponent> { since })) {
+            const bool spawnsLeft = spawn.maxSpawns == -1 || spawn.spawnCount < spawn.maxSpawns;
+            if (spawn.nextSpawnTick == 0 && spawnsLeft) {
+                spawn.nextSpawnTick = timers.TickAfter(spawn.timeToNextSpawn);
+                timers.Schedule(id, spawn.nextSpawnTick);
+            }
+        }
+    }
 
-            // Add sprite component
-            // Note: Entity location is bottom-left, sprite rect is offset from that point
-            // to get top-left corner for rendering
-            Rect spriteBounds(0, -textureRect.size.y, textureRect.size.x, textureRect.size.y);
-            entityManager.template AddComponent<SpriteComponent>(newEntity,
-                SpriteComponent(
-                    spawn.spriteID, spriteBounds, true, true) // true = world space, true = isAlive
-            );
+    // Only the spawners whose time is up
+    for (const TimerWheel::Timer& due : timers.Advance(deltaTime)) {
+        const EntityID id = due.entity;
+        if (!entityManager.ValidEntity(id)
+            || !entityManager.template HasComponent<SpawnComponent>(id)) {
+            continue;
+        }
 
-            // Add collision component matching sprite size
-            // Collision box also offset from bottom-left location
-            Rect collisionBox(0, -textureRect.size.y, textureRect.size.x, textureRect.size.y);
-            entityManager.template AddComponent<CollisionComponent>(
-                newEntity, CollisionComponent(collisionBox, false) // false = dynamic
-            );
+        auto& spawn = entityManager.template GetComponent<SpawnComponent>(id);
+        if (spawn.nextSpawnTick != due.tick) {
+            continue;
+        }
 
-            // Reset spawn timer and increment count
-            spawn.timeToNextSpawn = spawn.spawnInterval;
-            spawn.spawnCount++;
+        // Get spawner location (spawners must have LocationComponent)
+        assert(entityManager.template HasComponent<LocationComponent>(id)
+            && "Spawner entity must have LocationComponent!");
+
+        const auto& spawnerLoc = entityManager.template GetComponent<LocationComponent>(id);
+
+        // Sprite, collision box and tag come from the prefab in one copy; collected
+        // spawns are released back to the prefab's pool and re-armed here
+        DeferredEntity newEntity = commands.Acquire(prefabs, spawn.prefab);
+
+        // Add location component (at spawner position)
+        commands.AddComponent(newEntity, LocationComponent(spawnerLoc.position));
+
+        // Add movement component with random velocity
+        // Drawn in a fixed order (argument evaluation order is unspecified)
+        const float velocityX = velDist(random);
+        const float velocityY = velDist(random);
+        Point2D randomVelocity(velocityX, velocityY);
+        commands.AddComponent(newEntity, MovementComponent(randomVelocity, maxStarVelocity));
+
+        // Schedule the next spawn unless we've reached max spawns
+        spawn.spawnCount++;
+        spawn.timeToNextSpawn = spawn.spawnInterval;
+        if (spawn.maxSpawns == -1 || spawn.spawnCount < spawn.maxSpawns) {
+            spawn.nextSpawnTick = due.tick + TimerWheel::TicksFor(spawn.spawnInterval);
+            timers.Schedule(id, spawn.nextSpawnTick);
+        } else {
+            spawn.nextSpawnTick = 0;
         }
     }
 }
@@ -9,13 +9,16 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cassert>
+#include <vector>
 
 #include "../components/CollisionComponent.h"
 #include "../components/InputComponent.h"
 #include "../components/LocationComponent.h"
 #include "../components/SpriteComponent.h"
 #include "../managers/EntityManager.h"
+#include "../managers/RenderManager.h"
 #include "../managers/SpriteManager.h"
 #include "../managers/WindowManager.h"
 
@@ -24,10 +27,19 @@
 namespace ECSEngine {
 
 /**
- * @brief Draws all entities with sprite components, then displays the window.
- * @details Iterates through all entities with SpriteComponent, converts world coordinates
- * to window coordinates for world-space sprites, and draws them. Screen-space sprites
- * are drawn at their absolute positions.
+ * @brief Clears the window and draws all entities with sprite components.
+ * @details Sprites are drawn through the RenderManager in batches that share a texture.
+ * Static world-space sprites (map tiles) are gathered into cached batches the first time,
+ * or again after RenderManager::MarkStaticDirty(), and drawn with the camera transform.
+ * They are ordered by SpriteComponent::layer, then by iteration order, so layers stay
+ * stacked correctly even when streamed tiles reuse storage slots.
+ * All other sprites are converted to window coordinates and batched every frame, drawn
+ * on top of the static layers in iteration order. Screen-space sprites are drawn at their
+ * absolute positions. Displaying the frame is left to a later system, so overlays can be
+ * drawn on top.
+ *
+ * World-space sprites are culled against the visible world rect: static chunks through the
+ * RenderManager's spatial index, dynamic sprites by their spriteRect bounds.
  *
  * Note: Entity locations represent the BOTTOM-LEFT corner of the entity. The spriteRect.topLeft
  * field provides an offset from this bottom-left position to determine where to render.
@@ -36,52 +48,87 @@ namespace ECSEngine {
  * @param entityManager Reference to the entity manager
  * @param spriteManager Reference to the sprite manager
  * @param windowManager Reference to the window manager
+ * @param renderManager Reference to the render manager holding the batches
+ * @param alpha Blend between each entity's previous and current location (1 = current)
  */
 template <typename... Components>
 void SpriteSystem(EntityManager<Components...>& entityManager, SpriteManager& spriteManager,
-    WindowManager& windowManager)
+    WindowManager& windowManager, RenderManager& renderManager, float alpha = 1.0f)
 {
     sf::RenderWindow* window = windowManager.GetWindow();
+    const Rect visibleWorld = windowManager.GetVisibleWorldRect();
+
+    // Rebuild the cached map geometry only when something asked for it
+    if (renderManager.IsStaticDirty()) {
+        struct StaticSprite {
+            int layer;
+            SpriteID sprite;
+            Point2D worldPos;
+        };
+        std::vector<StaticSprite> statics;
+
+        for (auto [id, spriteComp] : entityManager.template View<SpriteComponent>()) {
+            if (!spriteComp.isStatic || !spriteComp.isAlive) {
+                continue;
+            }
 
-    // Clear the window
-    window->clear(sf::Color::Black);
+            assert(spriteComp.worldSpace && "Static sprites must be in world space!");
+            assert(entityManager.template HasComponent<LocationComponent>(id)
+                && "World-space sprite must have LocationComponent!");
 
-    // Iterate through all entities
-    for (const auto& entity : entityManager) {
-        if (!entity.id || !entityManager.template HasComponent<SpriteComponent>(entity.id))
-            continue;
+            const auto& location = entityManager.template GetComponent<LocationComponent>(id);
+            statics.push_back({ spriteComp.layer, spriteComp.spriteID,
+                location.position + spriteComp.spriteRect.topLeft });
+        }
+
+        std::stable_sort(statics.begin(), statics.end(),
+            [](const StaticSprite& a, const StaticSprite& b) { return a.layer < b.layer; });
+
+        renderManager.BeginStatic();
+        for (const StaticSprite& entry : statics) {
+            renderManager.AddStatic(spriteManager.GetSprite(entry.sprite), entry.worldPos);
+        }
+        renderManager.EndStatic();
+    }
 
-        const auto& spriteComp = entityManager.template GetComponent<SpriteComponent>(entity.id);
+    // Everything else is batched from scratch each frame
+    renderManager.BeginDynamic();
+
+    for (auto [id, spriteComp] : entityManager.template View<SpriteComponent>()) {
 
         // If the 'sprite' is not alive, we won't draw it (i.e. stars)
-        if (!spriteComp.isAlive) {
+        if (!spriteComp.isAlive || spriteComp.isStatic) {
             continue;
         }
 
-        // Get the sprite from the manager
-        sf::Sprite& sprite = spriteManager.GetSprite(spriteComp.spriteID);
-
         // Determine position based on world space vs screen space
         Point2D position;
 
         if (spriteComp.worldSpace) {
             // World space sprites must have LocationComponent
-            assert(entityManager.template HasComponent<LocationComponent>(entity.id)
+            assert(entityManager.template HasComponent<LocationComponent>(id)
                 && "World-space sprite must have LocationComponent!");
 
             const auto& location
-                = entityManager.template GetComponent<LocationComponent>(entity.id);
+                = entityManager.template GetComponent<LocationComponent>(id);
 
             // Calculate world position: location (bottom-left) + sprite offset
-            Point2D worldPos = location.position + spriteComp.spriteRect.topLeft;
+            Point2D worldPos = location.Interpolated(alpha) + spriteComp.spriteRect.topLeft;
+
+            // Off-screen: skip before paying for conversion or vertices
+            const Rect worldBounds(
+                worldPos, spriteComp.spriteRect.width, spriteComp.spriteRect.height);
+            if (!worldBounds.RectIntersect(visibleWorld)) {
+                continue;
+            }
 
             // Convert world position to window position
             position = windowManager.WorldToWindow(worldPos);
         } else {
             // Screen space: use sprite rect position directly
-            if (entityManager.template HasComponent<LocationComponent>(entity.id)) {
+            if (entityManager.template HasComponent<LocationComponent>(id)) {
                 const auto& location
-                    = entityManager.template GetComponent<LocationComponent>(entity.id);
+                    = entityManager.template GetComponent<LocationComponent>(id);
 
                 position = location.position; // already in screen space
 
@@ -90,15 +137,13 @@ void SpriteSystem(EntityManager<Components...>& entityManager, SpriteManager& sp
             }
         }
 
-        // Set sprite position
-        sprite.setPosition(sf::Vector2f(position.x, position.y));
-
-        // Draw the sprite
-        window->draw(sprite);
+        renderManager.AddDynamic(spriteManager.GetSprite(spriteComp.spriteID), position);
     }
 
-    // Let'er rip, bud~!
-    window->display();
+    // Clear the window, then static layers first so moving sprites land on top
+    window->clear(sf::Color::Black);
+    renderManager.DrawStatic(*window, windowManager.GetWorldToWindowTransform(), visibleWorld);
+    renderManager.DrawDynamic(*window);
 }
 
 } // namespace ECSEngine
@@ -10,51 +10,63 @@
 #pragma once
 
 #include "../components/TimeComponent.h"
+#include "../core/TimerWheel.h"
 #include "../managers/EntityManager.h"
 
 namespace ECSEngine {
 
 /**
- * @brief Updates all TimeComponents attached to entities.
+ * @brief Times out the TimeComponents whose countdown ended this step.
  *
- * @details Decrements the remaining time of each timer using deltaTime for frame-rate
- * independent timing. If a timer finishes, it either stops or restarts automatically
- * if `restart` is true.
+ * @details Running timers live in the wheel, so a step only visits the timers added or
+ * started since the last one (to schedule them) and the ones that expired. An expired timer
+ * either stops or, if `restart` is true, is scheduled again one duration after it expired,
+ * so repeating timers do not drift. Entries left behind by stopped or restarted timers, or
+ * by removed entities, no longer match their component and are skipped.
  *
  * @tparam Components The components for an entity.
  * @param entityManager Reference to the Entity Manager.
+ * @param timers Wheel holding the running timers (ECSEngine::GetTimers())
  * @param deltaTime Time elapsed since last frame (in seconds).
  */
 template <typename... Components>
-void TimeSystem(EntityManager<Components...>& entityManager, float deltaTime)
+void TimeSystem(EntityManager<Components...>& entityManager, TimerWheel& timers, float deltaTime)
 {
-    for (const auto& entity : entityManager) {
+    // Timers added or started since the last step, usually none
+    const uint32_t since = timers.GetSyncTick();
+    timers.SetSyncTick(entityManager.AdvanceChangeTick());
+    if (entityManager.template AnyChangedSince<TimeComponent>(since)) {
+        for (auto [id, timer] :
+            entityManager.template View<TimeComponent>(Changed<TimeComponent> { since })) {
+            if (timer.isRunning && timer.expiryTick == 0) {
+                timer.expiryTick = timers.TickAfter(timer.timeRemaining);
+                timers.Schedule(id, timer.expiryTick);
+            }
+        }
+    }
 
-        if (!entity.id || !entityManager.template HasComponent<TimeComponent>(entity.id)) {
+    for (const TimerWheel::Timer& expired : timers.Advance(deltaTime)) {
+        if (!entityManager.ValidEntity(expired.entity)
+            || !entityManager.template HasComponent<TimeComponent>(expired.entity)) {
             continue;
         }
 
-        auto& timer = entityManager.template GetComponent<TimeComponent>(entity.id);
-        if (!timer.isRunning) {
+        auto& timer = entityManager.template GetComponent<TimeComponent>(expired.entity);
+        if (!timer.isRunning || timer.expiryTick != expired.tick) {
             continue;
         }
 
-        // Decrease timer by deltaTime
-        timer.timeRemaining -= deltaTime;
-
-        // When timer finishes
-        if (timer.timeRemaining <= 0.0f) {
-
-            if (timer.restart) {
-                // Reset for next cycle
-                timer.timeRemaining = timer.totalDuration;
-            } else {
-                // Stop the timer
-                timer.isRunning = false;
-                timer.timeRemaining = timer.totalDuration;
-            }
+        timer.timeRemaining = timer.totalDuration;
+        if (timer.restart) {
+            // Reset for next cycle
+            timer.expiryTick = expired.tick + TimerWheel::TicksFor(timer.totalDuration);
+            timers.Schedule(expired.entity, timer.expiryTick);
+        } else {
+            // Stop the timer
+            timer.isRunning = false;
+            timer.expiryTick = 0;
         }
     }
 }
 
-} // namespace ECSEngine
\ No newline at end of file
+} // namespace ECSEngine
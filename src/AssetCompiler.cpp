@@ -0,0 +1,51 @@
+/**
+ * @file AssetCompiler.cpp
+ * @brief Offline tool filling an asset cache with every asset of a manifest.
+ * @details Usage: ecsassetc assets.manifest cache_directory
+ * The game then starts from decoded pixels and samples on its first launch too. It fills the
+ * same cache on its own otherwise, one miss at a time.
+ */
+
+#include <iostream>
+#include <string>
+
+#include "managers/AssetCache.h"
+
+int main(int argc, char* argv[])
+{
+    if (argc != 3) {
+        std::cout << "Usage: " << argv[0] << " assets.manifest cache_directory\n";
+        return 1;
+    }
+
+    ECSEngine::AssetManifest manifest;
+    if (!ECSEngine::AssetManifest::Load(argv[1], manifest)) {
+        return 1;
+    }
+
+    const ECSEngine::AssetCache cache(argv[2]);
+    int failures = 0;
+
+    for (const std::string& path : manifest.textures) {
+        sf::Image image;
+        if (!cache.LoadImage(path, image)) {
+            std::cerr << "Failed to cache " << path << "\n";
+            ++failures;
+            continue;
+        }
+        std::cout << "Cached " << path << " (" << image.getSize().x << "x" << image.getSize().y
+                  << ")\n";
+    }
+
+    for (const ECSEngine::AssetManifest::Sound& sound : manifest.sounds) {
+        sf::SoundBuffer buffer;
+        if (!cache.LoadSound(sound.path, buffer)) {
+            std::cerr << "Failed to cache " << sound.path << "\n";
+            ++failures;
+            continue;
+        }
+        std::cout << "Cached " << sound.path << " (" << buffer.getSampleCount() << " samples)\n";
+    }
+
+    return failures == 0 ? 0 : 1;
+}
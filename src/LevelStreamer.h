@@ -0,0 +1,462 @@
+/**
+ * @file LevelStreamer.h
+ * @brief Loads map layers in chunks around the camera, decoding on a background thread.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <condition_variable>
+#include <deque>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <unordered_set>
+#include <vector>
+
+#include "MapFormat.h"
+#include "MapLoader.h"
+#include "core/MathUtil.h"
+#include "core/TileCollisionGrid.h"
+#include "managers/CollisionManager.h"
+#include "managers/EntityManager.h"
+#include "managers/RenderManager.h"
+#include "managers/SpriteManager.h"
+
+/**
+ * @class LevelStreamer
+ * @brief Keeps only the chunks of a map layer near the view alive as entities.
+ * @details The layer is split into square chunks of chunkTiles x chunkTiles cells. A worker
+ * thread opens and decodes the map file, then turns chunk requests into lists of tiles.
+ * Update(), called once per frame on the main thread, requests the chunks overlapping the
+ * visible world (plus a margin), creates the entities of chunks the worker has finished,
+ * and removes the entities of chunks that drifted more than twice the margin away, which
+ * returns their IDs to the entity free list. Colliding tiles leave the CollisionManager's
+ * static grid along with their entity, so memory stays bounded however big the level is,
+ * and sleeping bodies resting on them wake up. The gap between the two distances keeps a chunk
+ * on the boundary from loading and unloading every frame.
+ *
+ * Pinned symbols (e.g. spawners) are created for the whole map as soon as it is decoded and
+ * never released; find them through GetPinnedEntities(). An optional TileCollisionGrid is
+ * filled for the whole map on the worker, before IsReady() turns true, since collision
+ * cells are cheap compared to entities.
+ *
+ * RESOURCE LIFETIME:
+ * - The collision grid must stay alive, and must not be read, until IsReady() is true.
+ * - Destroying the streamer stops the worker but leaves the streamed entities in place.
+ *
+ * @tparam Components The component types managed by the EntityManager
+ */
+template <typename... Components> class LevelStreamer {
+public:
+    static constexpr int DEFAULT_CHUNK_TILES = 16;
+    // Chunks turned into entities per Update(), to spread the cost of a fast camera
+    static constexpr size_t MAX_CHUNKS_PER_UPDATE = 4;
+
+    /**
+     * @brief Starts decoding the map file in the background.
+     * @param mapFilePath Path to the .map or .mapb file
+     * @param resourcePath Base path for resolving texture paths
+     * @param layer SpriteComponent::layer of the tiles (draw order among map layers)
+     * @param pinnedSymbols Symbols created up front and never streamed out
+     * @param nonCollidableSymbols Symbols that should not have collision
+     * @param collisionGrid Optional static collision layer for the whole map
+     * @param chunkTiles Chunk side length in tiles
+     */
+    LevelStreamer(const std::string& mapFilePath, const std::string& resourcePath, int layer = 0,
+        const std::unordered_set<char>& pinnedSymbols = {},
+        const std::unordered_set<char>& nonCollidableSymbols = {},
+        ECSEngine::TileCollisionGrid* collisionGrid = nullptr,
+        int chunkTiles = DEFAULT_CHUNK_TILES)
+        : mMapFilePath(mapFilePath)
+        , mResourcePath(resourcePath)
+        , mLayer(layer)
+        , mPinnedSymbols(pinnedSymbols)
+        , mNonCollidableSymbols(nonCollidableSymbols)
+        , mCollisionGrid(collisionGrid)
+        , mChunkTiles(std::max(1, chunkTiles))
+    {
+        mWorker = std::thread([this] { WorkerLoop(); });
+    }
+
+    ~LevelStreamer()
+    {
+        {
+            std::lock_guard lock(mMutex);
+            mStopping = true;
+        }
+        mWake.notify_all();
+        mWorker.join();
+    }
+
+    LevelStreamer(const LevelStreamer&) = delete;
+    LevelStreamer& operator=(const LevelStreamer&) = delete;
+
+    // True once the map is decoded (or failed to); until then Update() does nothing
+    bool IsReady() const { return mReady.load(std::memory_order_acquire); }
+    bool Failed() const { return IsReady() && mFailed; }
+
+    /**
+     * @brief Blocks until the map is decoded, e.g. when the level can't start without it.
+     */
+    void WaitUntilReady()
+    {
+        std::unique_lock lock(mMutex);
+        mWake.wait(lock, [this] { return IsReady(); });
+    }
+
+    /**
+     * @brief Loads distance: chunks within this many world units of the view are kept.
+     * @details Defaults to one chunk. Chunks are released beyond twice the margin.
+     */
+    void SetMargin(float margin) { mMargin = margin; }
+
+    /**
+     * @brief Streams chunks in and out around the visible region. Main thread only.
+     * @param entityManager Manager receiving the tile entities
+     * @param spriteManager Sprite registry for the tile sprites
+     * @param renderManager Told to rebuild its static batches when tiles change
+     * @param collisionManager Forgets the static bodies of released tiles
+     * @param visibleWorld World-space region currently on screen
+     */
+    void Update(ECSEngine::EntityManager<Components...>& entityManager,
+        ECSEngine::SpriteManager& spriteManager, ECSEngine::RenderManager& renderManager,
+        ECSEngine::CollisionManager& collisionManager, const ECSEngine::Rect& visibleWorld)
+    {
+        if (!IsReady() || mFailed) {
+            return;
+        }
+
+        bool changed = false;
+
+        // First update after decoding: the worker no longer touches the header and dictionary
+        if (!mFactory) {
+            mFactory = std::make_unique<TileFactory<Components...>>(mMap.info, mMap.tiles,
+                mResourcePath, mNonCollidableSymbols, mCollisionGrid != nullptr, mLayer);
+            if (mMargin < 0.0f) {
+                mMargin = mChunkTiles * std::max(mMap.info.tileWidth, mMap.info.tileHeight);
+            }
+
+            for (const Placement& tile : mPinnedTiles) {
+                mPinned.AddEntity(mMap.tiles[tile.tile].symbol,
+                    mFactory->Create(entityManager, spriteManager, tile.col, tile.row, tile.tile));
+            }
+            changed = !mPinnedTiles.empty();
+        }
+
+        RequestChunksNear(visibleWorld);
+        changed |= ApplyReadyChunks(entityManager, spriteManager);
+        changed |= ReleaseChunksAwayFrom(visibleWorld, entityManager, collisionManager);
+
+        if (changed) {
+            renderManager.MarkStaticDirty();
+        }
+    }
+
+    const MapLayerData& GetPinnedEntities() const { return mPinned; }
+
+    size_t GetLoadedChunkCount() const { return mLoadedChunks.size(); }
+
+private:
+    struct Placement {
+        int col;
+        int row;
+        uint8_t tile;
+    };
+
+    struct ChunkTiles {
+        size_t chunk;
+        std::vector<Placement> tiles;
+    };
+
+    enum class ChunkState { Unloaded, Requested, Loaded };
+
+    struct Chunk {
+        ChunkState state = ChunkState::Unloaded;
+        std::vector<ECSEngine::EntityID> entities;
+    };
+
+    // Worker thread: decode, then serve chunk requests until stopped
+    void WorkerLoop()
+    {
+        const bool opened = OpenMap();
+
+        if (opened) {
+            if (mCollisionGrid) {
+                FillCollisionGrid(mMap, mNonCollidableSymbols, *mCollisionGrid);
+            }
+            CollectPinnedTiles();
+
+            mChunkCols = (mMap.info.gridWidth + mChunkTiles - 1) / mChunkTiles;
+            mChunkRows = (mMap.info.gridHeight + mChunkTiles - 1) / mChunkTiles;
+            mChunks.resize(static_cast<size_t>(mChunkCols) * mChunkRows);
+        }
+
+        {
+            std::lock_guard lock(mMutex);
+            mFailed = !opened;
+            mReady.store(true, std::memory_order_release);
+        }
+        mWake.notify_all();
+
+        while (opened) {
+            size_t chunk;
+            {
+                std::unique_lock lock(mMutex);
+                mWake.wait(lock, [this] { return mStopping || !mRequests.empty(); });
+                if (mStopping) {
+                    return;
+                }
+                chunk = mRequests.front();
+                mRequests.pop_front();
+            }
+
+            ChunkTiles result { chunk, DecodeChunk(chunk) };
+
+            std::lock_guard lock(mMutex);
+            mFinished.push_back(std::move(result));
+        }
+    }
+
+    bool OpenMap()
+    {
+        const std::string compiledExtension = ".mapb";
+        const bool compiled = mMapFilePath.size() >= compiledExtension.size()
+            && mMapFilePath.compare(mMapFilePath.size() - compiledExtension.size(),
+                   compiledExtension.size(), compiledExtension) == 0;
+
+        if (compiled) {
+            mFile = std::make_unique<ECSEngine::MappedFile>(mMapFilePath);
+            if (!mFile->IsOpen() || !MapFormat::ReadCompiledMap(mFile->Data(), mFile->Size(), mMap)) {
+                std::cerr << "Error: Could not stream compiled map " << mMapFilePath << std::endl;
+                return false;
+            }
+            return true;
+        }
+
+        if (!MapFormat::ParseMapText(mMapFilePath, mSource)) {
+            return false;
+        }
+        mMap = mSource.View();
+        return true;
+    }
+
+    bool IsPinned(uint8_t tile) const
+    {
+        return mPinnedSymbols.find(mMap.tiles[tile].symbol) != mPinnedSymbols.end();
+    }
+
+    void CollectPinnedTiles()
+    {
+        if (mPinnedSymbols.empty()) {
+            return;
+        }
+
+        for (int row = 0; row < mMap.info.gridHeight; ++row) {
+            for (int col = 0; col < mMap.info.gridWidth; ++col) {
+                const uint8_t tile = Cell(col, row);
+                if (tile != MapFormat::EMPTY_CELL && IsPinned(tile)) {
+                    mPinnedTiles.push_back({ col, row, tile });
+                }
+            }
+        }
+    }
+
+    std::vector<Placement> DecodeChunk(size_t chunk) const
+    {
+        const int firstCol = static_cast<int>(chunk % mChunkCols) * mChunkTiles;
+        const int firstRow = static_cast<int>(chunk / mChunkCols) * mChunkTiles;
+        const int lastCol = std::min(firstCol + mChunkTiles, mMap.info.gridWidth);
+        const int lastRow = std::min(firstRow + mChunkTiles, mMap.info.gridHeight);
+
+        std::vector<Placement> tiles;
+        for (int row = firstRow; row < lastRow; ++row) {
+            for (int col = firstCol; col < lastCol; ++col) {
+                const uint8_t tile = Cell(col, row);
+                if (tile != MapFormat::EMPTY_CELL && !IsPinned(tile)) {
+                    tiles.push_back({ col, row, tile });
+                }
+            }
+        }
+        return tiles;
+    }
+
+    uint8_t Cell(int col, int row) const
+    {
+        return mMap.cells[static_cast<size_t>(row) * mMap.info.gridWidth + col];
+    }
+
+    // Inclusive chunk coordinate range overlapping a world rect grown by margin
+    bool ChunkRange(const ECSEngine::Rect& world, float margin, int& col0, int& row0, int& col1,
+        int& row1) const
+    {
+        const float chunkWidth = mChunkTiles * mMap.info.tileWidth;
+        const float chunkHeight = mChunkTiles * mMap.info.tileHeight;
+
+        col0 = static_cast<int>(std::floor((world.topLeft.x - margin - mMap.info.originX) / chunkWidth));
+        row0 = static_cast<int>(std::floor((world.topLeft.y - margin - mMap.info.originY) / chunkHeight));
+        col1 = static_cast<int>(std::floor(
+            (world.topLeft.x + world.width + margin - mMap.info.originX) / chunkWidth));
+        row1 = static_cast<int>(std::floor(
+            (world.topLeft.y + world.height + margin - mMap.info.originY) / chunkHeight));
+
+        col0 = std::max(col0, 0);
+        row0 = std::max(row0, 0);
+        col1 = std::min(col1, mChunkCols - 1);
+        row1 = std::min(row1, mChunkRows - 1);
+        return col0 <= col1 && row0 <= row1;
+    }
+
+    void RequestChunksNear(const ECSEngine::Rect& visibleWorld)
+    {
+        int col0, row0, col1, row1;
+        if (!ChunkRange(visibleWorld, mMargin, col0, row0, col1, row1)) {
+            return;
+        }
+
+        bool requested = false;
+        {
+            std::lock_guard lock(mMutex);
+            for (int row = row0; row <= row1; ++row) {
+                for (int col = col0; col <= col1; ++col) {
+                    const size_t index = static_cast<size_t>(row) * mChunkCols + col;
+                    if (mChunks[index].state == ChunkState::Unloaded) {
+                        mChunks[index].state = ChunkState::Requested;
+                        mRequests.push_back(index);
+                        requested = true;
+                    }
+                }
+            }
+        }
+
+        if (requested) {
+            mWake.notify_all();
+        }
+    }
+
+    bool ApplyReadyChunks(ECSEngine::EntityManager<Components...>& entityManager,
+        ECSEngine::SpriteManager& spriteManager)
+    {
+        std::vector<ChunkTiles> ready;
+        {
+            std::lock_guard lock(mMutex);
+            while (!mFinished.empty() && ready.size() < MAX_CHUNKS_PER_UPDATE) {
+                ready.push_back(std::move(mFinished.front()));
+                mFinished.pop_front();
+            }
+        }
+
+        bool changed = false;
+        for (ChunkTiles& result : ready) {
+            Chunk& chunk = mChunks[result.chunk];
+
+            // Released (or already loaded by a later request) while the worker was busy
+            if (chunk.state != ChunkState::Requested) {
+                continue;
+            }
+
+            entityManager.ReserveEntities(result.tiles.size());
+            entityManager.template ReserveComponents<ECSEngine::LocationComponent,
+                ECSEngine::SpriteComponent>(result.tiles.size());
+            chunk.entities.reserve(result.tiles.size());
+            for (const Placement& tile : result.tiles) {
+                chunk.entities.push_back(
+                    mFactory->Create(entityManager, spriteManager, tile.col, tile.row, tile.tile));
+            }
+
+            chunk.state = ChunkState::Loaded;
+            mLoadedChunks.push_back(result.chunk);
+            changed |= !result.tiles.empty();
+        }
+        return changed;
+    }
+
+    bool ReleaseChunksAwayFrom(const ECSEngine::Rect& visibleWorld,
+        ECSEngine::EntityManager<Components...>& entityManager,
+        ECSEngine::CollisionManager& collisionManager)
+    {
+        int col0 = 0, row0 = 0, col1 = -1, row1 = -1;
+        ChunkRange(visibleWorld, mMargin * 2.0f, col0, row0, col1, row1);
+
+        auto inRange = [&](size_t index) {
+            const int col = static_cast<int>(index % mChunkCols);
+            const int row = static_cast<int>(index / mChunkCols);
+            return col >= col0 && col <= col1 && row >= row0 && row <= row1;
+        };
+
+        bool changed = false;
+
+        // Drop requests the worker hasn't answered yet; their results are ignored
+        {
+            std::lock_guard lock(mMutex);
+            for (size_t index = 0; index < mChunks.size(); ++index) {
+                if (mChunks[index].state == ChunkState::Requested && !inRange(index)) {
+                    mChunks[index].state = ChunkState::Unloaded;
+                }
+            }
+            mRequests.erase(std::remove_if(mRequests.begin(), mRequests.end(),
+                                [&](size_t index) { return !inRange(index); }),
+                mRequests.end());
+        }
+
+        for (size_t i = 0; i < mLoadedChunks.size();) {
+            const size_t index = mLoadedChunks[i];
+            if (inRange(index)) {
+                ++i;
+                continue;
+            }
+
+            Chunk& chunk = mChunks[index];
+            for (ECSEngine::EntityID entity : chunk.entities) {
+                // Keyed by the whole ID, like CollisionSystem inserts them; also wakes sleepers
+                if (entityManager.template HasComponent<ECSEngine::CollisionComponent>(entity)) {
+                    collisionManager.RemoveStatic(entity);
+                }
+                entityManager.RemoveEntity(entity);
+            }
+            changed |= !chunk.entities.empty();
+            chunk.entities.clear();
+            chunk.state = ChunkState::Unloaded;
+
+            mLoadedChunks[i] = mLoadedChunks.back();
+            mLoadedChunks.pop_back();
+        }
+        return changed;
+    }
+
+    // Written by the worker before mReady, read-only afterwards
+    std::string mMapFilePath;
+    std::string mResourcePath;
+    int mLayer;
+    std::unordered_set<char> mPinnedSymbols;
+    std::unordered_set<char> mNonCollidableSymbols;
+    ECSEngine::TileCollisionGrid* mCollisionGrid;
+    int mChunkTiles;
+    std::unique_ptr<ECSEngine::MappedFile> mFile; // Compiled maps
+    MapFormat::MapSource mSource; // Text maps
+    MapView mMap;
+    std::vector<Placement> mPinnedTiles;
+    int mChunkCols = 0;
+    int mChunkRows = 0;
+    bool mFailed = false;
+    std::atomic<bool> mReady { false };
+
+    // Shared with the worker, guarded by mMutex
+    std::mutex mMutex;
+    std::condition_variable mWake;
+    std::deque<size_t> mRequests;
+    std::deque<ChunkTiles> mFinished;
+    bool mStopping = false;
+
+    // Main thread only (chunk states are also read under mMutex when requesting)
+    std::vector<Chunk> mChunks;
+    std::vector<size_t> mLoadedChunks;
+    std::unique_ptr<TileFactory<Components...>> mFactory;
+    MapLayerData mPinned;
+    float mMargin = -1.0f; // Negative until Update() sets the one-chunk default
+    std::thread mWorker; // Last, so it starts after every member it uses exists
+};
@@ -0,0 +1,38 @@
+/**
+ * @file MapCompiler.cpp
+ * @brief Offline tool turning text .map files into compiled .mapb files.
+ * @details Usage: ecsmapc input.map output.mapb [input2.map output2.mapb ...]
+ * The game loads a compiled map by passing its .mapb path to LoadMapLayer().
+ */
+
+#include <iostream>
+#include <string>
+
+#include "MapFormat.h"
+
+int main(int argc, char* argv[])
+{
+    if (argc < 3 || (argc - 1) % 2 != 0) {
+        std::cout << "Usage: " << argv[0] << " input.map output.mapb [input.map output.mapb ...]\n";
+        return 1;
+    }
+
+    int failures = 0;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        const std::string input = argv[i];
+        const std::string output = argv[i + 1];
+
+        MapFormat::MapSource source;
+        if (!MapFormat::ParseMapText(input, source) || !MapFormat::WriteCompiledMap(source, output)) {
+            std::cerr << "Failed to compile " << input << "\n";
+            ++failures;
+            continue;
+        }
+
+        std::cout << "Compiled " << input << " -> " << output << " (" << source.tiles.size()
+                  << " tile types, " << source.info.gridWidth << "x" << source.info.gridHeight
+                  << " cells)\n";
+    }
+
+    return failures == 0 ? 0 : 1;
+}
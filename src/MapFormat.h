@@ -0,0 +1,377 @@
+/**
+ * @file MapFormat.h
+ * @brief Text and compiled (binary) representations of platformer tile maps.
+ * @details The text .map format is what designers edit; MapCompiler turns it into a .mapb
+ * file that loads without any parsing:
+ *
+ *   MapFileHeader
+ *   MapFileTile[tileCount]         tile dictionary
+ *   char[stringBytes]              texture paths, referenced by offset/length
+ *   uint8_t[gridWidth * gridHeight] cells, row-major; a tile index or EMPTY_CELL
+ *
+ * All fields are stored in the host's byte order (little endian on every platform we ship).
+ * Files with a different magic or version are rejected, so recompile maps after changing
+ * this layout.
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "core/MappedFile.h"
+#include "core/MathUtil.h"
+
+/**
+ * @struct TileDef
+ * @brief Defines a single tile type from the map dictionary.
+ */
+struct TileDef {
+    char symbol;                // Character used in map grid
+    std::string texturePath;    // Path to sprite sheet
+    ECSEngine::Rect spriteRect; // Source rectangle in sprite sheet
+    bool hasCollision;          // Whether this tile has collision (dictionary 2)
+    ECSEngine::Rect boundingBox;// Collision bounding box relative to tile (dictionary 2)
+};
+
+/**
+ * @struct MapInfo
+ * @brief The "dictionary" and "map origin" header values of a map.
+ */
+struct MapInfo {
+    int dictType = 0;
+    float originX = 0.0f;
+    float originY = 0.0f;
+    float tileWidth = 0.0f;
+    float tileHeight = 0.0f;
+    int gridWidth = 0;
+    int gridHeight = 0;
+};
+
+/**
+ * @struct MapView
+ * @brief A decoded map layer, with the cell grid borrowed from whoever holds the bytes.
+ */
+struct MapView {
+    MapInfo info;
+    std::vector<TileDef> tiles;
+    const uint8_t* cells = nullptr; // gridWidth * gridHeight tile indices, row-major
+};
+
+namespace MapFormat {
+
+inline constexpr char MAGIC[4] = { 'E', 'C', 'S', 'M' };
+inline constexpr uint32_t VERSION = 1;
+
+// Cell value for '.', ' ' and anything past the end of a grid row
+inline constexpr uint8_t EMPTY_CELL = 0xFF;
+inline constexpr size_t MAX_TILES = EMPTY_CELL;
+
+struct MapFileHeader {
+    char magic[4];
+    uint32_t version;
+    int32_t dictType;
+    float originX, originY;
+    float tileWidth, tileHeight;
+    int32_t gridWidth, gridHeight;
+    uint32_t tileCount;
+    uint32_t stringBytes;
+};
+
+struct MapFileTile {
+    uint32_t pathOffset; // Into the string block
+    uint32_t pathLength;
+    float sprite[4]; // x y w h
+    float bbox[4]; // x y w h, relative to the tile's top-left
+    char symbol;
+    uint8_t hasCollision;
+    uint8_t padding[2];
+};
+
+static_assert(sizeof(MapFileHeader) == 44 && sizeof(MapFileTile) == 44,
+    "Compiled map records must not contain implicit padding");
+
+/**
+ * @struct MapSource
+ * @brief A map layer parsed from text, owning its cell grid.
+ */
+struct MapSource {
+    MapInfo info;
+    std::vector<TileDef> tiles;
+    std::vector<uint8_t> cells;
+
+    MapView View() const { return MapView { info, tiles, cells.data() }; }
+};
+
+/**
+ * @brief Parses a text .map file.
+ * @details Format:
+ *
+ *   dictionary [1 or 2]
+ *   [char] [path] [sprite rect] [bounding box (dict 2 only)]
+ *   ...
+ *   map origin [x y] tile [width height] size [grid_width grid_height]
+ *   [grid of characters]
+ *
+ * @param mapFilePath Path to the .map file
+ * @param out Receives the parsed layer
+ * @return false (after printing why) if the file is missing or malformed
+ */
+inline bool ParseMapText(const std::string& mapFilePath, MapSource& out)
+{
+    std::ifstream file(mapFilePath);
+
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not open map file: " << mapFilePath << std::endl;
+        return false;
+    }
+
+    // Parse dictionary type
+    // see: https://www.geeksforgeeks.org/cpp/processing-strings-using-stdistringstream/
+    std::string line;
+    std::getline(file, line);
+    std::istringstream dictLine(line);
+    std::string dictWord;
+    int dictType;
+
+    // line = "dictionary n" >> dictWord = "dictionary", dictLine = "n" >> dictType = "n", line = EOL
+    // note: ">>" operator returns a reference to the input stream, and the chain is evaluated left to right.
+    //       Thus we have:
+    //          (dictLine >> dictWord) >> dictType;
+    //          (result) >> dictType
+    //       where "result" is the dictLine istringstream pointer to the second whitespace-delimited string
+    dictLine >> dictWord >> dictType;
+
+    // Map file must abide by expected format
+    if (dictWord != "dictionary" || (dictType != 1 && dictType != 2)) {
+        std::cerr << "Error: Invalid dictionary declaration in " << mapFilePath << std::endl;
+        return false;
+    }
+
+    // Parse tile definitions (symbol -> index into out.tiles)
+    std::unordered_map<char, uint8_t> tileIndices;
+
+    while (std::getline(file, line)) {
+        if (line.empty()) continue;
+
+        // Check if we've reached the map section
+        if (line.find("map origin") == 0) {
+            break;
+        }
+
+        std::istringstream iss(line);
+        TileDef tileDef;
+        iss >> tileDef.symbol >> tileDef.texturePath;
+
+        if (dictType == 1) {
+            // Dictionary 1: [char] [path] [x y width height]
+            float x, y, w, h;
+            iss >> x >> y >> w >> h;
+            tileDef.spriteRect = ECSEngine::Rect(x, y, w, h);
+            tileDef.hasCollision = false;
+        } else {
+            // Dictionary 2: [char] [path] [sprite x y w h] [bbox x y w h]
+            float sx, sy, sw, sh;  // sprite rect
+            float bx, by, bw, bh;  // bounding box
+            iss >> sx >> sy >> sw >> sh >> bx >> by >> bw >> bh;
+            tileDef.spriteRect = ECSEngine::Rect(sx, sy, sw, sh);
+            tileDef.boundingBox = ECSEngine::Rect(bx, by, bw, bh);
+            tileDef.hasCollision = true;
+        }
+
+        // Later definitions of a symbol replace earlier ones
+        auto [it, inserted] = tileIndices.try_emplace(tileDef.symbol, out.tiles.size());
+        if (inserted) {
+            if (out.tiles.size() == MAX_TILES) {
+                std::cerr << "Error: Too many tile definitions in " << mapFilePath << std::endl;
+                return false;
+            }
+            out.tiles.push_back(tileDef);
+        } else {
+            out.tiles[it->second] = tileDef;
+        }
+    }
+
+    // Parse map metadata (current line is "map origin ...")
+    std::istringstream mapLine(line);
+    std::string mapWord, originWord, tileWord, sizeWord;
+    MapInfo& info = out.info;
+    info.dictType = dictType;
+
+    mapLine >> mapWord >> originWord >> info.originX >> info.originY
+            >> tileWord >> info.tileWidth >> info.tileHeight
+            >> sizeWord >> info.gridWidth >> info.gridHeight;
+
+    if (mapWord != "map" || originWord != "origin" || tileWord != "tile" || sizeWord != "size"
+        || info.gridWidth < 0 || info.gridHeight < 0) {
+        std::cerr << "Error: Invalid map metadata in " << mapFilePath << std::endl;
+        return false;
+    }
+
+    // Rows missing from the file, and columns past the end of a row, stay empty
+    out.cells.assign(static_cast<size_t>(info.gridWidth) * info.gridHeight, EMPTY_CELL);
+
+    int row = 0;
+    while (row < info.gridHeight && std::getline(file, line)) {
+        if (line.empty()) continue;
+
+        for (int col = 0; col < info.gridWidth && col < static_cast<int>(line.length()); ++col) {
+            char symbol = line[col];
+
+            // Skip empty tiles (period or space)
+            if (symbol == '.' || symbol == ' ') {
+                continue;
+            }
+
+            // Look up tile definition
+            auto it = tileIndices.find(symbol);
+            if (it == tileIndices.end()) {
+                std::cerr << "Warning: Undefined tile symbol '" << symbol << "' at ("
+                          << col << ", " << row << ")" << std::endl;
+                continue;
+            }
+
+            out.cells[static_cast<size_t>(row) * info.gridWidth + col] = it->second;
+        }
+        ++row;
+    }
+
+    return true;
+}
+
+/**
+ * @brief Writes a parsed map in the compiled format.
+ * @return false (after printing why) if the file could not be written
+ */
+inline bool WriteCompiledMap(const MapSource& source, const std::string& outPath)
+{
+    std::string strings;
+    std::vector<MapFileTile> tiles;
+    tiles.reserve(source.tiles.size());
+
+    for (const TileDef& def : source.tiles) {
+        MapFileTile tile {};
+        tile.pathOffset = static_cast<uint32_t>(strings.size());
+        tile.pathLength = static_cast<uint32_t>(def.texturePath.size());
+        tile.sprite[0] = def.spriteRect.topLeft.x;
+        tile.sprite[1] = def.spriteRect.topLeft.y;
+        tile.sprite[2] = static_cast<float>(def.spriteRect.width);
+        tile.sprite[3] = static_cast<float>(def.spriteRect.height);
+        tile.bbox[0] = def.boundingBox.topLeft.x;
+        tile.bbox[1] = def.boundingBox.topLeft.y;
+        tile.bbox[2] = static_cast<float>(def.boundingBox.width);
+        tile.bbox[3] = static_cast<float>(def.boundingBox.height);
+        tile.symbol = def.symbol;
+        tile.hasCollision = def.hasCollision ? 1 : 0;
+
+        strings += def.texturePath;
+        tiles.push_back(tile);
+    }
+
+    MapFileHeader header {};
+    std::memcpy(header.magic, MAGIC, sizeof(MAGIC));
+    header.version = VERSION;
+    header.dictType = source.info.dictType;
+    header.originX = source.info.originX;
+    header.originY = source.info.originY;
+    header.tileWidth = source.info.tileWidth;
+    header.tileHeight = source.info.tileHeight;
+    header.gridWidth = source.info.gridWidth;
+    header.gridHeight = source.info.gridHeight;
+    header.tileCount = static_cast<uint32_t>(tiles.size());
+    header.stringBytes = static_cast<uint32_t>(strings.size());
+
+    std::ofstream file(outPath, std::ios::binary | std::ios::trunc);
+    if (!file.is_open()) {
+        std::cerr << "Error: Could not write compiled map: " << outPath << std::endl;
+        return false;
+    }
+
+    file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    file.write(reinterpret_cast<const char*>(tiles.data()),
+        static_cast<std::streamsize>(tiles.size() * sizeof(MapFileTile)));
+    file.write(strings.data(), static_cast<std::streamsize>(strings.size()));
+    file.write(reinterpret_cast<const char*>(source.cells.data()),
+        static_cast<std::streamsize>(source.cells.size()));
+
+    return static_cast<bool>(file);
+}
+
+/**
+ * @brief Decodes a compiled map held in memory.
+ * @details The returned view's cells point into bytes, which must outlive it.
+ * @param bytes Contents of a .mapb file
+ * @param size Number of bytes
+ * @param out Receives the layer
+ * @return false if the data is not a compiled map of this version, or is truncated
+ */
+inline bool ReadCompiledMap(const uint8_t* bytes, size_t size, MapView& out)
+{
+    MapFileHeader header;
+    if (size < sizeof(header)) {
+        return false;
+    }
+    std::memcpy(&header, bytes, sizeof(header));
+
+    if (std::memcmp(header.magic, MAGIC, sizeof(MAGIC)) != 0 || header.version != VERSION
+        || header.gridWidth < 0 || header.gridHeight < 0) {
+        return false;
+    }
+
+    const size_t tilesOffset = sizeof(header);
+    const size_t stringsOffset = tilesOffset + size_t(header.tileCount) * sizeof(MapFileTile);
+    const size_t cellsOffset = stringsOffset + header.stringBytes;
+    const size_t cellCount = static_cast<size_t>(header.gridWidth) * header.gridHeight;
+
+    if (header.tileCount > MAX_TILES || size < cellsOffset + cellCount) {
+        return false;
+    }
+
+    const char* strings = reinterpret_cast<const char*>(bytes + stringsOffset);
+
+    out.info.dictType = header.dictType;
+    out.info.originX = header.originX;
+    out.info.originY = header.originY;
+    out.info.tileWidth = header.tileWidth;
+    out.info.tileHeight = header.tileHeight;
+    out.info.gridWidth = header.gridWidth;
+    out.info.gridHeight = header.gridHeight;
+
+    out.tiles.clear();
+    out.tiles.reserve(header.tileCount);
+    for (uint32_t i = 0; i < header.tileCount; ++i) {
+        MapFileTile tile;
+        std::memcpy(&tile, bytes + tilesOffset + i * sizeof(MapFileTile), sizeof(tile));
+
+        if (size_t(tile.pathOffset) + tile.pathLength > header.stringBytes) {
+            return false;
+        }
+
+        TileDef def;
+        def.symbol = tile.symbol;
+        def.texturePath.assign(strings + tile.pathOffset, tile.pathLength);
+        def.spriteRect = ECSEngine::Rect(tile.sprite[0], tile.sprite[1], tile.sprite[2], tile.sprite[3]);
+        def.hasCollision = tile.hasCollision != 0;
+        def.boundingBox = ECSEngine::Rect(tile.bbox[0], tile.bbox[1], tile.bbox[2], tile.bbox[3]);
+        out.tiles.push_back(def);
+    }
+
+    out.cells = bytes + cellsOffset;
+
+    // Cells index the dictionary; anything else would read past it while loading
+    for (size_t i = 0; i < cellCount; ++i) {
+        if (out.cells[i] != EMPTY_CELL && out.cells[i] >= header.tileCount) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+} // namespace MapFormat
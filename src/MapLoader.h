@@ -1,7 +1,8 @@
 /**
  * @file MapLoader.h
  * @brief Game-specific map loading for platformer tile maps.
- * @details Loads map files with dictionary-based sprite definitions and tile grids.
+ * @details Loads map files with dictionary-based sprite definitions and tile grids, either
+ * as text (.map) or compiled by MapCompiler (.mapb, see MapFormat.h).
  * Supports two dictionary types:
  *   - Dictionary 1: Background sprites (no collision)
  *   - Dictionary 2: Gameplay sprites (with collision bounding boxes)
@@ -13,31 +14,19 @@
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
-#include <fstream>
-#include <sstream>
 #include <iostream>
 
+#include "MapFormat.h"
 #include "managers/EntityManager.h"
 #include "managers/SpriteManager.h"
 #include "core/MathUtil.h"
+#include "core/TileCollisionGrid.h"
 #include "components/LocationComponent.h"
 #include "components/CollisionComponent.h"
 #include "components/SpriteComponent.h"
 
 extern std::string gResourcePath;
 
-/**
- * @struct TileDef
- * @brief Defines a single tile type from the map dictionary.
- */
-struct TileDef {
-    char symbol;                // Character used in map grid
-    std::string texturePath;    // Path to sprite sheet
-    ECSEngine::Rect spriteRect; // Source rectangle in sprite sheet
-    bool hasCollision;          // Whether this tile has collision (dictionary 2)
-    ECSEngine::Rect boundingBox;// Collision bounding box relative to tile (dictionary 2)
-};
-
 /**
  * @struct MapLayerData
  * @brief Contains information about entities created from a map layer.
@@ -67,193 +56,314 @@ public:
         mSymbolEntities[symbol].push_back(entityID);
     }
 
+    /**
+     * @brief Make room for more entities of a symbol.
+     * @param symbol The character symbol from the map
+     * @param additional Number of entities about to be added
+     */
+    void ReserveEntities(char symbol, size_t additional) {
+        std::vector<ECSEngine::EntityID>& entities = mSymbolEntities[symbol];
+        entities.reserve(entities.size() + additional);
+    }
+
 private:
     std::unordered_map<char, std::vector<ECSEngine::EntityID>> mSymbolEntities;
 };
 
 /**
- * @brief Load a map layer from a file and create entities.
- * @details Parses a map file with the following format:
- *
- *   dictionary [1 or 2]
- *   [char] [path] [sprite rect] [bounding box (dict 2 only)]
- *   ...
- *   map origin [x y] tile [width height] size [grid_width grid_height]
- *   [grid of characters]
- *
- * Dictionary 1: Background tiles (no collision)
- *   Format: [char] [path] [x y width height]
+ * @class TileFactory
+ * @brief Creates the entity for one map cell, registering sprites and names once per tile type.
+ * @details Shared by BuildMapLayer() and LevelStreamer so both produce identical tiles.
  *
- * Dictionary 2: Gameplay tiles (with collision)
- *   Format: [char] [path] [sprite x y w h] [bbox x y w h]
+ * @tparam Components The component types managed by the EntityManager
+ */
+template <typename... Components> class TileFactory {
+public:
+    /**
+     * @param info Header of the layer the cells come from
+     * @param tiles Tile dictionary of the layer
+     * @param resourcePath Base path for resolving texture paths
+     * @param nonCollidableSymbols Set of symbols that should not have collision
+     * @param useCollisionGrid Collidable tiles live in a TileCollisionGrid (see FillCollisionGrid())
+     *        rather than getting a CollisionComponent
+     * @param layer SpriteComponent::layer of the created tiles
+     */
+    TileFactory(const MapInfo& info, std::vector<TileDef> tiles, const std::string& resourcePath,
+        const std::unordered_set<char>& nonCollidableSymbols, bool useCollisionGrid, int layer = 0)
+        : mInfo(info)
+        , mTiles(std::move(tiles))
+        , mResourcePath(resourcePath)
+        , mNeedsCollider(mTiles.size(), false)
+        , mSprites(mTiles.size())
+        , mNames(mTiles.size())
+        , mRegistered(mTiles.size(), false)
+        , mLayer(layer)
+        // Sprite rect is relative to entity location (location = bottom-left)
+        , mSpriteDrawRect(ECSEngine::Point2D(0.0f, -info.tileHeight),
+              static_cast<int>(info.tileWidth), static_cast<int>(info.tileHeight))
+    {
+        for (size_t tile = 0; tile < mTiles.size(); ++tile) {
+            mNeedsCollider[tile] = !useCollisionGrid && mTiles[tile].hasCollision
+                && nonCollidableSymbols.find(mTiles[tile].symbol) == nonCollidableSymbols.end();
+        }
+    }
+
+    // Whether tiles of this type get a CollisionComponent
+    bool NeedsCollider(uint8_t tile) const { return mNeedsCollider[tile]; }
+
+    const TileDef& GetTile(uint8_t tile) const { return mTiles[tile]; }
+
+    /**
+     * @brief Creates the entity for the tile at (col, row).
+     */
+    ECSEngine::EntityID Create(ECSEngine::EntityManager<Components...>& entityManager,
+        ECSEngine::SpriteManager& spriteManager, int col, int row, uint8_t tile)
+    {
+        const TileDef& tileDef = mTiles[tile];
+
+        // Register sprite and name once per tile type
+        if (!mRegistered[tile]) {
+            std::string fullTexturePath = mResourcePath + tileDef.texturePath;
+            mSprites[tile] = spriteManager.RegisterTexture(fullTexturePath, tileDef.spriteRect);
+            mNames[tile] = entityManager.InternName(std::string("tile_") + tileDef.symbol);
+            mRegistered[tile] = true;
+        }
+
+        // Calculate world position (bottom-left of tile)
+        float worldX = mInfo.originX + col * mInfo.tileWidth;
+        float worldY = mInfo.originY + (row + 1) * mInfo.tileHeight;
+
+        // Create entity -- assumes sky and wor
+        ECSEngine::EntityID entity = entityManager.CreateEntity(mNames[tile]);
+
+        // Add location component
+        entityManager.AddComponent(entity, ECSEngine::LocationComponent(worldX, worldY));
+
+        // Map tiles never move, so they are drawn from the cached static batches
+        ECSEngine::SpriteComponent sprite(mSprites[tile], mSpriteDrawRect, true, true, true);
+        sprite.layer = mLayer;
+        entityManager.AddComponent(entity, sprite);
+
+        // Add collision if dictionary type 2 and not in non-collidable set
+        if (mNeedsCollider[tile]) {
+            ECSEngine::Point2D bboxTopLeft = tileDef.boundingBox.topLeft;
+            bboxTopLeft.y -= mInfo.tileHeight; // convert from top-left-based to bottom-left-based offset
+            ECSEngine::Rect collisionRect(
+                bboxTopLeft,
+                tileDef.boundingBox.width,
+                tileDef.boundingBox.height);
+            entityManager.AddComponent(entity, ECSEngine::CollisionComponent(collisionRect, true));
+        }
+
+        return entity;
+    }
+
+private:
+    MapInfo mInfo;
+    std::vector<TileDef> mTiles;
+    std::string mResourcePath;
+    std::vector<bool> mNeedsCollider;
+    std::vector<ECSEngine::SpriteID> mSprites;
+    std::vector<ECSEngine::NameID> mNames;
+    std::vector<bool> mRegistered;
+    int mLayer;
+    ECSEngine::Rect mSpriteDrawRect;
+};
+
+/**
+ * @brief Sizes a static collision layer from a map header and marks its collidable cells.
+ * @param map The decoded layer
+ * @param nonCollidableSymbols Set of symbols that should not have collision
+ * @param collisionGrid The grid to fill
+ */
+inline void FillCollisionGrid(const MapView& map,
+    const std::unordered_set<char>& nonCollidableSymbols, ECSEngine::TileCollisionGrid& collisionGrid)
+{
+    const MapInfo& info = map.info;
+    // Built on the grid's own resource, so the cells move in rather than being copied
+    collisionGrid = ECSEngine::TileCollisionGrid(ECSEngine::Point2D(info.originX, info.originY),
+        info.tileWidth, info.tileHeight, info.gridWidth, info.gridHeight,
+        collisionGrid.GetMemoryResource());
+
+    for (int row = 0; row < info.gridHeight; ++row) {
+        for (int col = 0; col < info.gridWidth; ++col) {
+            const uint8_t tile = map.cells[static_cast<size_t>(row) * info.gridWidth + col];
+            if (tile == MapFormat::EMPTY_CELL) {
+                continue;
+            }
+
+            const TileDef& tileDef = map.tiles[tile];
+            if (tileDef.hasCollision
+                && nonCollidableSymbols.find(tileDef.symbol) == nonCollidableSymbols.end()) {
+                // Bounding box is already relative to the tile's top-left, as the grid expects
+                collisionGrid.SetCell(col, row, collisionGrid.AddShape(tileDef.boundingBox));
+            }
+        }
+    }
+}
+
+/**
+ * @brief Create the entities (and static collision cells) of a decoded map layer.
+ * @details Entity tables and component storages are reserved for the whole layer up front,
+ * so creating thousands of tiles never reallocates them.
  *
  * @tparam Components The component types managed by the EntityManager
- * @param mapFilePath Path to the .map file
+ * @param map The decoded layer
  * @param resourcePath Base path for resolving texture paths
  * @param entityManager Reference to the entity manager for creating entities
  * @param spriteManager Reference to the sprite manager for registering textures
  * @param nonCollidableSymbols Set of symbols that should not have collision (e.g., 'S' for spawners)
+ * @param collisionGrid Optional static collision layer. When given, collidable tiles mark
+ *        solid cells in it (sized from the map header) instead of getting a CollisionComponent.
  * @return MapLayerData containing information about created entities
  */
 template <typename... Components>
-MapLayerData LoadMapLayer(
-    const std::string& mapFilePath,
+MapLayerData BuildMapLayer(
+    const MapView& map,
     const std::string& resourcePath,
     ECSEngine::EntityManager<Components...>& entityManager,
     ECSEngine::SpriteManager& spriteManager,
-    const std::unordered_set<char>& nonCollidableSymbols = {})
+    const std::unordered_set<char>& nonCollidableSymbols = {},
+    ECSEngine::TileCollisionGrid* collisionGrid = nullptr)
 {
     MapLayerData layerData;
-    std::ifstream file(mapFilePath);
+    const MapInfo& info = map.info;
+    const size_t cellCount = static_cast<size_t>(info.gridWidth) * info.gridHeight;
 
-    if (!file.is_open()) {
-        std::cerr << "Error: Could not open map file: " << mapFilePath << std::endl;
-        return layerData;
+    if (collisionGrid) {
+        FillCollisionGrid(map, nonCollidableSymbols, *collisionGrid);
     }
 
-    // Parse dictionary type
-    // see: https://www.geeksforgeeks.org/cpp/processing-strings-using-stdistringstream/
-    std::string line;
-    std::getline(file, line);
-    std::istringstream dictLine(line);
-    std::string dictWord;
-    int dictType;
-
-    // line = "dictionary n" >> dictWord = "dictionary", dictLine = "n" >> dictType = "n", line = EOL
-    // note: ">>" operator returns a reference to the input stream, and the chain is evaluated left to right.
-    //       Thus we have:
-    //          (dictLine >> dictWord) >> dictType;
-    //          (result) >> dictType
-    //       where "result" is the dictLine istringstream pointer to the second whitespace-delimited string
-    dictLine >> dictWord >> dictType;
-
-    // Map file must abide by expected format
-    if (dictWord != "dictionary" || (dictType != 1 && dictType != 2)) {
-        std::cerr << "Error: Invalid dictionary declaration in " << mapFilePath << std::endl;
-        return layerData;
+    TileFactory<Components...> factory(
+        info, map.tiles, resourcePath, nonCollidableSymbols, collisionGrid != nullptr);
+
+    // Count first so every table is sized once
+    std::vector<size_t> useCount(map.tiles.size(), 0);
+    size_t tileCount = 0;
+    size_t colliderCount = 0;
+    for (size_t cell = 0; cell < cellCount; ++cell) {
+        if (map.cells[cell] != MapFormat::EMPTY_CELL) {
+            ++useCount[map.cells[cell]];
+            ++tileCount;
+            colliderCount += factory.NeedsCollider(map.cells[cell]) ? 1 : 0;
+        }
     }
 
-    // Parse tile definitions
-    std::unordered_map<char, TileDef> tileDefs;
+    entityManager.ReserveEntities(tileCount);
+    entityManager.template ReserveComponents<ECSEngine::LocationComponent,
+        ECSEngine::SpriteComponent>(tileCount);
+    entityManager.template ReserveComponents<ECSEngine::CollisionComponent>(colliderCount);
 
-    while (std::getline(file, line)) {
-        if (line.empty()) continue;
+    for (size_t tile = 0; tile < map.tiles.size(); ++tile) {
+        layerData.ReserveEntities(map.tiles[tile].symbol, useCount[tile]);
+    }
 
-        // Check if we've reached the map section
-        if (line.find("map origin") == 0) {
-            break;
-        }
+    // Create entities for each tile
+    for (int row = 0; row < info.gridHeight; ++row) {
+        for (int col = 0; col < info.gridWidth; ++col) {
+            const uint8_t tile = map.cells[static_cast<size_t>(row) * info.gridWidth + col];
+            if (tile == MapFormat::EMPTY_CELL) {
+                continue;
+            }
 
-        std::istringstream iss(line);
-        TileDef tileDef;
-        iss >> tileDef.symbol >> tileDef.texturePath;
-
-        if (dictType == 1) {
-            // Dictionary 1: [char] [path] [x y width height]
-            float x, y, w, h;
-            iss >> x >> y >> w >> h;
-            tileDef.spriteRect = ECSEngine::Rect(x, y, w, h);
-            tileDef.hasCollision = false;
-        } else {
-            // Dictionary 2: [char] [path] [sprite x y w h] [bbox x y w h]
-            float sx, sy, sw, sh;  // sprite rect
-            float bx, by, bw, bh;  // bounding box
-            iss >> sx >> sy >> sw >> sh >> bx >> by >> bw >> bh;
-            tileDef.spriteRect = ECSEngine::Rect(sx, sy, sw, sh);
-            tileDef.boundingBox = ECSEngine::Rect(bx, by, bw, bh);
-            tileDef.hasCollision = true;
+            // Track entity by symbol
+            layerData.AddEntity(map.tiles[tile].symbol,
+                factory.Create(entityManager, spriteManager, col, row, tile));
         }
-
-        tileDefs[tileDef.symbol] = tileDef;
     }
 
-    // Parse map metadata (current line is "map origin ...")
-    std::istringstream mapLine(line);
-    std::string mapWord, originWord, tileWord, sizeWord;
-    float originX, originY, tileWidth, tileHeight;
-    int gridWidth, gridHeight;
-
-    mapLine >> mapWord >> originWord >> originX >> originY
-            >> tileWord >> tileWidth >> tileHeight
-            >> sizeWord >> gridWidth >> gridHeight;
+    return layerData;
+}
 
-    if (mapWord != "map" || originWord != "origin" || tileWord != "tile" || sizeWord != "size") {
-        std::cerr << "Error: Invalid map metadata in " << mapFilePath << std::endl;
-        return layerData;
+/**
+ * @brief Load a compiled (.mapb) map layer and create entities.
+ * @details The file is memory mapped and its cell grid is read in place.
+ * Parameters as for LoadMapLayer().
+ */
+template <typename... Components>
+MapLayerData LoadCompiledMapLayer(
+    const std::string& mapFilePath,
+    const std::string& resourcePath,
+    ECSEngine::EntityManager<Components...>& entityManager,
+    ECSEngine::SpriteManager& spriteManager,
+    const std::unordered_set<char>& nonCollidableSymbols = {},
+    ECSEngine::TileCollisionGrid* collisionGrid = nullptr)
+{
+    ECSEngine::MappedFile file(mapFilePath);
+    if (!file.IsOpen()) {
+        std::cerr << "Error: Could not open map file: " << mapFilePath << std::endl;
+        return {};
     }
 
-    // Parse and create entities from the tile grid
-    std::vector<std::string> gridLines;
-    while (std::getline(file, line)) {
-        if (!line.empty()) {
-            gridLines.push_back(line);
-        }
+    MapView map;
+    if (!MapFormat::ReadCompiledMap(file.Data(), file.Size(), map)) {
+        std::cerr << "Error: Invalid or outdated compiled map " << mapFilePath
+                  << " (recompile it with ecsmapc)" << std::endl;
+        return {};
     }
 
-    // Create entities for each tile
-    for (int row = 0; row < gridHeight && row < static_cast<int>(gridLines.size()); ++row) {
-        const std::string& gridLine = gridLines[row];
-
-        for (int col = 0; col < gridWidth && col < static_cast<int>(gridLine.length()); ++col) {
-            char symbol = gridLine[col];
+    MapLayerData layerData = BuildMapLayer(
+        map, resourcePath, entityManager, spriteManager, nonCollidableSymbols, collisionGrid);
 
-            // Skip empty tiles (period or space)
-            if (symbol == '.' || symbol == ' ') {
-                continue;
-            }
+    std::cout << "Loaded compiled map layer from " << mapFilePath << " (dictionary "
+              << map.info.dictType << ")" << std::endl;
 
-            // Look up tile definition
-            auto it = tileDefs.find(symbol);
-            if (it == tileDefs.end()) {
-                std::cerr << "Warning: Undefined tile symbol '" << symbol << "' at ("
-                          << col << ", " << row << ")" << std::endl;
-                continue;
-            }
+    return layerData;
+}
 
-            const TileDef& tileDef = it->second;
-
-            // Calculate world position (bottom-left of tile)
-            float worldX = originX + col * tileWidth;
-            float worldY = originY + (row + 1) * tileHeight;
-
-            // Create entity -- assumes sky and wor
-            std::string entityName = std::string("tile_") + symbol + "_"
-                                   + std::to_string(col) + "_" + std::to_string(row);
-            ECSEngine::EntityID entity = entityManager.CreateEntity(entityName);
-
-            // Add location component
-            entityManager.AddComponent(entity, ECSEngine::LocationComponent(worldX, worldY));
-
-            // Register sprite and add sprite component
-            std::string fullTexturePath = resourcePath + tileDef.texturePath;
-            ECSEngine::SpriteID spriteID = spriteManager.RegisterTexture(fullTexturePath, tileDef.spriteRect);
-
-            // Sprite rect is relative to entity location (location = bottom-left)
-            ECSEngine::Rect spriteDrawRect(
-                ECSEngine::Point2D(0.0f, -tileHeight),
-                static_cast<int>(tileWidth),
-                static_cast<int>(tileHeight));
-            entityManager.AddComponent(entity, ECSEngine::SpriteComponent(spriteID, spriteDrawRect, true));
-
-            // Add collision component if dictionary type 2 and not in non-collidable set
-            if (tileDef.hasCollision && nonCollidableSymbols.find(symbol) == nonCollidableSymbols.end()) {
-                ECSEngine::Point2D bboxTopLeft = tileDef.boundingBox.topLeft;
-                bboxTopLeft.y -= tileHeight; // convert from top-left-based to bottom-left-based offset
-                ECSEngine::Rect collisionRect(
-                    bboxTopLeft,
-                    tileDef.boundingBox.width,
-                    tileDef.boundingBox.height);
-                entityManager.AddComponent(entity, ECSEngine::CollisionComponent(collisionRect, true));
-            }
+/**
+ * @brief Load a map layer from a file and create entities.
+ * @details Files ending in ".mapb" are read as compiled maps (see LoadCompiledMapLayer());
+ * anything else is parsed as text:
+ *
+ *   dictionary [1 or 2]
+ *   [char] [path] [sprite rect] [bounding box (dict 2 only)]
+ *   ...
+ *   map origin [x y] tile [width height] size [grid_width grid_height]
+ *   [grid of characters]
+ *
+ * Dictionary 1: Background tiles (no collision)
+ *   Format: [char] [path] [x y width height]
+ *
+ * Dictionary 2: Gameplay tiles (with collision)
+ *   Format: [char] [path] [sprite x y w h] [bbox x y w h]
+ *
+ * @tparam Components The component types managed by the EntityManager
+ * @param mapFilePath Path to the .map or .mapb file
+ * @param resourcePath Base path for resolving texture paths
+ * @param entityManager Reference to the entity manager for creating entities
+ * @param spriteManager Reference to the sprite manager for registering textures
+ * @param nonCollidableSymbols Set of symbols that should not have collision (e.g., 'S' for spawners)
+ * @param collisionGrid Optional static collision layer. When given, collidable tiles mark
+ *        solid cells in it (sized from the map header) instead of getting a CollisionComponent.
+ * @return MapLayerData containing information about created entities
+ */
+template <typename... Components>
+MapLayerData LoadMapLayer(
+    const std::string& mapFilePath,
+    const std::string& resourcePath,
+    ECSEngine::EntityManager<Components...>& entityManager,
+    ECSEngine::SpriteManager& spriteManager,
+    const std::unordered_set<char>& nonCollidableSymbols = {},
+    ECSEngine::TileCollisionGrid* collisionGrid = nullptr)
+{
+    const std::string compiledExtension = ".mapb";
+    if (mapFilePath.size() >= compiledExtension.size()
+        && mapFilePath.compare(mapFilePath.size() - compiledExtension.size(),
+               compiledExtension.size(), compiledExtension) == 0) {
+        return LoadCompiledMapLayer(mapFilePath, resourcePath, entityManager, spriteManager,
+            nonCollidableSymbols, collisionGrid);
+    }
 
-            // Track entity by symbol
-            layerData.AddEntity(symbol, entity);
-        }
+    MapFormat::MapSource source;
+    if (!MapFormat::ParseMapText(mapFilePath, source)) {
+        return {};
     }
 
-    file.close();
+    MapLayerData layerData = BuildMapLayer(source.View(), resourcePath, entityManager,
+        spriteManager, nonCollidableSymbols, collisionGrid);
 
-    std::cout << "Loaded map layer from " << mapFilePath << " (dictionary " << dictType << ")" << std::endl;
+    std::cout << "Loaded map layer from " << mapFilePath << " (dictionary " << source.info.dictType << ")" << std::endl;
 
     return layerData;
 }
@@ -77,6 +77,9 @@ EntityID CreatePlayer(const std::string skinPath, const std::string tilesPath,
     Point2D bbTopLeft(width * 0.25f, -height + height * 0.5f);
     Rect boundingBox(bbTopLeft, width * 0.5f, height * 0.5f);
     CollisionComponent collision(boundingBox, false);
+    collision.mask = COLLISION_MASK_ALL & ~COLLISION_LAYER_PICKUP; // Walks through stars
+    collision.restitution = 0.0f; // Stops dead against walls and floors
+    collision.continuous = true; // Fast falls can't skip thin platforms
     entityManager.AddComponent(player, collision);
 
     // Attaches score to the player
@@ -86,6 +89,10 @@ EntityID CreatePlayer(const std::string skinPath, const std::string tilesPath,
     score.digitSprites = scoreDisplay.digitSprites;
     entityManager.AddComponent(player, score);
 
+    // Systems look the player and its score up directly instead of scanning for them
+    entityManager.template RegisterSingleton<InputComponent>(player);
+    entityManager.template RegisterSingleton<ScoreComponent>(player);
+
     return player;
 }
 
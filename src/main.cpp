@@ -7,9 +7,14 @@
  * @copyright Copyright (c) 2025
  */
 
+#include <cstdint>
+#include <filesystem>
 #include <iostream>
+#include <memory>
+#include <string>
 #include <unordered_set>
 
+#include "LevelStreamer.h"
 #include "MapLoader.h"
 #include "PlayerLoader.h"
 #include "ScoreLoader.h"
@@ -21,21 +26,43 @@
 #include "components/ScoreComponent.h"
 #include "components/SpawnComponent.h"
 #include "components/SpriteComponent.h"
+#include "components/TagComponents.h"
 #include "core/ECSEngine.h"
 #include "core/MathUtil.h"
+#include "managers/AssetCache.h"
 #include "managers/EntityManager.h"
 #include "managers/SoundManager.h"
 #include "managers/SpriteManager.h"
 
 std::string gResourcePath = "../../assets/";
 
+// The game's component types, listed once for the engine, its prefabs and its level streamers
+template <template <typename...> class T>
+using WithGameComponents = T<ECSEngine::LocationComponent, ECSEngine::MovementComponent,
+    ECSEngine::AccelerationComponent, ECSEngine::CollisionComponent, ECSEngine::SpriteComponent,
+    ECSEngine::SpawnComponent, ECSEngine::CameraComponent, ECSEngine::CameraFollower,
+    ECSEngine::InputComponent, ECSEngine::CameraShake, ECSEngine::ScoreComponent,
+    ECSEngine::TimeComponent, ECSEngine::StarTag, ECSEngine::MainCameraTag, ECSEngine::Sleeping>;
+
 int main(int argc, char* argv[])
 {
     bool debugMode = false;
-    if (argc >= 3 && argv[1] == std::string("-path")) {
-        gResourcePath = argv[2];
+    uint64_t headlessFrames = 0; // 0 = play in a window
+    std::string recordPath;
+    std::string replayPath;
+    for (int i = 1; i + 1 < argc; i += 2) {
+        if (argv[i] == std::string("-path")) {
+            gResourcePath = argv[i + 1];
+        } else if (argv[i] == std::string("-headless")) {
+            headlessFrames = std::stoull(argv[i + 1]);
+        } else if (argv[i] == std::string("-record")) {
+            recordPath = argv[i + 1];
+        } else if (argv[i] == std::string("-replay")) {
+            replayPath = argv[i + 1];
+        }
     }
-    std::cout << "Usage: " << argv[0] << " [-path resource_path]\n";
+    std::cout << "Usage: " << argv[0]
+              << " [-path resource_path] [-headless frames] [-record log | -replay log]\n";
     std::cout << "Using resource path: " << gResourcePath << "\n";
 
     // Generic entity manager testing
@@ -54,35 +81,97 @@ int main(int argc, char* argv[])
         return 0;
     }
 
+    // Decoded sheets and sounds from earlier runs; outlives the engine's pending loads
+    const ECSEngine::AssetCache assetCache(gResourcePath + "cache");
+
     // ECS Engine Part 1 startup code
-    ECSEngine::ECSEngine<ECSEngine::LocationComponent, ECSEngine::MovementComponent,
-        ECSEngine::AccelerationComponent, ECSEngine::CollisionComponent, ECSEngine::SpriteComponent,
-        ECSEngine::SpawnComponent, ECSEngine::CameraComponent, ECSEngine::CameraFollower,
-        ECSEngine::InputComponent, ECSEngine::CameraShake, ECSEngine::ScoreComponent,
-        ECSEngine::TimeComponent>
-        engine(1024, 768, "Test Engine");
+    using GameEngine = WithGameComponents<ECSEngine::ECSEngine>;
+
+    // Headless runs simulate the same game without a window, sound or textures
+    ECSEngine::HeadlessOptions headless;
+    headless.threadCount = ECSEngine::ThreadPool::DefaultThreadCount();
+    const std::unique_ptr<GameEngine> enginePtr = headlessFrames > 0
+        ? std::make_unique<GameEngine>(headless)
+        : std::make_unique<GameEngine>(1024, 768, "Test Engine");
+    GameEngine& engine = *enginePtr;
 
     auto& spriteManager = engine.GetSpriteManager();
     auto& entityManager = engine.GetEntityManager();
     auto& soundManager = engine.GetSoundManager();
+    spriteManager.SetAssetCache(&assetCache);
+    soundManager.SetAssetCache(&assetCache);
+
+    // Compiled maps (built with ecsmapc) load without parsing; fall back to the text sources
+    auto mapPath = [](const std::string& textPath) {
+        const std::string compiledPath = textPath + "b";
+        return std::filesystem::exists(compiledPath) ? compiledPath : textPath;
+    };
 
     // The Necessary Paths
-    const std::string skyMapPath = gResourcePath + "sky.map";
-    const std::string worldMapPath = gResourcePath + "world.map";
-    const std::string jumpPath = gResourcePath + "sfx_jump.ogg";
-    const std::string gemPath = gResourcePath + "sfx_gem.ogg";
+    const std::string skyMapPath = mapPath(gResourcePath + "sky.map");
+    const std::string worldMapPath = mapPath(gResourcePath + "world.map");
     const std::string tilesTexturePath = gResourcePath + "spritesheet-tiles-default.png";
     const std::string playerSkinPath = gResourcePath + "spritesheet-characters-default.png";
 
-    // Registering Sounds
-    soundManager.RegisterSound(jumpPath, "jump");
-    soundManager.RegisterSound(gemPath, "sparkle");
 
-    // Loads Background and Gameplay Maps (before starting the main loop)
-    LoadMapLayer(skyMapPath, gResourcePath, entityManager, spriteManager);
+    // Sounds and sheets decode on the loader's thread while the maps are parsed below
+    ECSEngine::AssetManifest manifest;
+    if (!ECSEngine::AssetManifest::Load(gResourcePath + "assets.manifest", manifest)) {
+        std::cout << "Asset manifest unavailable, loading assets on first use.\n";
+    }
+
+    auto& assetLoader = engine.GetAssetLoader();
+    for (const ECSEngine::AssetManifest::Sound& sound : manifest.sounds) {
+        soundManager.RegisterSoundAsync(sound.path, sound.name, sound.settings, assetLoader);
+    }
+    for (const std::string& texturePath : manifest.textures) {
+        (void)spriteManager.LoadTextureAsync(texturePath, assetLoader);
+    }
+
+    // Streams Background and Gameplay Maps in chunks around the camera
+    using GamePrefab = WithGameComponents<ECSEngine::Prefab>;
+    using GameStreamer = WithGameComponents<LevelStreamer>;
+    // Sky draws behind the world; spawners stay loaded so stars keep spawning off screen
     const std::unordered_set<char> nonCollidableSymbols { 'S' };
-    const auto worldLayer = LoadMapLayer(
-        worldMapPath, gResourcePath, entityManager, spriteManager, nonCollidableSymbols);
+    const std::unordered_set<char> pinnedSymbols { 'S' };
+    // World tiles collide through a static grid rather than one entity per tile
+    ECSEngine::TileCollisionGrid worldCollision(&engine.GetLevelArena());
+    GameStreamer skyStreamer(skyMapPath, gResourcePath, 0);
+    GameStreamer worldStreamer(worldMapPath, gResourcePath, 1, pinnedSymbols,
+        nonCollidableSymbols, &worldCollision);
+
+    // Packs the sheets we draw from into one texture so batches rarely switch textures
+    assetLoader.Finish();
+    if (!spriteManager.BuildAtlas(manifest.textures)) {
+        std::cout << "Sprite atlas unavailable, drawing from separate sheets.\n";
+    }
+
+    // Collision and spawners are needed before the first step; tiles can arrive later
+    worldStreamer.WaitUntilReady();
+    auto& renderManager = engine.GetRenderManager();
+    auto& windowManager = engine.GetWindowManager();
+    auto& collisionManager = engine.GetCollisionManager();
+    worldStreamer.Update(entityManager, spriteManager, renderManager, collisionManager,
+        windowManager.GetVisibleWorldRect());
+    const MapLayerData& worldLayer = worldStreamer.GetPinnedEntities();
+
+    collisionManager.SetCellSize(worldCollision.GetTileWidth());
+    collisionManager.AddTileLayer(std::move(worldCollision));
+
+    // Creating and removing tile entities has to happen between the parallel stages
+    engine.GetSchedule(ECSEngine::Stage::FrameStart)
+        .AddSystem<ECSEngine::Reads<ECSEngine::CameraComponent, ECSEngine::WindowManager>,
+            ECSEngine::Writes<ECSEngine::EntityStructure, ECSEngine::SpriteManager,
+                ECSEngine::RenderManager, ECSEngine::CollisionManager>>(
+            "LevelStreaming",
+            [&](float) {
+                const ECSEngine::Rect visibleWorld = windowManager.GetVisibleWorldRect();
+                skyStreamer.Update(
+                    entityManager, spriteManager, renderManager, collisionManager, visibleWorld);
+                worldStreamer.Update(
+                    entityManager, spriteManager, renderManager, collisionManager, visibleWorld);
+            },
+            true);
 
     std::cout << "Loaded " << worldLayer.GetEntities('S').size() << " spawners from world map.\n";
 
@@ -92,12 +181,28 @@ int main(int argc, char* argv[])
     ECSEngine::SpriteID starSpriteID
         = spriteManager.RegisterTexture(tilesTexturePath, starSpriteRect);
 
+    // Every spawned star is a copy of this bundle; spawners only add location and velocity
+    // Note: Entity location is bottom-left, so the sprite and collision box extend upwards
+    const ECSEngine::NameID starName = entityManager.InternName("star");
+    const ECSEngine::Rect starBounds(0, -starSpriteRect.height, starSpriteRect.width,
+        starSpriteRect.height);
+    // Stars are pickups: the player collects them instead of bumping into them
+    ECSEngine::CollisionComponent starCollider(starBounds, false); // false = dynamic
+    starCollider.layer = ECSEngine::COLLISION_LAYER_PICKUP;
+    starCollider.continuous = true;
+    starCollider.canSleep = true; // Settled stars stop costing physics time
+    const ECSEngine::PrefabID starPrefab = engine.GetPrefabs().Register(
+        GamePrefab(starName)
+            .Set(ECSEngine::SpriteComponent(starSpriteID, starBounds, true, true))
+            .Set(starCollider)
+            .Set(ECSEngine::StarTag {}));
+
     // Configure each spawner entity
     for (ECSEngine::EntityID spawnerID : worldLayer.GetEntities('S')) {
 
         // Add SpawnComponent to spawner
         ECSEngine::SpawnComponent spawnComp(
-            spawnerID, "star", starSpriteID, 3.0f); // Spawn interval: 3 seconds
+            spawnerID, starPrefab, 3.0f); // Spawn interval: 3 seconds
         spawnComp.maxSpawns = 10; // set to -1 for unlimited
         entityManager.AddComponent(spawnerID, spawnComp);
     }
@@ -116,6 +221,8 @@ int main(int argc, char* argv[])
     camera.position = ECSEngine::Point2D(0.0f, 384.0f);
     camera.worldUnitsPerPixel = 1.0f; // 1 world unit = 1 pixel
     entityManager.AddComponent(cameraEntity, camera);
+    entityManager.AddComponent(cameraEntity, ECSEngine::MainCameraTag {});
+    entityManager.RegisterSingleton<ECSEngine::MainCameraTag>(cameraEntity);
 
     // Camera should follow the player on X, keep Y fixed per spec
     ECSEngine::CameraFollower follower(player, true, false);
@@ -132,7 +239,7 @@ int main(int argc, char* argv[])
     std::cout << "Established Camera!\n";
 
     // Creates Lonely Star
-    ECSEngine::EntityID lonelyStar = entityManager.CreateEntity("star");
+    ECSEngine::EntityID lonelyStar = entityManager.CreateEntity(starName);
     ECSEngine::LocationComponent starLocation(-64.0f, 256.0f);
     ECSEngine::Rect lonelyStarSpriteRect(
         { starLocation.position.x, starLocation.position.y - 64.0f }, 64.0f, 64.0f);
@@ -142,10 +249,45 @@ int main(int argc, char* argv[])
     entityManager.AddComponent(lonelyStar, starSprite);
 
     ECSEngine::CollisionComponent starCollision(lonelyStarSpriteRect, false);
+    starCollision.layer = ECSEngine::COLLISION_LAYER_PICKUP;
     entityManager.AddComponent(lonelyStar, starCollision);
+    entityManager.AddComponent(lonelyStar, ECSEngine::StarTag {});
 
     std::cout << "Created the Lonely Star\n";
 
+    // Physics at a steady 120 Hz; rendering interpolates in between
+    engine.SetFixedTimestep(120.0f);
+
+    // A replayed session brings its own timestep, seed and input
+    if (!replayPath.empty()) {
+        if (!engine.StartReplay(replayPath)) {
+            return 1;
+        }
+    } else if (!recordPath.empty() && !engine.StartRecording(recordPath)) {
+        return 1;
+    }
+
+    if (headlessFrames > 0) {
+        // Scripted player: runs right and jumps once a second
+        engine.SetInputScript([](ECSEngine::InputManager& input, uint64_t frame) {
+            input.SetKey(sf::Keyboard::Scancode::D, true);
+            input.SetKey(sf::Keyboard::Scancode::Space, frame % 120 < 10);
+        });
+
+        sf::Clock clock;
+        engine.RunFrames(headlessFrames);
+        const float seconds = clock.getElapsedTime().asSeconds();
+        const uint64_t frames = engine.GetFrameCount(); // Fewer if a replay ended first
+
+        const ECSEngine::Point2D position
+            = entityManager.GetComponent<ECSEngine::LocationComponent>(player).position;
+        std::cout << "Simulated " << frames << " frames in " << seconds << " s ("
+                  << static_cast<float>(frames) / seconds << " frames/s). Score "
+                  << entityManager.GetComponent<ECSEngine::ScoreComponent>(player).score
+                  << ", player at (" << position.x << ", " << position.y << ")\n";
+        return 0;
+    }
+
     // Runs the game
     engine.Run();
 
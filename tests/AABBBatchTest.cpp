@@ -0,0 +1,178 @@
+/**
+ * @file AABBBatchTest.cpp
+ * @brief Checks that AABBBatch::Overlaps() agrees with OverlapsScalar() and Rect.
+ * @details Usage: aabb_batch_test [--batches n] [--seed n]
+ *
+ * Runs the SIMD path the build was compiled for (AVX, SSE2 or NEON) against the scalar
+ * reference on fixed edge cases and on random batches: same hits in the same order, same
+ * horizontal and vertical depths. Hits are also checked against Rect::RectIntersect() and
+ * the depths CalculateOverlap() computes. Needs no SFML. Exits with 1 on the first
+ * disagreement, printing the batch that caused it.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/AABBBatch.h"
+#include "core/MathUtil.h"
+
+using namespace ECSEngine;
+
+namespace {
+
+// Widest lane count of any path, so sizes around it cover every remainder
+constexpr size_t MAX_LANES = 8;
+
+void PrintBox(const Rect& box)
+{
+    std::cerr << "  (" << box.topLeft.x << ", " << box.topLeft.y << ", " << box.width << ", "
+              << box.height << ")\n";
+}
+
+void PrintCase(const char* name, const Rect& query, const std::vector<Rect>& boxes)
+{
+    std::cerr << "Error: " << name << " failed. Query:\n";
+    PrintBox(query);
+    std::cerr << "Batch of " << boxes.size() << ":\n";
+    for (const Rect& box : boxes) {
+        PrintBox(box);
+    }
+}
+
+bool SameHits(const AABBHits& a, const AABBHits& b)
+{
+    return a.index == b.index && a.horizontal == b.horizontal && a.vertical == b.vertical;
+}
+
+// What the narrowphase does one pair at a time
+AABBHits Reference(const Rect& query, const std::vector<Rect>& boxes)
+{
+    AABBHits hits;
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        const Rect& box = boxes[i];
+        if (!query.RectIntersect(box)) {
+            continue;
+        }
+        hits.index.push_back(static_cast<uint32_t>(i));
+        hits.horizontal.push_back(std::min(query.topLeft.x + query.width, box.topLeft.x + box.width)
+            - std::max(query.topLeft.x, box.topLeft.x));
+        hits.vertical.push_back(std::min(query.topLeft.y + query.height, box.topLeft.y + box.height)
+            - std::max(query.topLeft.y, box.topLeft.y));
+    }
+    return hits;
+}
+
+bool Check(const char* name, const Rect& query, const std::vector<Rect>& boxes)
+{
+    AABBBatch batch;
+    for (const Rect& box : boxes) {
+        batch.Add(box);
+    }
+
+    AABBHits simd;
+    AABBHits scalar;
+    const size_t simdCount = batch.Overlaps(query, simd);
+    const size_t scalarCount = batch.OverlapsScalar(query, scalar);
+
+    if (simdCount != simd.Size() || scalarCount != scalar.Size() || !SameHits(simd, scalar)
+        || !SameHits(scalar, Reference(query, boxes))) {
+        PrintCase(name, query, boxes);
+        return false;
+    }
+    return true;
+}
+
+bool EdgeCases()
+{
+    const Rect query(0.0f, 0.0f, 10.0f, 10.0f);
+    bool ok = Check("empty batch", query, {});
+
+    // Touching on each side (no overlap), then overlapping by a sliver
+    const std::vector<Rect> touching { Rect(10.0f, 0.0f, 5.0f, 5.0f),
+        Rect(-5.0f, 0.0f, 5.0f, 5.0f), Rect(0.0f, 10.0f, 5.0f, 5.0f),
+        Rect(0.0f, -5.0f, 5.0f, 5.0f), Rect(10.0f, 10.0f, 5.0f, 5.0f),
+        Rect(9.5f, 0.0f, 5.0f, 5.0f), Rect(0.0f, 9.5f, 5.0f, 5.0f) };
+    ok = Check("touching edges", query, touching) && ok;
+
+    // Zero-size boxes inside, on the edge and outside, and a zero-size query
+    const std::vector<Rect> empty { Rect(5.0f, 5.0f, 0.0f, 0.0f), Rect(5.0f, 5.0f, 0.0f, 3.0f),
+        Rect(5.0f, 5.0f, 3.0f, 0.0f), Rect(10.0f, 5.0f, 0.0f, 0.0f),
+        Rect(20.0f, 20.0f, 0.0f, 0.0f), Rect(2.0f, 2.0f, 4.0f, 4.0f) };
+    ok = Check("zero-size boxes", query, empty) && ok;
+    ok = Check("zero-size query", Rect(3.0f, 3.0f, 0.0f, 0.0f), empty) && ok;
+
+    // Every remainder after the vector loop, all hits and all misses
+    for (size_t size = 1; size <= 3 * MAX_LANES + 1; ++size) {
+        ok = Check("all hits", query, std::vector<Rect>(size, Rect(1.0f, 1.0f, 2.0f, 2.0f))) && ok;
+        ok = Check("all misses", query, std::vector<Rect>(size, Rect(50.0f, 1.0f, 2.0f, 2.0f)))
+            && ok;
+    }
+    return ok;
+}
+
+// Coordinates on a half-unit grid, so touching edges and equal depths come up often
+bool RandomBatches(int batches, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> size(0, 8 * MAX_LANES + 3);
+    std::uniform_int_distribution<int> position(-40, 40);
+    std::uniform_int_distribution<int> extent(0, 24);
+    auto randomBox = [&] {
+        return Rect(position(rng) * 0.5f, position(rng) * 0.5f, extent(rng) * 0.5f,
+            extent(rng) * 0.5f);
+    };
+
+    std::vector<Rect> boxes;
+    for (int i = 0; i < batches; ++i) {
+        boxes.resize(static_cast<size_t>(size(rng)));
+        std::generate(boxes.begin(), boxes.end(), randomBox);
+        if (!Check("random batch", randomBox(), boxes)) {
+            std::cerr << "Seed " << seed << ", batch " << i << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    int batches = 2000;
+    uint32_t seed = 1234;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--batches" && hasValue) {
+            batches = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--seed" && hasValue) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::cout << "Usage: " << argv[0] << " [--batches n] [--seed n]\n";
+            return 1;
+        }
+    }
+
+    if (!EdgeCases() || !RandomBatches(batches, seed)) {
+        return 1;
+    }
+
+#if defined(ECS_AABB_AVX)
+    const char* path = "AVX";
+#elif defined(ECS_AABB_SSE2)
+    const char* path = "SSE2";
+#elif defined(ECS_AABB_NEON)
+    const char* path = "NEON";
+#else
+    const char* path = "scalar only";
+#endif
+    std::cout << "AABBBatch " << path << ": edge cases and " << batches
+              << " random batches agree" << std::endl;
+    return 0;
+}
@@ -0,0 +1,272 @@
+/**
+ * @file ArchetypeTest.cpp
+ * @brief Checks that ArchetypeEntityManager keeps components intact as entities migrate.
+ * @details Usage: archetype_test [--ops n] [--seed n]
+ *
+ * Every component add and remove moves an entity to another archetype, swap-and-popping its
+ * old row and, with it, the last row of another entity. Fixed cases check that archetypes
+ * are shared between entities with the same signature and reused when an entity comes back
+ * to one. A random run of creates, removes and component toggles is then checked against a
+ * plain model after every operation: validity of live and dead handles, HasComponent() and
+ * every value, and what ForEach() and ForEachChunk() visit. One component is large, so
+ * chunks hold few rows and rows move between chunks; one owns memory, so a component left
+ * behind in a moved-from state shows. Needs no SFML. Exits with 1 on the first disagreement.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "managers/ArchetypeEntityManager.h"
+
+using namespace ECSEngine;
+
+namespace {
+
+struct Position {
+    int value;
+};
+struct Label {
+    std::string value;
+};
+// About a kilobyte, so a chunk holding it has room for only a few rows
+struct Big {
+    int value;
+    char padding[1020];
+};
+struct Marked { };
+
+using TestManager = ArchetypeEntityManager<Position, Label, Big, Marked>;
+
+bool Check(bool condition, const std::string& what)
+{
+    if (!condition) {
+        std::cerr << "Error: " << what << std::endl;
+    }
+    return condition;
+}
+
+bool FixedCases()
+{
+    TestManager entities;
+    bool ok = Check(entities.ArchetypeCount() == 1, "a new manager holds more than one archetype");
+
+    const EntityID a = entities.CreateEntity("a");
+    const EntityID b = entities.CreateEntity("b");
+    entities.AddComponent(a, Position { 1 });
+    entities.AddComponent(a, Label { "a" });
+    entities.AddComponent(b, Position { 2 });
+    entities.AddComponent(b, Label { "b" });
+    ok = Check(entities.ArchetypeCount() == 3, "entities with one signature do not share") && ok;
+
+    // Back to {Position, Label} through {Position, Label, Marked}: no new archetype on return
+    entities.AddComponent(a, Marked {});
+    entities.RemoveComponent<Marked>(a);
+    ok = Check(entities.ArchetypeCount() == 4, "returning to an archetype created another") && ok;
+    ok = Check(entities.GetComponent<Position>(a).value == 1
+            && entities.GetComponent<Label>(a).value == "a"
+            && entities.GetComponent<Position>(b).value == 2
+            && entities.GetComponent<Label>(b).value == "b",
+             "a round trip through another archetype changed a value")
+        && ok;
+
+    // Removing a component already gone, or through a stale handle, does nothing
+    entities.RemoveComponent<Big>(a);
+    entities.RemoveEntity(b);
+    entities.RemoveComponent<Position>(b);
+    const EntityID reused = entities.CreateEntity("reused");
+    ok = Check(EntityIndex(reused) == EntityIndex(b) && !entities.ValidEntity(b),
+             "the reused slot kept the old handle valid")
+        && ok;
+    ok = Check(!entities.HasComponent<Position>(reused), "a reused slot kept components") && ok;
+    ok = Check(entities.GetEntityName(a) == "a" && entities.GetEntityName(reused) == "reused",
+             "names moved with the rows")
+        && ok;
+    return ok;
+}
+
+// What the manager should hold for one live entity
+struct Expected {
+    std::optional<int> position;
+    std::optional<std::string> label;
+    std::optional<int> big;
+    bool marked = false;
+};
+
+bool Agrees(TestManager& entities, const std::map<EntityID, Expected>& live,
+    const std::vector<EntityID>& dead)
+{
+    for (EntityID entity : dead) {
+        if (entities.ValidEntity(entity)) {
+            return Check(false, "stale ID " + std::to_string(entity) + " is valid");
+        }
+    }
+
+    for (const auto& [id, state] : live) {
+        if (!entities.ValidEntity(id)) {
+            return Check(false, "live ID " + std::to_string(id) + " is not valid");
+        }
+        const bool same = entities.HasComponent<Position>(id) == state.position.has_value()
+            && (!state.position || entities.GetComponent<Position>(id).value == *state.position)
+            && entities.HasComponent<Label>(id) == state.label.has_value()
+            && (!state.label || entities.GetComponent<Label>(id).value == *state.label)
+            && entities.HasComponent<Big>(id) == state.big.has_value()
+            && (!state.big || entities.GetComponent<Big>(id).value == *state.big)
+            && entities.HasComponent<Marked>(id) == state.marked;
+        if (!same) {
+            return Check(false, "components of " + std::to_string(id) + " disagree");
+        }
+    }
+
+    // ForEach() over two components visits exactly the entities holding both, once each
+    std::map<EntityID, int> seen;
+    bool twice = false;
+    entities.ForEach<Position, Label>([&](EntityID id, Position& position, Label& label) {
+        const auto& state = live.at(id);
+        twice = twice || !seen.emplace(id, position.value).second;
+        twice = twice || !state.label || label.value != *state.label;
+    });
+    size_t both = 0;
+    for (const auto& [id, state] : live) {
+        if (state.position && state.label) {
+            ++both;
+            auto it = seen.find(id);
+            if (it == seen.end() || it->second != *state.position) {
+                return Check(false, "ForEach() missed " + std::to_string(id));
+            }
+        }
+    }
+    if (!Check(!twice && seen.size() == both, "ForEach() visited the wrong entities")) {
+        return false;
+    }
+
+    // Chunks are never empty, and every row of a chunk holds what was asked for
+    size_t rows = 0;
+    bool packed = true;
+    entities.ForEachChunk<Big>([&](size_t count, const EntityID* ids, Big* bigs) {
+        packed = packed && count > 0;
+        for (size_t row = 0; row < count; ++row) {
+            const auto it = live.find(ids[row]);
+            packed = packed && it != live.end() && it->second.big == bigs[row].value;
+        }
+        rows += count;
+    });
+    const auto withBig = static_cast<size_t>(std::count_if(live.begin(), live.end(),
+        [](const auto& entry) { return entry.second.big.has_value(); }));
+    return Check(packed && rows == withBig, "ForEachChunk() chunks disagree with the model");
+}
+
+bool RandomOperations(int operations, uint32_t seed)
+{
+    TestManager entities;
+    std::map<EntityID, Expected> live;
+    std::vector<EntityID> dead;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> operation(0, 9);
+
+    auto pick = [&] {
+        auto it = live.begin();
+        std::advance(it, std::uniform_int_distribution<size_t>(0, live.size() - 1)(rng));
+        return it;
+    };
+
+    for (int i = 0; i < operations; ++i) {
+        // Grow to a few hundred entities first, so archetypes span several chunks
+        const int op = live.empty() || (i < operations / 4 && i % 2 == 0) ? 0 : operation(rng);
+        const int value = static_cast<int>(rng());
+
+        if (op <= 1) {
+            live.emplace(entities.CreateEntity("e"), Expected {});
+        } else if (op <= 2) {
+            auto it = pick();
+            entities.RemoveEntity(it->first);
+            dead.push_back(it->first);
+            live.erase(it);
+        } else {
+            // Toggle one component type of a random entity
+            auto it = pick();
+            const EntityID entity = it->first;
+            Expected& state = it->second;
+            switch (op % 4) {
+            case 0:
+                if (state.position) {
+                    entities.RemoveComponent<Position>(entity);
+                    state.position.reset();
+                } else {
+                    entities.AddComponent(entity, Position { value });
+                    state.position = value;
+                }
+                break;
+            case 1:
+                if (state.label) {
+                    entities.RemoveComponent<Label>(entity);
+                    state.label.reset();
+                } else {
+                    // Long enough to live on the heap, so a moved-from string shows
+                    const std::string text = std::to_string(value) + std::string(40, 'x');
+                    entities.AddComponent(entity, Label { text });
+                    state.label = text;
+                }
+                break;
+            case 2:
+                if (state.big) {
+                    entities.RemoveComponent<Big>(entity);
+                    state.big.reset();
+                } else {
+                    entities.AddComponent(entity, Big { value, {} });
+                    state.big = value;
+                }
+                break;
+            default:
+                if (state.marked) {
+                    entities.RemoveComponent<Marked>(entity);
+                } else {
+                    entities.AddComponent(entity, Marked {});
+                }
+                state.marked = !state.marked;
+                break;
+            }
+        }
+
+        if (!Agrees(entities, live, dead)) {
+            std::cerr << "Seed " << seed << ", operation " << i << std::endl;
+            return false;
+        }
+    }
+    // Four component types make at most sixteen signatures
+    return Check(entities.ArchetypeCount() <= 16, "more archetypes than signatures");
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    int operations = 3000;
+    uint32_t seed = 1234;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--ops" && hasValue) {
+            operations = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--seed" && hasValue) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::cout << "Usage: " << argv[0] << " [--ops n] [--seed n]\n";
+            return 1;
+        }
+    }
+
+    if (!FixedCases() || !RandomOperations(operations, seed)) {
+        return 1;
+    }
+    std::cout << "ArchetypeEntityManager: fixed cases and " << operations
+              << " random migrations agree" << std::endl;
+    return 0;
+}
@@ -0,0 +1,346 @@
+/**
+ * @file CommandBufferTest.cpp
+ * @brief Checks that EntityCommandBuffer plays commands back in its documented order.
+ * @details Usage: command_buffer_test [--threads n] [--commands n]
+ *
+ * Records commands in the opposite order to the one Playback() applies them in (creates and
+ * acquires, component removals, component additions, entity removals and releases) and
+ * checks the world ends up as if they had been recorded in playback order. Pooled entities
+ * are followed through a whole cycle: acquired with a deferred add, stripped of a component
+ * and released in the same playback, then reused by a later Acquire() that re-arms the
+ * component in place. EntityCommandQueue is checked for playing per-thread buffers in the
+ * order their threads first used them, and for losing nothing when threads record at once.
+ * Needs no SFML. Exits with 1 on the first disagreement.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "managers/EntityCommandBuffer.h"
+#include "managers/EntityManager.h"
+
+using namespace ECSEngine;
+
+namespace {
+
+// One component per storage policy a playback step can touch
+struct Position {
+    int x;
+    int y;
+};
+struct Health {
+    int value;
+};
+struct Timer {
+    int ticks;
+};
+struct Marked { };
+
+}
+
+template <> struct ECSEngine::UseSparseSet<Health> : std::true_type { };
+template <>
+struct ECSEngine::ComponentStoragePolicy<Timer>
+    : std::integral_constant<StoragePolicy, StoragePolicy::Chunked> { };
+
+namespace {
+
+using World = EntityManager<Position, Health, Timer, Marked>;
+using Buffer = EntityCommandBuffer<Position, Health, Timer, Marked>;
+using Queue = EntityCommandQueue<Position, Health, Timer, Marked>;
+using Crate = Prefab<Position, Health, Timer, Marked>;
+using Prefabs = PrefabRegistry<Position, Health, Timer, Marked>;
+
+bool Check(bool condition, const std::string& what)
+{
+    if (!condition) {
+        std::cerr << "Error: " << what << std::endl;
+    }
+    return condition;
+}
+
+// The buffer hands out no EntityIDs, so deferred entities are found by what they hold
+template <typename T> std::vector<EntityID> Holding(World& world)
+{
+    std::vector<EntityID> entities;
+    for (auto [id, component] : world.View<T>()) {
+        entities.push_back(id);
+    }
+    std::sort(entities.begin(), entities.end());
+    return entities;
+}
+
+bool Ordering()
+{
+    World world;
+    Prefabs prefabs;
+    const PrefabID crate = prefabs.Register(
+        Crate(world.InternName("crate")).Set(Position { 7, 8 }).Set(Health { 50 }));
+
+    const EntityID readded = world.CreateEntity("readded");
+    world.AddComponent(readded, Health { 1 });
+    const EntityID kept = world.CreateEntity("kept");
+    const EntityID doomed = world.CreateEntity("doomed");
+    world.AddComponent(doomed, Health { 3 });
+
+    Buffer buffer;
+    bool ok = Check(buffer.Empty(), "a new buffer is not empty");
+
+    // Recorded add first, removal second; removals play first, so both keep a component
+    buffer.AddComponent(readded, Health { 2 });
+    buffer.RemoveComponent<Health>(readded);
+    buffer.AddComponent(kept, Timer { 4 });
+    buffer.RemoveComponent<Timer>(kept);
+
+    // Removed before anything else is recorded, yet adds to it still play, and the creates
+    // recorded after it must not take its slot: they play before it is freed
+    buffer.RemoveEntity(doomed);
+    buffer.AddComponent(doomed, Marked {});
+    buffer.RemoveEntity(doomed); // Twice is harmless
+    buffer.Release(doomed);
+
+    const DeferredEntity created = buffer.CreateEntity(world.InternName("created"));
+    buffer.AddComponent(created, Position { 1, 1 });
+    buffer.AddComponent(created, Marked {});
+    const DeferredEntity instance = buffer.Instantiate(prefabs.Get(crate));
+    buffer.AddComponent(instance, Timer { 9 });
+    const DeferredEntity pooled = buffer.Acquire(prefabs, crate);
+    buffer.AddComponent(pooled, Marked {});
+    ok = Check(!buffer.Empty(), "a buffer holding commands is empty") && ok;
+
+    buffer.Playback(world);
+    ok = Check(buffer.Empty(), "Playback() left commands behind") && ok;
+
+    ok = Check(world.HasComponent<Health>(readded)
+            && world.GetComponent<Health>(readded).value == 2,
+             "a component removal played after an addition")
+        && ok;
+    ok = Check(world.HasComponent<Timer>(kept) && world.GetComponent<Timer>(kept).ticks == 4,
+             "an addition played before a removal")
+        && ok;
+    ok = Check(!world.ValidEntity(doomed), "a removed entity survived playback") && ok;
+
+    // created, instance and pooled, in recording order
+    const std::vector<EntityID> marked = Holding<Marked>(world);
+    const std::vector<EntityID> timed = Holding<Timer>(world);
+    if (!Check(marked.size() == 2 && timed.size() == 2, "deferred adds went missing")) {
+        return false;
+    }
+    const EntityID createdID = marked[0];
+    const EntityID instanceID = timed[0] == kept ? timed[1] : timed[0];
+    const EntityID pooledID = marked[1];
+    ok = Check(createdID < instanceID && instanceID < pooledID,
+             "deferred entities were not created in recording order")
+        && ok;
+    ok = Check(EntityIndex(createdID) != EntityIndex(doomed)
+            && EntityIndex(instanceID) != EntityIndex(doomed)
+            && EntityIndex(pooledID) != EntityIndex(doomed),
+             "a create reused the slot of an entity removed in the same playback")
+        && ok;
+    ok = Check(world.GetEntityName(createdID) == "created"
+            && world.GetComponent<Position>(createdID).x == 1,
+             "a deferred create lost its name or component")
+        && ok;
+    ok = Check(world.GetComponent<Position>(instanceID).x == 7
+            && world.GetComponent<Health>(instanceID).value == 50
+            && world.GetComponent<Timer>(instanceID).ticks == 9,
+             "an instantiated prefab lost its components or the deferred add")
+        && ok;
+    ok = Check(world.IsActive(pooledID) && world.GetEntityName(pooledID) == "crate"
+            && world.GetComponent<Health>(pooledID).value == 50,
+             "an acquired entity lost its prefab components")
+        && ok;
+
+    // The Marked add above was on a valid entity, so the doomed slot is free only now
+    const EntityID after = world.CreateEntity("after");
+    ok = Check(EntityIndex(after) == EntityIndex(doomed), "the removed entity's slot leaked")
+        && ok;
+    ok = Check(!world.HasComponent<Marked>(after), "the reused slot kept a deferred add") && ok;
+    return ok;
+}
+
+bool Pooling()
+{
+    World world;
+    Prefabs prefabs;
+    const PrefabID crate = prefabs.Register(
+        Crate(world.InternName("crate")).Set(Position { 1, 2 }).Set(Health { 5 }));
+    Buffer buffer;
+
+    // 1. Acquire with a deferred add
+    const DeferredEntity first = buffer.Acquire(prefabs, crate);
+    buffer.AddComponent(first, Timer { 10 });
+    buffer.Playback(world);
+    const std::vector<EntityID> timed = Holding<Timer>(world);
+    if (!Check(timed.size() == 1, "the deferred add on an acquired entity went missing")) {
+        return false;
+    }
+    const EntityID crateID = timed[0];
+
+    // 2. Remove a component and release in the same playback. The Acquire plays first, so
+    //    it cannot pick up the entity released here
+    buffer.RemoveComponent<Health>(crateID);
+    buffer.Release(crateID);
+    buffer.Acquire(prefabs, crate);
+    buffer.Playback(world);
+
+    bool ok = Check(world.ValidEntity(crateID) && !world.IsActive(crateID),
+        "a released entity is not pooled");
+    ok = Check(!world.HasComponent<Health>(crateID) && world.HasComponent<Timer>(crateID),
+             "the component removal did not play before the release")
+        && ok;
+    ok = Check(Holding<Health>(world).size() == 1 && Holding<Health>(world)[0] != crateID,
+             "an Acquire reused an entity released in the same playback")
+        && ok;
+    for (auto [id, timer] : world.View<Timer>()) {
+        ok = Check(id != crateID, "a view visits a pooled entity") && ok;
+    }
+
+    // 3. A later Acquire reuses it, restores the prefab's components and re-arms the
+    //    deferred add in place instead of adding a second Timer
+    const uint32_t since = world.AdvanceChangeTick();
+    const DeferredEntity reused = buffer.Acquire(prefabs, crate);
+    buffer.AddComponent(reused, Timer { 20 });
+    buffer.Playback(world);
+
+    ok = Check(world.IsActive(crateID), "the pooled entity was not reused") && ok;
+    ok = Check(world.GetComponent<Health>(crateID).value == 5
+            && world.GetComponent<Position>(crateID).x == 1,
+             "a reused entity did not get its prefab components back")
+        && ok;
+    ok = Check(world.GetComponent<Timer>(crateID).ticks == 20, "the re-armed add was lost") && ok;
+    size_t changed = 0;
+    for (auto [id, timer] : world.View<Timer>(Changed<Timer> { since })) {
+        changed += id == crateID;
+    }
+    ok = Check(changed == 1, "re-arming a pooled component did not mark it changed") && ok;
+
+    // Released then removed in one playback: the pool keeps a stale handle the next
+    // Acquire must skip
+    buffer.Release(crateID);
+    buffer.RemoveEntity(crateID);
+    buffer.Playback(world);
+    ok = Check(!world.ValidEntity(crateID), "removing a released entity failed") && ok;
+
+    buffer.Acquire(prefabs, crate);
+    buffer.Playback(world);
+    for (auto [id, health] : world.View<Health>()) {
+        ok = Check(world.ValidEntity(id) && world.IsActive(id), "Acquire gave out a stale entity")
+            && ok;
+    }
+    ok = Check(Holding<Health>(world).size() == 2, "Acquire after a stale pool entry failed") && ok;
+
+    // Entities that never came from a pool are removed by Release()
+    const EntityID plain = world.CreateEntity("plain");
+    buffer.Release(plain);
+    buffer.Playback(world);
+    ok = Check(!world.ValidEntity(plain), "releasing an unpooled entity kept it") && ok;
+    return ok;
+}
+
+bool PerThread(int threads, int commands)
+{
+    World world;
+    Queue queue;
+    bool ok = Check(&queue.Local() == &queue.Local(), "Local() changed within one thread");
+
+    // One thread after another, so their first use fixes the playback order
+    const NameID name = world.InternName("threaded");
+    for (int t = 0; t < threads; ++t) {
+        std::thread([&, t] {
+            for (int i = 0; i < commands; ++i) {
+                const DeferredEntity entity = queue.Local().CreateEntity(name);
+                queue.Local().AddComponent(entity, Position { t, i });
+            }
+        }).join();
+    }
+    queue.Playback(world);
+
+    // A fresh world hands out slots in creation order
+    const auto total = static_cast<uint32_t>(threads * commands);
+    for (uint32_t index = 0; ok && index < total; ++index) {
+        const EntityID entity = MakeEntityID(index, 0);
+        const auto t = static_cast<int>(index) / commands;
+        const auto i = static_cast<int>(index) % commands;
+        ok = Check(world.ValidEntity(entity) && world.GetComponent<Position>(entity).x == t
+                && world.GetComponent<Position>(entity).y == i,
+            "buffers did not play back in the order their threads first used them");
+    }
+
+    // All at once: each thread strips the entities it created and adds a second component
+    std::vector<std::thread> workers;
+    for (int t = 0; t < threads; ++t) {
+        workers.emplace_back([&, t] {
+            for (int i = 0; i < commands; ++i) {
+                const auto index = static_cast<uint32_t>(t * commands + i);
+                const EntityID entity = MakeEntityID(index, 0);
+                if (i % 2 == 0) {
+                    queue.Local().RemoveEntity(entity);
+                } else {
+                    queue.Local().AddComponent(entity, Health { t });
+                    queue.Local().RemoveComponent<Position>(entity);
+                }
+                queue.Local().AddComponent(queue.Local().CreateEntity(name), Marked {});
+            }
+        });
+    }
+    for (std::thread& worker : workers) {
+        worker.join();
+    }
+    queue.Playback(world);
+
+    size_t healthy = 0;
+    for (uint32_t index = 0; ok && index < total; ++index) {
+        const EntityID entity = MakeEntityID(index, 0);
+        if (index % static_cast<uint32_t>(commands) % 2 == 0) {
+            ok = Check(!world.ValidEntity(entity), "a queued removal was lost");
+            continue;
+        }
+        ok = Check(world.ValidEntity(entity) && !world.HasComponent<Position>(entity)
+                && world.HasComponent<Health>(entity)
+                && world.GetComponent<Health>(entity).value
+                    == static_cast<int>(index) / commands,
+            "a queued component change was lost");
+        ++healthy;
+    }
+    ok = ok && Check(Holding<Marked>(world).size() == total, "a queued create was lost");
+    ok = ok && Check(Holding<Health>(world).size() == healthy, "a stray Health was added");
+
+    // Everything was played and cleared, so a second playback changes nothing
+    queue.Playback(world);
+    ok = ok && Check(Holding<Marked>(world).size() == total, "a buffer played twice");
+    return ok;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    int threads = 4;
+    int commands = 500;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--threads" && hasValue) {
+            threads = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--commands" && hasValue) {
+            commands = std::max(1, std::atoi(argv[++i]));
+        } else {
+            std::cout << "Usage: " << argv[0] << " [--threads n] [--commands n]\n";
+            return 1;
+        }
+    }
+
+    if (!Ordering() || !Pooling() || !PerThread(threads, commands)) {
+        return 1;
+    }
+    std::cout << "EntityCommandBuffer: playback order, pools and " << threads
+              << " thread buffers behave" << std::endl;
+    return 0;
+}
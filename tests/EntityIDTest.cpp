@@ -0,0 +1,279 @@
+/**
+ * @file EntityIDTest.cpp
+ * @brief Checks that generational EntityIDs never let a stale handle reach a slot's new occupant.
+ * @details Usage: entity_id_test [--ops n] [--seed n]
+ *
+ * Fixed cases first (a removed entity's slot is reused under a new generation, stale
+ * handles are refused by every call that takes one), then a random run of creates, removes
+ * and component adds and removes checked against a plain model after every operation:
+ * validity of every live and every dead handle, MakeEntityID() round-trips, HasComponent()
+ * and component values, and what View() visits. Needs no SFML. Exits with 1 on the first
+ * disagreement.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "managers/EntityManager.h"
+
+using namespace ECSEngine;
+
+namespace {
+
+// One component per storage policy a slot can be reused through
+struct Position {
+    int value;
+};
+struct Health {
+    int value;
+};
+struct Debris {
+    int value;
+};
+struct Marked { };
+
+}
+
+template <> struct ECSEngine::UseSparseSet<Health> : std::true_type { };
+template <>
+struct ECSEngine::ComponentStoragePolicy<Debris>
+    : std::integral_constant<StoragePolicy, StoragePolicy::Chunked> { };
+
+namespace {
+
+using TestEntityManager = EntityManager<Position, Health, Debris, Marked>;
+
+bool Check(bool condition, const std::string& what)
+{
+    if (!condition) {
+        std::cerr << "Error: " << what << std::endl;
+    }
+    return condition;
+}
+
+bool RoundTrips(EntityID entity)
+{
+    return MakeEntityID(EntityIndex(entity), EntityGeneration(entity)) == entity;
+}
+
+bool FixedCases()
+{
+    TestEntityManager entities;
+    bool ok = Check(!entities.ValidEntity(INVALID_ENTITY), "INVALID_ENTITY is valid");
+    ok = Check(MakeEntityID(7, 3) == ((EntityID { 3 } << 32) | 7), "MakeEntityID layout") && ok;
+    ok = Check(EntityIndex(MakeEntityID(0xFFFFFFFEu, 0xFFFFFFFFu)) == 0xFFFFFFFEu
+            && EntityGeneration(MakeEntityID(0xFFFFFFFEu, 0xFFFFFFFFu)) == 0xFFFFFFFFu,
+             "index and generation round-trip at their limits")
+        && ok;
+
+    const EntityID old = entities.CreateEntity("old");
+    entities.AddComponent(old, Position { 1 });
+    entities.AddComponent(old, Health { 2 });
+    entities.AddComponent(old, Marked {});
+    entities.RemoveEntity(old);
+
+    const EntityID reused = entities.CreateEntity("new");
+    ok = Check(EntityIndex(reused) == EntityIndex(old), "slot was not reused") && ok;
+    ok = Check(EntityGeneration(reused) != EntityGeneration(old), "generation not bumped") && ok;
+    ok = Check(!entities.ValidEntity(old) && entities.ValidEntity(reused), "stale handle valid")
+        && ok;
+    ok = Check(!entities.HasComponent<Position>(reused) && !entities.HasComponent<Health>(reused)
+            && !entities.HasComponent<Marked>(reused),
+             "new occupant inherited the old one's components")
+        && ok;
+
+    // Calls through the stale handle must leave the new occupant alone
+    entities.AddComponent(reused, Position { 10 });
+    entities.RemoveComponent<Position>(old);
+    entities.RemoveEntity(old);
+    entities.Release(old);
+    ok = Check(entities.ValidEntity(reused) && entities.HasComponent<Position>(reused)
+            && entities.GetComponent<Position>(reused).value == 10,
+             "stale handle reached the new occupant")
+        && ok;
+
+    size_t visited = 0;
+    for (auto [id, position] : entities.View<Position>()) {
+        ok = Check(id == reused && position.value == 10, "view yields the old occupant") && ok;
+        ++visited;
+    }
+    ok = Check(visited == 1, "view size after reuse") && ok;
+    return ok;
+}
+
+// What the manager should hold for one live entity
+struct Expected {
+    std::optional<int> position;
+    std::optional<int> health;
+    std::optional<int> debris;
+    bool marked = false;
+};
+
+template <typename T>
+bool SameView(TestEntityManager& entities, const std::map<EntityID, Expected>& live,
+    std::optional<int> Expected::* field)
+{
+    std::map<EntityID, int> seen;
+    for (auto [id, component] : entities.View<T>()) {
+        if (!seen.emplace(id, component.value).second) {
+            return false; // Visited twice
+        }
+    }
+    size_t expected = 0;
+    for (const auto& [id, state] : live) {
+        if (!(state.*field)) {
+            continue;
+        }
+        ++expected;
+        auto it = seen.find(id);
+        if (it == seen.end() || it->second != *(state.*field)) {
+            return false;
+        }
+    }
+    return seen.size() == expected;
+}
+
+bool Agrees(TestEntityManager& entities, const std::map<EntityID, Expected>& live,
+    const std::vector<EntityID>& dead)
+{
+    for (EntityID entity : dead) {
+        if (entities.ValidEntity(entity)) {
+            return Check(false, "stale ID " + std::to_string(entity) + " is valid");
+        }
+    }
+
+    size_t marked = 0;
+    for (const auto& [id, state] : live) {
+        if (!entities.ValidEntity(id) || !RoundTrips(id)) {
+            return Check(false, "live ID " + std::to_string(id) + " is not valid");
+        }
+        auto same = [&]<typename T>(const std::optional<int>& expected) {
+            if (entities.HasComponent<T>(id) != expected.has_value()) {
+                return false;
+            }
+            return !expected || entities.GetComponent<T>(id).value == *expected;
+        };
+        if (!same.template operator()<Position>(state.position)
+            || !same.template operator()<Health>(state.health)
+            || !same.template operator()<Debris>(state.debris)
+            || entities.HasComponent<Marked>(id) != state.marked) {
+            return Check(false, "components of " + std::to_string(id) + " disagree");
+        }
+        marked += state.marked;
+    }
+
+    size_t markedSeen = 0;
+    for (auto [id, tag] : entities.View<Marked>()) {
+        markedSeen += live.count(id) != 0 && live.at(id).marked;
+    }
+    return Check(SameView<Position>(entities, live, &Expected::position)
+            && SameView<Health>(entities, live, &Expected::health)
+            && SameView<Debris>(entities, live, &Expected::debris) && markedSeen == marked,
+        "a view disagrees with the model");
+}
+
+bool RandomOperations(int operations, uint32_t seed)
+{
+    TestEntityManager entities;
+    std::map<EntityID, Expected> live;
+    std::vector<EntityID> dead;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> operation(0, 9);
+    size_t reusedSlots = 0;
+
+    auto pick = [&] {
+        auto it = live.begin();
+        std::advance(it, std::uniform_int_distribution<size_t>(0, live.size() - 1)(rng));
+        return it;
+    };
+
+    for (int i = 0; i < operations; ++i) {
+        const int op = live.empty() ? 0 : operation(rng);
+        const int value = static_cast<int>(rng());
+
+        if (op <= 2) {
+            const EntityID entity = entities.CreateEntity("e");
+            reusedSlots += EntityGeneration(entity) != 0;
+            live.emplace(entity, Expected {});
+        } else if (op <= 4) {
+            auto it = pick();
+            entities.RemoveEntity(it->first);
+            dead.push_back(it->first);
+            live.erase(it);
+        } else {
+            // Toggle one component type of a random entity
+            auto it = pick();
+            const EntityID entity = it->first;
+            Expected& state = it->second;
+            auto toggle = [&]<typename T>(std::optional<int>& held) {
+                if (held) {
+                    entities.RemoveComponent<T>(entity);
+                    held.reset();
+                } else {
+                    entities.AddComponent(entity, T { value });
+                    held = value;
+                }
+            };
+            switch (op) {
+            case 5:
+                toggle.template operator()<Position>(state.position);
+                break;
+            case 6:
+                toggle.template operator()<Health>(state.health);
+                break;
+            case 7:
+                toggle.template operator()<Debris>(state.debris);
+                break;
+            default:
+                if (state.marked) {
+                    entities.RemoveComponent<Marked>(entity);
+                } else {
+                    entities.AddComponent(entity, Marked {});
+                }
+                state.marked = !state.marked;
+                break;
+            }
+        }
+
+        if (!Agrees(entities, live, dead)) {
+            std::cerr << "Seed " << seed << ", operation " << i << std::endl;
+            return false;
+        }
+    }
+    return Check(reusedSlots > 0, "no slot was ever reused");
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    int operations = 3000;
+    uint32_t seed = 1234;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--ops" && hasValue) {
+            operations = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--seed" && hasValue) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::cout << "Usage: " << argv[0] << " [--ops n] [--seed n]\n";
+            return 1;
+        }
+    }
+
+    if (!FixedCases() || !RandomOperations(operations, seed)) {
+        return 1;
+    }
+    std::cout << "EntityID: fixed cases and " << operations << " random operations agree"
+              << std::endl;
+    return 0;
+}
@@ -0,0 +1,328 @@
+/**
+ * @file SnapshotTest.cpp
+ * @brief Checks that EntityManager snapshots restore a world exactly and refuse damaged ones.
+ * @details Usage: snapshot_test [--seed n]
+ *
+ * Builds a world with holes in every storage (removed entities and components, pooled
+ * entities, a singleton), saves it and loads it into a fresh manager, then compares every
+ * entity and component, and the bytes the restored world saves. The free lists are compared
+ * by what they hand out next: the same creates and adds on both managers must give the same
+ * IDs and the same storage slots. A snapshot cut short at every length must be refused, as
+ * must one from a manager whose storage policies or component types differ. Needs no SFML.
+ * Exits with 1 on the first disagreement.
+ */
+
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "managers/EntityManager.h"
+
+using namespace ECSEngine;
+
+namespace {
+
+// One component per storage policy, plus one that owns memory
+struct Position {
+    float x;
+    float y;
+};
+struct Health {
+    int value;
+};
+struct Debris {
+    int value;
+};
+struct Label {
+    std::string text;
+};
+struct Camera {
+    float zoom;
+};
+struct Marked { };
+
+// Same layout as Position, stored differently
+struct ChunkedPosition {
+    float x;
+    float y;
+};
+
+}
+
+template <> struct ECSEngine::UseSparseSet<Health> : std::true_type { };
+template <>
+struct ECSEngine::ComponentStoragePolicy<Debris>
+    : std::integral_constant<StoragePolicy, StoragePolicy::Chunked> { };
+template <>
+struct ECSEngine::ComponentStoragePolicy<Label>
+    : std::integral_constant<StoragePolicy, StoragePolicy::Chunked> { };
+template <>
+struct ECSEngine::ComponentStoragePolicy<Camera>
+    : std::integral_constant<StoragePolicy, StoragePolicy::Singleton> { };
+template <>
+struct ECSEngine::ComponentStoragePolicy<ChunkedPosition>
+    : std::integral_constant<StoragePolicy, StoragePolicy::Chunked> { };
+
+template <> struct ECSEngine::SnapshotTraits<Label> {
+    static void Write(SnapshotWriter& writer, const Label& label)
+    {
+        writer.WriteString(label.text);
+    }
+
+    static bool Read(SnapshotReader& reader, Label& label) { return reader.ReadString(label.text); }
+};
+
+namespace {
+
+using World = EntityManager<Position, Health, Debris, Label, Camera, Marked>;
+
+bool Check(bool condition, const std::string& what)
+{
+    if (!condition) {
+        std::cerr << "Error: " << what << std::endl;
+    }
+    return condition;
+}
+
+// Loads a snapshot expected to be refused, keeping the error it prints out of the output
+template <typename Manager> bool Refused(Manager& manager, const WorldSnapshot& snapshot)
+{
+    std::streambuf* errors = std::cerr.rdbuf(nullptr);
+    const bool loaded = manager.LoadSnapshot(snapshot);
+    std::cerr.rdbuf(errors);
+    return !loaded;
+}
+
+// Every handle ever created, dead ones included
+struct Built {
+    std::vector<EntityID> handles;
+    PrefabRegistry<Position, Health, Debris, Label, Camera, Marked> prefabs;
+    PrefabID crate = INVALID_PREFAB;
+};
+
+void Build(World& world, Built& built, uint32_t seed)
+{
+    std::mt19937 rng(seed);
+    auto chance = [&](int percent) { return static_cast<int>(rng() % 100) < percent; };
+
+    Prefab<Position, Health, Debris, Label, Camera, Marked> crate(world.InternName("crate"));
+    crate.Set(Position { 1.0f, 2.0f }).Set(Health { 5 });
+    built.crate = built.prefabs.Register(crate);
+
+    // 300 entities spill past one ChunkedStorage chunk
+    for (int i = 0; i < 300; ++i) {
+        const EntityID entity = world.CreateEntity("e" + std::to_string(i % 7));
+        built.handles.push_back(entity);
+        world.AddComponent(entity, Position { static_cast<float>(i), -0.5f * i });
+        if (chance(50)) {
+            world.AddComponent(entity, Health { static_cast<int>(rng()) });
+        }
+        if (chance(40)) {
+            world.AddComponent(entity, Debris { i * 3 });
+        }
+        if (chance(30)) {
+            world.AddComponent(entity, Label { std::string(rng() % 40, 'a' + i % 26) });
+        }
+        if (chance(20)) {
+            world.AddComponent(entity, Marked {});
+        }
+    }
+
+    // Holes: removed entities and components leave free slots behind
+    for (EntityID entity : built.handles) {
+        if (chance(25)) {
+            world.RemoveEntity(entity);
+        } else if (chance(25)) {
+            world.RemoveComponent<Debris>(entity);
+            world.RemoveComponent<Label>(entity);
+        }
+    }
+
+    const EntityID camera = world.CreateEntity("camera");
+    built.handles.push_back(camera);
+    world.AddComponent(camera, Camera { 2.0f });
+    world.RegisterSingleton<Camera>(camera);
+
+    for (int i = 0; i < 6; ++i) {
+        built.handles.push_back(world.Acquire(built.prefabs, built.crate));
+    }
+    world.Release(built.handles[built.handles.size() - 1]);
+    world.Release(built.handles[built.handles.size() - 3]);
+    world.AdvanceChangeTick();
+}
+
+template <typename T, typename Same>
+bool SameComponent(World& a, World& b, EntityID entity, Same same)
+{
+    if (a.HasComponent<T>(entity) != b.HasComponent<T>(entity)) {
+        return false;
+    }
+    return !a.HasComponent<T>(entity) || same(a.GetComponent<T>(entity), b.GetComponent<T>(entity));
+}
+
+bool SameWorld(World& a, World& b, const Built& built)
+{
+    for (EntityID entity : built.handles) {
+        if (a.ValidEntity(entity) != b.ValidEntity(entity)) {
+            return Check(false, "validity of " + std::to_string(entity) + " differs");
+        }
+        if (!a.ValidEntity(entity)) {
+            continue;
+        }
+        const bool same = a.GetEntityName(entity) == b.GetEntityName(entity)
+            && a.IsActive(entity) == b.IsActive(entity)
+            && a.GetComponentMask(entity) == b.GetComponentMask(entity)
+            && SameComponent<Position>(a, b, entity,
+                [](const Position& p, const Position& q) { return p.x == q.x && p.y == q.y; })
+            && SameComponent<Health>(a, b, entity,
+                [](const Health& p, const Health& q) { return p.value == q.value; })
+            && SameComponent<Debris>(a, b, entity,
+                [](const Debris& p, const Debris& q) { return p.value == q.value; })
+            && SameComponent<Label>(a, b, entity,
+                [](const Label& p, const Label& q) { return p.text == q.text; })
+            && SameComponent<Camera>(a, b, entity,
+                [](const Camera& p, const Camera& q) { return p.zoom == q.zoom; })
+            && a.HasComponent<Marked>(entity) == b.HasComponent<Marked>(entity);
+        if (!same) {
+            return Check(false, "entity " + std::to_string(entity) + " differs");
+        }
+    }
+    return Check(a.GetSingleton<Camera>() == b.GetSingleton<Camera>(), "singleton differs");
+}
+
+bool RoundTrip(uint32_t seed)
+{
+    World original;
+    Built built;
+    Build(original, built, seed);
+
+    WorldSnapshot snapshot;
+    original.SaveSnapshot(snapshot);
+
+    World restored;
+    bool ok = Check(restored.LoadSnapshot(snapshot), "loading into a fresh manager failed");
+    ok = ok && SameWorld(original, restored, built);
+
+    WorldSnapshot again;
+    restored.SaveSnapshot(again);
+    ok = ok && Check(again.bytes == snapshot.bytes, "saving the restored world differs");
+
+    // Both free lists, the per-storage ones and the entity one, hand out the same slots
+    for (int i = 0; ok && i < 120; ++i) {
+        const EntityID a = original.CreateEntity("late");
+        const EntityID b = restored.CreateEntity("late");
+        ok = Check(a == b, "entity free lists differ");
+        built.handles.push_back(a);
+        original.AddComponent(a, Debris { i });
+        restored.AddComponent(b, Debris { i });
+        original.AddComponent(a, Label { "late" });
+        restored.AddComponent(b, Label { "late" });
+        if (i % 2 == 0) {
+            original.AddComponent(a, Health { i });
+            restored.AddComponent(b, Health { i });
+        }
+    }
+    ok = ok
+        && Check(original.Acquire(built.prefabs, built.crate)
+                == restored.Acquire(built.prefabs, built.crate),
+            "pools differ");
+
+    // New entities' padding bytes are arbitrary, so compare which slot went to whom
+    auto sameSlots = [&]<typename... Ts>() {
+        return ((original.GetComponentStorage<Ts>().owners()
+                    == restored.GetComponentStorage<Ts>().owners())
+            && ...);
+    };
+    ok = ok && SameWorld(original, restored, built)
+        && Check(sameSlots.template operator()<Position, Health, Debris, Label, Camera, Marked>(),
+            "component free lists differ");
+    return ok;
+}
+
+bool Truncated(uint32_t seed)
+{
+    World original;
+    Built built;
+    Build(original, built, seed);
+    WorldSnapshot snapshot;
+    original.SaveSnapshot(snapshot);
+
+    // Every cut, including one byte short and an empty buffer
+    World target;
+    WorldSnapshot cut;
+    for (size_t size = 0; size < snapshot.bytes.size(); ++size) {
+        cut.bytes.assign(snapshot.bytes.begin(), snapshot.bytes.begin() + size);
+        if (!Check(Refused(target, cut), "a snapshot cut to " + std::to_string(size)
+                    + " of " + std::to_string(snapshot.bytes.size()) + " bytes loaded")) {
+            return false;
+        }
+    }
+
+    // Trailing bytes are a damaged snapshot too
+    cut.bytes = snapshot.bytes;
+    cut.bytes.push_back(0);
+    bool ok = Check(Refused(target, cut), "a snapshot with trailing bytes loaded");
+
+    // A half loaded world recovers by loading a good snapshot over it
+    ok = ok && Check(target.LoadSnapshot(snapshot), "the good snapshot no longer loads")
+        && SameWorld(original, target, built);
+    return ok;
+}
+
+bool Mismatched(uint32_t seed)
+{
+    World original;
+    Built built;
+    Build(original, built, seed);
+    WorldSnapshot snapshot;
+    original.SaveSnapshot(snapshot);
+
+    // Same layout, but Position is chunked
+    EntityManager<ChunkedPosition, Health, Debris, Label, Camera, Marked> otherPolicy;
+    bool ok = Check(Refused(otherPolicy, snapshot), "a different storage policy loaded");
+
+    // One component type fewer
+    EntityManager<Position, Health, Debris, Label, Marked> otherTypes;
+    ok = Check(Refused(otherTypes, snapshot), "a different component set loaded") && ok;
+
+    // Damaged magic and version; the target must stay untouched
+    for (size_t offset : { size_t { 0 }, size_t { 4 } }) {
+        World target;
+        const EntityID kept = target.CreateEntity("kept");
+        target.AddComponent(kept, Health { 42 });
+
+        WorldSnapshot damaged = snapshot;
+        damaged.bytes[offset] ^= 0xFF;
+        ok = Check(Refused(target, damaged), "a damaged header loaded") && ok;
+        ok = Check(target.ValidEntity(kept) && target.GetComponent<Health>(kept).value == 42,
+                 "a refused snapshot changed the world")
+            && ok;
+    }
+    return ok;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    uint32_t seed = 1234;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        if (arg == "--seed" && i + 1 < argc) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::cout << "Usage: " << argv[0] << " [--seed n]\n";
+            return 1;
+        }
+    }
+
+    if (!RoundTrip(seed) || !Truncated(seed) || !Mismatched(seed)) {
+        std::cerr << "Seed " << seed << std::endl;
+        return 1;
+    }
+    std::cout << "Snapshot: round trip, cut short and mismatched snapshots behave" << std::endl;
+    return 0;
+}
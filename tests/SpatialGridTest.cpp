@@ -0,0 +1,185 @@
+/**
+ * @file SpatialGridTest.cpp
+ * @brief Checks SpatialGrid queries against brute force, and that its memory stays bounded.
+ * @details Usage: spatial_grid_test [--bodies n] [--steps n] [--seed n]
+ *
+ * Bodies wander far across the world, rebuilt into a grid every step the way the dynamic
+ * grid is, while static boxes come and go through Insert() and Remove(). Every step, queries
+ * around random boxes must return exactly the IDs whose boxes overlap a queried cell. The
+ * number of cells must stay within what the current boxes cover (plus the cells kept from
+ * the previous step), however far the bodies have travelled, and removing every static box
+ * must leave no cells behind. Needs no SFML. Exits with 1 on the first disagreement.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+#include "core/SpatialGrid.h"
+
+using namespace ECSEngine;
+
+namespace {
+
+bool Check(bool condition, const std::string& what)
+{
+    if (!condition) {
+        std::cerr << "Error: " << what << std::endl;
+    }
+    return condition;
+}
+
+// What Query() should return: every ID with a box sharing a cell with the queried one
+std::vector<size_t> BruteForce(const SpatialGrid& grid, const std::vector<Rect>& boxes,
+    const std::vector<bool>& present, const Rect& query)
+{
+    std::unordered_set<int64_t> cells;
+    grid.ForEachCell(query, [&](int64_t key) { cells.insert(key); });
+
+    std::vector<size_t> ids;
+    for (size_t id = 0; id < boxes.size(); ++id) {
+        bool shared = false;
+        grid.ForEachCell(boxes[id], [&](int64_t key) { shared = shared || cells.count(key); });
+        if (present[id] && shared) {
+            ids.push_back(id);
+        }
+    }
+    return ids;
+}
+
+size_t CellsCovered(const SpatialGrid& grid, const std::vector<Rect>& boxes,
+    const std::vector<bool>& present)
+{
+    std::unordered_set<int64_t> cells;
+    for (size_t id = 0; id < boxes.size(); ++id) {
+        if (present[id]) {
+            grid.ForEachCell(boxes[id], [&](int64_t key) { cells.insert(key); });
+        }
+    }
+    return cells.size();
+}
+
+bool Wander(int bodies, int steps, uint32_t seed)
+{
+    constexpr float CELL = 32.0f;
+    std::mt19937 rng(seed);
+    auto uniform = [&](float low, float high) {
+        return std::uniform_real_distribution<float>(low, high)(rng);
+    };
+
+    SpatialGrid dynamicGrid(CELL);
+    SpatialGrid staticGrid(CELL);
+    std::vector<Rect> moving(static_cast<size_t>(bodies));
+    std::vector<Point2D> velocity(moving.size());
+    for (size_t i = 0; i < moving.size(); ++i) {
+        moving[i] = Rect(uniform(-500.0f, 500.0f), uniform(-500.0f, 500.0f), uniform(1.0f, 80.0f),
+            uniform(1.0f, 80.0f));
+        velocity[i] = Point2D(uniform(-40.0f, 40.0f), uniform(-40.0f, 40.0f));
+    }
+    const std::vector<bool> allMoving(moving.size(), true);
+
+    std::vector<Rect> statics(moving.size());
+    std::vector<bool> placed(statics.size(), false);
+
+    size_t kept = 0; // Cells the previous step covered, which Clear() may keep one step
+    std::vector<size_t> out;
+    for (int step = 0; step < steps; ++step) {
+        dynamicGrid.Clear();
+        for (size_t i = 0; i < moving.size(); ++i) {
+            moving[i].topLeft += velocity[i];
+            dynamicGrid.Insert(i, moving[i]);
+        }
+
+        // Static boxes stream in and out, like LevelStreamer chunks
+        for (int churn = 0; churn < 8; ++churn) {
+            const size_t id = rng() % statics.size();
+            if (placed[id]) {
+                staticGrid.Remove(id, statics[id]);
+            } else {
+                statics[id] = Rect(uniform(-2000.0f, 2000.0f), uniform(-2000.0f, 2000.0f),
+                    uniform(1.0f, 200.0f), uniform(1.0f, 200.0f));
+                staticGrid.Insert(id, statics[id]);
+            }
+            placed[id] = !placed[id];
+        }
+
+        for (int q = 0; q < 16; ++q) {
+            const Rect& near = moving[rng() % moving.size()];
+            const Rect query(near.topLeft.x + uniform(-100.0f, 100.0f),
+                near.topLeft.y + uniform(-100.0f, 100.0f), uniform(0.0f, 150.0f),
+                uniform(0.0f, 150.0f));
+            dynamicGrid.Query(query, out);
+            if (!Check(out == BruteForce(dynamicGrid, moving, allMoving, query),
+                    "dynamic query at step " + std::to_string(step))) {
+                return false;
+            }
+            const Rect area(uniform(-2000.0f, 2000.0f), uniform(-2000.0f, 2000.0f), 300.0f, 300.0f);
+            staticGrid.Query(area, out);
+            if (!Check(out == BruteForce(staticGrid, statics, placed, area),
+                    "static query at step " + std::to_string(step))) {
+                return false;
+            }
+        }
+
+        const size_t covered = CellsCovered(dynamicGrid, moving, allMoving);
+        if (!Check(dynamicGrid.CellCount() <= covered + kept,
+                "the dynamic grid holds " + std::to_string(dynamicGrid.CellCount())
+                    + " cells for " + std::to_string(covered) + " covered at step "
+                    + std::to_string(step))) {
+            return false;
+        }
+        kept = covered;
+        if (!Check(staticGrid.CellCount() == CellsCovered(staticGrid, statics, placed),
+                "the static grid kept cells Remove() emptied")) {
+            return false;
+        }
+    }
+
+    // Everything gone: no cells may be left, in either grid
+    for (size_t id = 0; id < statics.size(); ++id) {
+        if (placed[id]) {
+            staticGrid.Remove(id, statics[id]);
+        }
+    }
+    dynamicGrid.Clear();
+    dynamicGrid.Clear();
+    return Check(staticGrid.CellCount() == 0, "removing every static box left cells behind")
+        && Check(dynamicGrid.CellCount() == 0, "two empty steps left dynamic cells behind");
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    int bodies = 200;
+    int steps = 400;
+    uint32_t seed = 1234;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--bodies" && hasValue) {
+            bodies = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--steps" && hasValue) {
+            steps = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--seed" && hasValue) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::cout << "Usage: " << argv[0] << " [--bodies n] [--steps n] [--seed n]\n";
+            return 1;
+        }
+    }
+
+    if (!Wander(bodies, steps, seed)) {
+        std::cerr << "Seed " << seed << std::endl;
+        return 1;
+    }
+    std::cout << "SpatialGrid: " << bodies << " bodies over " << steps
+              << " steps match brute force in bounded memory" << std::endl;
+    return 0;
+}
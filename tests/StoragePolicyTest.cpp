@@ -0,0 +1,351 @@
+/**
+ * @file StoragePolicyTest.cpp
+ * @brief Checks that component traits pick the documented storage, and that each one behaves.
+ * @details Usage: storage_policy_test [--ops n] [--seed n]
+ *
+ * The policy defaults (empty types are tags, UseSparseSet types sparse, the rest dense) and
+ * the StorageFor mapping are checked at compile time, as is that explicit policies win over
+ * the defaults. At run time the same adds, removes and writes go through one component of
+ * every policy and are compared against a model after each operation, through
+ * HasComponent(), GetComponent() and View(). The singleton holder is followed as it moves
+ * between entities, is deactivated and removed; GetMemoryUsage() must name every type,
+ * count what each storage holds and include the room ExpectedCapacity reserved. Needs no
+ * SFML. Exits with 1 on the first disagreement.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <optional>
+#include <random>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "managers/EntityManager.h"
+
+using namespace ECSEngine;
+
+namespace {
+
+struct Position {
+    int value;
+};
+struct Velocity {
+    int value;
+};
+struct Debris {
+    int value;
+};
+struct Camera {
+    int value;
+};
+struct Marked { };
+// Empty, yet explicitly dense: explicit policies win over the defaults
+struct Placeholder { };
+
+}
+
+template <> struct ECSEngine::UseSparseSet<Velocity> : std::true_type { };
+template <>
+struct ECSEngine::ComponentStoragePolicy<Debris>
+    : std::integral_constant<StoragePolicy, StoragePolicy::Chunked> { };
+template <>
+struct ECSEngine::ComponentStoragePolicy<Camera>
+    : std::integral_constant<StoragePolicy, StoragePolicy::Singleton> { };
+template <>
+struct ECSEngine::ComponentStoragePolicy<Placeholder>
+    : std::integral_constant<StoragePolicy, StoragePolicy::Dense> { };
+template <> struct ECSEngine::ExpectedCapacity<Position> : std::integral_constant<size_t, 512> { };
+
+namespace {
+
+static_assert(ComponentStoragePolicy<Position>::value == StoragePolicy::Dense);
+static_assert(ComponentStoragePolicy<Velocity>::value == StoragePolicy::Sparse);
+static_assert(ComponentStoragePolicy<Debris>::value == StoragePolicy::Chunked);
+static_assert(ComponentStoragePolicy<Camera>::value == StoragePolicy::Singleton);
+static_assert(ComponentStoragePolicy<Marked>::value == StoragePolicy::Tag);
+static_assert(ComponentStoragePolicy<Placeholder>::value == StoragePolicy::Dense);
+
+static_assert(std::is_same_v<StorageFor<Position>, ComponentStorage<Position>>);
+static_assert(std::is_same_v<StorageFor<Velocity>, SparseSetStorage<Velocity>>);
+static_assert(std::is_same_v<StorageFor<Debris>, ChunkedStorage<Debris>>);
+static_assert(std::is_same_v<StorageFor<Camera>, SingletonStorage<Camera>>);
+static_assert(std::is_same_v<StorageFor<Marked>, TagStorage<Marked>>);
+static_assert(std::is_same_v<StorageFor<Placeholder>, ComponentStorage<Placeholder>>);
+
+using World = EntityManager<Position, Velocity, Debris, Camera, Marked, Placeholder>;
+
+static_assert(std::is_same_v<decltype(std::declval<World&>().GetComponentStorage<Camera>()),
+    SingletonStorage<Camera>&>);
+
+bool Check(bool condition, const std::string& what)
+{
+    if (!condition) {
+        std::cerr << "Error: " << what << std::endl;
+    }
+    return condition;
+}
+
+// What the manager should hold for one live entity; the camera is tracked separately
+struct Expected {
+    std::optional<int> position;
+    std::optional<int> velocity;
+    std::optional<int> debris;
+    bool marked = false;
+    bool placeholder = false;
+};
+
+template <typename T>
+bool SameView(World& world, const std::map<EntityID, Expected>& live,
+    std::optional<int> Expected::* field)
+{
+    std::map<EntityID, int> seen;
+    for (auto [id, component] : world.View<T>()) {
+        if (!seen.emplace(id, component.value).second) {
+            return false;
+        }
+    }
+    size_t expected = 0;
+    for (const auto& [id, state] : live) {
+        if (state.*field) {
+            ++expected;
+            auto it = seen.find(id);
+            if (it == seen.end() || it->second != *(state.*field)) {
+                return false;
+            }
+        }
+    }
+    return seen.size() == expected;
+}
+
+template <typename T>
+bool SameTags(World& world, const std::map<EntityID, Expected>& live, bool Expected::* field)
+{
+    size_t seen = 0;
+    for (auto [id, tag] : world.View<T>()) {
+        auto it = live.find(id);
+        if (it == live.end() || !(it->second.*field)) {
+            return false;
+        }
+        ++seen;
+    }
+    return seen == static_cast<size_t>(std::count_if(live.begin(), live.end(),
+               [&](const auto& entry) { return entry.second.*field; }));
+}
+
+bool Agrees(World& world, const std::map<EntityID, Expected>& live, EntityID cameraHolder,
+    int cameraValue)
+{
+    for (const auto& [id, state] : live) {
+        auto same = [&]<typename T>(const std::optional<int>& expected) {
+            return world.HasComponent<T>(id) == expected.has_value()
+                && (!expected || world.GetComponent<T>(id).value == *expected);
+        };
+        const bool agrees = world.ValidEntity(id)
+            && same.template operator()<Position>(state.position)
+            && same.template operator()<Velocity>(state.velocity)
+            && same.template operator()<Debris>(state.debris)
+            && world.HasComponent<Marked>(id) == state.marked
+            && world.HasComponent<Placeholder>(id) == state.placeholder
+            && world.HasComponent<Camera>(id) == (id == cameraHolder);
+        if (!agrees) {
+            return Check(false, "components of " + std::to_string(id) + " disagree");
+        }
+    }
+    if (!Check(SameView<Position>(world, live, &Expected::position)
+                && SameView<Velocity>(world, live, &Expected::velocity)
+                && SameView<Debris>(world, live, &Expected::debris)
+                && SameTags<Marked>(world, live, &Expected::marked)
+                && SameTags<Placeholder>(world, live, &Expected::placeholder),
+            "a view disagrees with the model")) {
+        return false;
+    }
+
+    size_t cameras = 0;
+    for (auto [id, camera] : world.View<Camera>()) {
+        cameras += id == cameraHolder && camera.value == cameraValue ? 1 : 100;
+    }
+    return Check(cameras == (cameraHolder != INVALID_ENTITY ? 1u : 0u)
+            && world.GetSingleton<Camera>() == cameraHolder,
+        "the singleton view or holder disagrees");
+}
+
+bool RandomOperations(int operations, uint32_t seed)
+{
+    World world;
+    std::map<EntityID, Expected> live;
+    EntityID cameraHolder = INVALID_ENTITY;
+    int cameraValue = 0;
+    std::mt19937 rng(seed);
+    std::uniform_int_distribution<int> operation(0, 11);
+
+    auto pick = [&] {
+        auto it = live.begin();
+        std::advance(it, std::uniform_int_distribution<size_t>(0, live.size() - 1)(rng));
+        return it;
+    };
+    auto toggle = [&]<typename T>(EntityID entity, std::optional<int>& held, int value) {
+        if (held) {
+            world.RemoveComponent<T>(entity);
+            held.reset();
+        } else {
+            world.AddComponent(entity, T { value });
+            held = value;
+        }
+    };
+    auto toggleTag = [&]<typename T>(EntityID entity, bool& held) {
+        if (held) {
+            world.RemoveComponent<T>(entity);
+        } else {
+            world.AddComponent(entity, T {});
+        }
+        held = !held;
+    };
+
+    for (int i = 0; i < operations; ++i) {
+        const int op = live.empty() ? 0 : operation(rng);
+        const int value = static_cast<int>(rng());
+
+        if (op <= 1) {
+            live.emplace(world.CreateEntity("e"), Expected {});
+            continue;
+        }
+
+        auto it = pick();
+        const EntityID entity = it->first;
+        Expected& state = it->second;
+        switch (op) {
+        case 2:
+            if (entity == cameraHolder) {
+                cameraHolder = INVALID_ENTITY;
+            }
+            world.RemoveEntity(entity);
+            live.erase(it);
+            break;
+        case 3:
+            toggle.template operator()<Position>(entity, state.position, value);
+            break;
+        case 4:
+            toggle.template operator()<Velocity>(entity, state.velocity, value);
+            break;
+        case 5:
+            toggle.template operator()<Debris>(entity, state.debris, value);
+            break;
+        case 6:
+            toggleTag.template operator()<Marked>(entity, state.marked);
+            break;
+        case 7:
+            toggleTag.template operator()<Placeholder>(entity, state.placeholder);
+            break;
+        case 8:
+            // The camera moves: only one entity can hold a singleton at a time
+            if (cameraHolder != INVALID_ENTITY) {
+                world.RemoveComponent<Camera>(cameraHolder);
+            }
+            world.AddComponent(entity, Camera { value });
+            cameraHolder = entity;
+            cameraValue = value;
+            break;
+        default:
+            // Writes through GetComponent() land in the right slot
+            if (state.position) {
+                world.GetComponent<Position>(entity).value = value;
+                state.position = value;
+            }
+            if (state.debris) {
+                world.GetComponent<Debris>(entity).value = value + 1;
+                state.debris = value + 1;
+            }
+            break;
+        }
+
+        if (!Agrees(world, live, cameraHolder, cameraValue)) {
+            std::cerr << "Seed " << seed << ", operation " << i << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+bool Singleton()
+{
+    World world;
+    bool ok = Check(world.GetSingleton<Camera>() == INVALID_ENTITY, "a singleton without holder");
+
+    const EntityID first = world.CreateEntity("first");
+    world.AddComponent(first, Camera { 1 });
+    ok = Check(world.GetSingleton<Camera>() == first, "the holder is not the singleton") && ok;
+
+    // Inactive holders are hidden, like from every view
+    world.DeactivateEntity(first);
+    ok = Check(world.GetSingleton<Camera>() == INVALID_ENTITY, "an inactive holder is returned")
+        && ok;
+    world.ActivateEntity(first);
+
+    world.RemoveEntity(first);
+    const EntityID second = world.CreateEntity("second");
+    world.AddComponent(second, Camera { 2 });
+    ok = Check(world.GetSingleton<Camera>() == second
+            && world.GetComponent<Camera>(second).value == 2,
+             "the singleton did not follow its new holder")
+        && ok;
+    return ok;
+}
+
+bool Memory()
+{
+    World world;
+    const std::vector<World::ComponentMemory> before = world.GetMemoryUsage();
+    // Only ECSEngine:: is stripped; these types keep their anonymous namespace prefix
+    bool ok = Check(before.size() == 6 && before[0].type.ends_with("::Position")
+            && before[3].type.ends_with("::Camera") && before[5].type.ends_with("::Placeholder"),
+        "memory report names");
+    ok = Check(before[0].bytes >= 512 * sizeof(Position) && before[0].count == 0,
+             "ExpectedCapacity did not reserve the dense storage")
+        && ok;
+
+    for (int i = 0; i < 100; ++i) {
+        const EntityID entity = world.CreateEntity("e");
+        world.AddComponent(entity, Marked {});
+        if (i % 2 == 0) {
+            world.AddComponent(entity, Velocity { i });
+        }
+    }
+    const std::vector<World::ComponentMemory> after = world.GetMemoryUsage();
+    ok = Check(after[1].count == 50 && after[4].count == 100 && after[0].count == 0,
+             "memory report counts")
+        && ok;
+    ok = Check(after[0].bytes == before[0].bytes, "an untouched storage grew") && ok;
+    return ok;
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    int operations = 3000;
+    uint32_t seed = 1234;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--ops" && hasValue) {
+            operations = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--seed" && hasValue) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::cout << "Usage: " << argv[0] << " [--ops n] [--seed n]\n";
+            return 1;
+        }
+    }
+
+    if (!Singleton() || !Memory() || !RandomOperations(operations, seed)) {
+        return 1;
+    }
+    std::cout << "Storage policies: traits, singleton, memory and " << operations
+              << " random operations agree" << std::endl;
+    return 0;
+}
@@ -0,0 +1,310 @@
+/**
+ * @file TimerWheelTest.cpp
+ * @brief Checks that TimerWheel fires every timer on exactly its tick, on every level.
+ * @details Usage: timer_wheel_test [--timers n] [--seed n]
+ *
+ * A brute-force reference keeps every scheduled (entity, tick) entry in a list. After each
+ * Advance(), the batch must hold exactly the entries whose tick lies between the ticks
+ * before and after the call, ordered by tick, then entity. Fixed cases cover delays on and
+ * around each level boundary, ticks in the past and past MAX_DELAY, scheduling after an
+ * empty wheel skipped ahead, and single tick steps. A random run schedules, re-arms and
+ * cancels timers spread over all four levels, the way TimeSystem does (stale entries fire
+ * and are skipped by their owner), and checks each live timer fires exactly once. Needs no
+ * SFML. Exits with 1 on the first disagreement.
+ */
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <iostream>
+#include <map>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "core/TimerWheel.h"
+
+using namespace ECSEngine;
+
+namespace {
+
+using Tick = TimerWheel::Tick;
+
+bool Check(bool condition, const std::string& what)
+{
+    if (!condition) {
+        std::cerr << "Error: " << what << std::endl;
+    }
+    return condition;
+}
+
+// Span of level n: delays below LevelSpan(n + 1) are filed on level n or below
+constexpr Tick LevelSpan(unsigned level) { return Tick { 1 } << (TimerWheel::SLOT_BITS * level); }
+
+class Reference {
+public:
+    explicit Reference(TimerWheel& wheel)
+        : mWheel(wheel)
+    {
+    }
+
+    // Schedules on both, with the wheel's documented clamping applied to the reference
+    void Schedule(EntityID entity, Tick tick)
+    {
+        const Tick now = mWheel.GetTick();
+        mEntries.push_back({ entity, std::clamp(tick, now + 1, now + TimerWheel::MAX_DELAY) });
+        mWheel.Schedule(entity, tick);
+    }
+
+    // Advances the wheel by about ticks and compares the batch against the entries due
+    bool Advance(Tick ticks, std::vector<TimerWheel::Timer>& fired)
+    {
+        const Tick before = mWheel.GetTick();
+        const double seconds = static_cast<double>(ticks) * TimerWheel::TICK_SECONDS;
+        const auto& batch = mWheel.Advance(static_cast<float>(seconds));
+        const Tick after = mWheel.GetTick();
+
+        std::vector<TimerWheel::Timer> due;
+        auto split = std::partition(mEntries.begin(), mEntries.end(), [&](const auto& timer) {
+            return timer.tick <= before || timer.tick > after;
+        });
+        due.assign(split, mEntries.end());
+        mEntries.erase(split, mEntries.end());
+        std::sort(due.begin(), due.end(), [](const auto& a, const auto& b) {
+            return a.tick != b.tick ? a.tick < b.tick : a.entity < b.entity;
+        });
+
+        auto sameTimer = [](const auto& a, const auto& b) {
+            return a.entity == b.entity && a.tick == b.tick;
+        };
+        const bool same = batch.size() == due.size()
+            && std::equal(batch.begin(), batch.end(), due.begin(), sameTimer);
+        if (!same) {
+            std::cerr << "Error: ticks " << before << " to " << after << " fired " << batch.size()
+                      << " timers, expected " << due.size() << std::endl;
+            for (const auto& timer : due) {
+                std::cerr << "  expected entity " << timer.entity << " at " << timer.tick << "\n";
+            }
+            for (const auto& timer : batch) {
+                std::cerr << "  fired entity " << timer.entity << " at " << timer.tick << "\n";
+            }
+            return false;
+        }
+        fired.assign(batch.begin(), batch.end());
+        return Check(mWheel.size() == mEntries.size(), "size() disagrees with the reference");
+    }
+
+    bool Empty() const { return mEntries.empty(); }
+
+private:
+    TimerWheel& mWheel;
+    std::vector<TimerWheel::Timer> mEntries;
+};
+
+bool Conversions()
+{
+    TimerWheel wheel;
+    bool ok = Check(TimerWheel::TicksFor(0.0f) == 1, "TicksFor(0) must be one tick");
+    ok = Check(TimerWheel::TicksFor(0.0015f) == 2, "TicksFor() must round up") && ok;
+    ok = Check(TimerWheel::TicksFor(1.0e12f) == TimerWheel::MAX_DELAY, "TicksFor() must clamp")
+        && ok;
+    ok = Check(wheel.TickAfter(0.25f) == 250, "TickAfter()") && ok;
+    ok = Check(wheel.SecondsUntil(0) == 0.0f, "SecondsUntil() a past tick") && ok;
+    return ok;
+}
+
+// Delays on and around every level boundary, from a few starting ticks
+bool Boundaries()
+{
+    std::vector<Tick> delays { 1, 2 };
+    for (unsigned level = 1; level < TimerWheel::LEVELS; ++level) {
+        for (Tick offset : { Tick { 0 }, Tick { 1 }, Tick { 2 } }) {
+            delays.push_back(LevelSpan(level) - offset);
+            delays.push_back(LevelSpan(level) + offset);
+        }
+        // A slot past the first of a level, short of the top level's to keep the run short
+        if (level + 1 < TimerWheel::LEVELS) {
+            delays.push_back(LevelSpan(level) * 3 + 7);
+        }
+    }
+    const Tick longest = *std::max_element(delays.begin(), delays.end());
+
+    // From 0, from just before a level 1 wrap, and from an odd tick reached by skipping
+    for (Tick start : { Tick { 0 }, LevelSpan(1) - 1, LevelSpan(2) * 5 + 123 }) {
+        TimerWheel wheel;
+        Reference reference(wheel);
+        std::vector<TimerWheel::Timer> fired;
+
+        // Nothing scheduled, so this skips ahead in one go (float seconds may fall a tick short)
+        while (wheel.GetTick() < start) {
+            if (!reference.Advance(start - wheel.GetTick(), fired)) {
+                return false;
+            }
+        }
+        if (!Check(wheel.GetTick() == start, "skip ahead")) {
+            return false;
+        }
+
+        EntityID entity = 0;
+        for (Tick delay : delays) {
+            reference.Schedule(entity++, start + delay);
+        }
+        reference.Schedule(entity++, start); // Now: fires on the next tick
+        reference.Schedule(entity++, start > 10 ? start - 10 : 0); // Past
+        reference.Schedule(entity++, start + TimerWheel::MAX_DELAY + 99); // Clamped
+
+        // Single ticks around each expiry, big steps in between
+        std::vector<Tick> expiries;
+        for (Tick delay : delays) {
+            expiries.push_back(start + delay);
+        }
+        std::sort(expiries.begin(), expiries.end());
+        for (Tick expiry : expiries) {
+            while (wheel.GetTick() + 2 < expiry) {
+                const Tick step = std::min<Tick>(expiry - 2 - wheel.GetTick(), 250000);
+                if (!reference.Advance(step, fired)) {
+                    return false;
+                }
+            }
+            while (wheel.GetTick() < expiry + 2) {
+                if (!reference.Advance(1, fired)) {
+                    return false;
+                }
+            }
+        }
+        if (!Check(wheel.GetTick() >= start + longest, "boundary run ended early")) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Timers spread over all levels, re-armed and cancelled while they run
+bool RandomRun(int timers, uint32_t seed)
+{
+    TimerWheel wheel;
+    Reference reference(wheel);
+    std::mt19937_64 rng(seed);
+
+    // Owner state, like TimeComponent::expiryTick: 0 = stopped
+    std::map<EntityID, Tick> expiry;
+    std::map<EntityID, int> firings;
+
+    auto randomDelay = [&] {
+        // A random level, then uniform within it, with extra weight on exact boundaries
+        const unsigned level = static_cast<unsigned>(rng() % TimerWheel::LEVELS);
+        if (rng() % 8 == 0) {
+            return std::max<Tick>(1, LevelSpan(level) + static_cast<Tick>(rng() % 3) - 1);
+        }
+        // The top level only just past its start: every tick up to there is stepped through
+        if (level + 1 == TimerWheel::LEVELS) {
+            return LevelSpan(level) + rng() % (LevelSpan(level - 1) * 8);
+        }
+        return std::max<Tick>(1, rng() % LevelSpan(level + 1));
+    };
+    auto start = [&](EntityID entity) {
+        const Tick tick = wheel.GetTick() + randomDelay();
+        expiry[entity] = tick;
+        reference.Schedule(entity, tick);
+    };
+
+    for (int i = 0; i < timers; ++i) {
+        start(static_cast<EntityID>(i));
+    }
+
+    std::vector<TimerWheel::Timer> fired;
+    while (!reference.Empty()) {
+        // Mostly short steps, sometimes a long jump over many slots at once
+        const Tick step = rng() % 16 == 0 ? rng() % (LevelSpan(2) * 4) : rng() % 300;
+        if (!reference.Advance(step, fired)) {
+            std::cerr << "Seed " << seed << std::endl;
+            return false;
+        }
+
+        for (const TimerWheel::Timer& timer : fired) {
+            if (expiry[timer.entity] != timer.tick) {
+                continue; // Stale: re-armed or cancelled since
+            }
+            firings[timer.entity] += 1;
+            expiry[timer.entity] = 0;
+            // Some restart when they expire, like a looping countdown
+            if (rng() % 4 == 0) {
+                start(timer.entity);
+            }
+        }
+
+        // Re-arm or cancel a few running ones
+        for (int i = 0; i < 3 && timers > 0; ++i) {
+            const auto entity = static_cast<EntityID>(rng() % static_cast<uint64_t>(timers));
+            if (rng() % 3 == 0) {
+                expiry[entity] = 0;
+            } else if (expiry[entity] != 0) {
+                start(entity);
+            }
+        }
+
+        // A live expiry in the past means the wheel dropped or delayed it
+        for (const auto& [entity, tick] : expiry) {
+            if (tick != 0 && tick <= wheel.GetTick()) {
+                return Check(false, "entity " + std::to_string(entity) + " missed tick "
+                        + std::to_string(tick));
+            }
+        }
+    }
+
+    for (const auto& [entity, tick] : expiry) {
+        if (tick != 0) {
+            return Check(false, "entity " + std::to_string(entity) + " never fired");
+        }
+    }
+    return Check(!firings.empty(), "nothing fired");
+}
+
+// Only the clock is saved; Load() drops the timers
+bool SaveLoad()
+{
+    TimerWheel wheel;
+    wheel.Schedule(1, 500);
+    wheel.Advance(0.1234f);
+    wheel.SetSyncTick(77);
+
+    std::vector<uint8_t> bytes;
+    SnapshotWriter writer(bytes);
+    wheel.Save(writer);
+
+    TimerWheel restored;
+    restored.Schedule(2, 10);
+    SnapshotReader reader(bytes);
+    return Check(restored.Load(reader) && reader.AtEnd(), "Load() failed")
+        && Check(restored.GetTick() == wheel.GetTick() && restored.GetSyncTick() == 77
+                && restored.size() == 0,
+            "Load() must restore the clock and drop the timers");
+}
+
+}
+
+int main(int argc, char* argv[])
+{
+    int timers = 1000;
+    uint32_t seed = 1234;
+    for (int i = 1; i < argc; ++i) {
+        const std::string arg = argv[i];
+        const bool hasValue = i + 1 < argc;
+
+        if (arg == "--timers" && hasValue) {
+            timers = std::max(1, std::atoi(argv[++i]));
+        } else if (arg == "--seed" && hasValue) {
+            seed = static_cast<uint32_t>(std::strtoul(argv[++i], nullptr, 10));
+        } else {
+            std::cout << "Usage: " << argv[0] << " [--timers n] [--seed n]\n";
+            return 1;
+        }
+    }
+
+    if (!Conversions() || !Boundaries() || !RandomRun(timers, seed) || !SaveLoad()) {
+        return 1;
+    }
+    std::cout << "TimerWheel: boundaries and " << timers << " random timers fire on their ticks"
+              << std::endl;
+    return 0;
+}